@@ -98,6 +98,17 @@ namespace PL
 					  const CottonwoodMarker&	inNewMarker) = 0;
 
 		virtual void UpdateMarkers(const CottonwoodMarkerList& inMarkers) = 0;
+
+		/**
+		** Splits inMarkers into markers not held yet and markers that are, the latter returned in
+		** outUpdatedMarkers with their current state at the same index in outExistingMarkers.
+		** Walks the GUID-ordered marker set once for the whole list; the outputs keep the order of inMarkers.
+		*/
+		virtual void PartitionMarkers(
+						const CottonwoodMarkerList& inMarkers,
+						CottonwoodMarkerList& outNewMarkers,
+						CottonwoodMarkerList& outUpdatedMarkers,
+						CottonwoodMarkerList& outExistingMarkers) = 0;
 								  
 		/**
 		** Checks, if there is a marker, matching the given properties
@@ -139,6 +150,11 @@ namespace PL
 						const dvamediatypes::TickTime& inDuration = (dvamediatypes::kTime_Max - dvamediatypes::kTime_Min)) = 0;
 		
 		virtual BE::IMasterClipRef GetMediaMasterClip() const = 0;
+
+		/**
+		** Path of the media holding these markers, as used by MarkerGuidIndex
+		*/
+		virtual ASL::String GetMediaPath() const = 0;
 	};
 }
 
@@ -114,7 +114,10 @@
 
 #endif
 
-
+// std
+#include <deque>
+#include <list>
+#include <map>
 
 
 namespace PL
@@ -417,6 +420,9 @@ namespace PL
 		class TaskScheduler;
 		typedef boost::shared_ptr<TaskScheduler>		TaskSchedulerPtr;
 
+		struct TranscodePresetCache;
+		typedef boost::shared_ptr<TranscodePresetCache>	TranscodePresetCachePtr;
+
 		//--------------------------------------------------------------------------------------
 		// class ThreadProcess
 
@@ -504,6 +510,8 @@ namespace PL
 			virtual void Process();
 
 		private:
+			void NotifyCanceled();
+
 			UpdateMetadataTaskPtr	mTask;
 
 			//Members which used as temporary data when processing
@@ -516,6 +524,19 @@ namespace PL
 		};
 
 		typedef boost::shared_ptr<UpdateMetadataOperation> UpdateMetadataOperationPtr;
+		typedef std::map<ASL::Guid, UpdateMetadataOperationPtr> UpdateMetadataOperationMap;
+
+		/*
+		**	A started metadata update waiting for its follow-up task. Follow-up tasks are
+		**	created in start order, so an update finishing early waits for the ones before it.
+		*/
+		struct UpdateMetadataFollowUp
+		{
+			UpdateMetadataTaskPtr	mTask;
+			bool					mFinished;
+			ASL::Result				mResult;
+		};
+		typedef std::deque<UpdateMetadataFollowUp> UpdateMetadataFollowUpQueue;
 
 		//--------------------------------------------------------------------------------------
 		// class CopyOperation
@@ -678,6 +699,164 @@ namespace PL
 			BE::IProjectRef			mProject;
 		};
 
+		/**
+		**	The tasks of one kind in submission order, indexed by task ID and by batch ID. Tasks
+		**	waiting to start are also kept in a ready queue so that the scheduler only touches
+		**	startable tasks instead of walking the whole list for every event.
+		**	Tasks enter the ready queue when added in init state or resumed, and are dropped from
+		**	it lazily when they have left init state or the queue.
+		*/
+		template <typename TaskPtrT>
+		class IndexedTaskQueue
+		{
+		public:
+			typedef TaskPtrT								value_type;
+			typedef std::list<TaskPtrT>						TaskList;
+			typedef typename TaskList::iterator				iterator;
+			typedef typename TaskList::const_iterator		const_iterator;
+
+			iterator		begin()			{ return mTasks.begin(); }
+			iterator		end()			{ return mTasks.end(); }
+			const_iterator	begin() const	{ return mTasks.begin(); }
+			const_iterator	end() const		{ return mTasks.end(); }
+			bool			empty() const	{ return mTasks.empty(); }
+			std::size_t		size() const	{ return mTasks.size(); }
+
+			void clear()
+			{
+				mTasks.clear();
+				mTaskIndex.clear();
+				mBatchTaskCounts.clear();
+				mReadyTasks.clear();
+				mRunningTasks.clear();
+			}
+
+			bool Add(const TaskPtrT& inTask)
+			{
+				if (inTask == NULL || Find(inTask->GetTaskID()) == inTask)
+				{
+					return false;
+				}
+
+				Remove(inTask->GetTaskID());
+				IndexEntry entry = { mTasks.insert(mTasks.end(), inTask), inTask->GetBatchID() };
+				mTaskIndex[inTask->GetTaskID()] = entry;
+				++mBatchTaskCounts[entry.mBatchID];
+				if (inTask->GetTaskState() == kTaskState_Init)
+				{
+					mReadyTasks.push_back(inTask);
+				}
+				return true;
+			}
+
+			void Remove(const TaskBase* inTask)
+			{
+				if (inTask != NULL)
+				{
+					typename TaskIndex::iterator indexIter = mTaskIndex.find(inTask->GetTaskID());
+					if (indexIter != mTaskIndex.end() && indexIter->second.mTask->get() == inTask)
+					{
+						Erase(indexIter);
+					}
+				}
+			}
+
+			TaskPtrT Find(const ASL::Guid& inTaskID) const
+			{
+				typename TaskIndex::const_iterator indexIter = mTaskIndex.find(inTaskID);
+				return indexIter != mTaskIndex.end() ? *indexIter->second.mTask : TaskPtrT();
+			}
+
+			bool HasBatch(const ASL::Guid& inBatchID) const
+			{
+				return mBatchTaskCounts.find(inBatchID) != mBatchTaskCounts.end();
+			}
+
+			/**
+			**	Next task in init state, in submission order. The caller is expected to move it out
+			**	of init state; a task which is left in init state is not returned again until it is
+			**	passed to MarkReady.
+			*/
+			TaskPtrT PopReady()
+			{
+				while (!mReadyTasks.empty())
+				{
+					TaskPtrT task = mReadyTasks.front();
+					mReadyTasks.pop_front();
+					if (task->GetTaskState() == kTaskState_Init && Find(task->GetTaskID()) == task)
+					{
+						return task;
+					}
+				}
+				return TaskPtrT();
+			}
+
+			void MarkReady(const TaskPtrT& inTask)
+			{
+				mReadyTasks.push_back(inTask);
+			}
+
+			void MarkRunning(const TaskPtrT& inTask)
+			{
+				mRunningTasks.push_back(inTask);
+			}
+
+			bool HasRunningTask()
+			{
+				typename TaskList::iterator itr = mRunningTasks.begin();
+				while (itr != mRunningTasks.end())
+				{
+					if ((*itr)->GetTaskState() == kTaskState_Running && Find((*itr)->GetTaskID()) == *itr)
+					{
+						return true;
+					}
+					itr = mRunningTasks.erase(itr);
+				}
+				return false;
+			}
+
+		private:
+			struct IndexEntry
+			{
+				iterator			mTask;
+				ASL::Guid			mBatchID;
+			};
+			typedef std::map<ASL::Guid, IndexEntry>			TaskIndex;
+			typedef std::map<ASL::Guid, std::size_t>		BatchTaskCountMap;
+
+			void Remove(const ASL::Guid& inTaskID)
+			{
+				typename TaskIndex::iterator indexIter = mTaskIndex.find(inTaskID);
+				if (indexIter != mTaskIndex.end())
+				{
+					Erase(indexIter);
+				}
+			}
+
+			void Erase(typename TaskIndex::iterator inIndexIter)
+			{
+				typename BatchTaskCountMap::iterator countIter = mBatchTaskCounts.find(inIndexIter->second.mBatchID);
+				if (countIter != mBatchTaskCounts.end() && --countIter->second == 0)
+				{
+					mBatchTaskCounts.erase(countIter);
+				}
+				mTasks.erase(inIndexIter->second.mTask);
+				mTaskIndex.erase(inIndexIter);
+			}
+
+			TaskList						mTasks;
+			TaskIndex						mTaskIndex;
+			BatchTaskCountMap				mBatchTaskCounts;
+			std::deque<TaskPtrT>			mReadyTasks;
+			TaskList						mRunningTasks;
+		};
+
+		typedef IndexedTaskQueue<CopyTaskPtr>				CopyTaskQueue;
+		typedef IndexedTaskQueue<UpdateMetadataTaskPtr>		UpdateMetadataTaskQueue;
+		typedef IndexedTaskQueue<ImportTaskPtr>				ImportTaskQueue;
+		typedef IndexedTaskQueue<TranscodeTaskPtr>			TranscodeTaskQueue;
+		typedef IndexedTaskQueue<ConcatenateTaskPtr>		ConcatenateTaskQueue;
+
 		class TaskFactory
 		{
 		public:
@@ -812,6 +991,7 @@ namespace PL
 			void CreateSubsequentTaskAfterUpdateMetadata(
 				ASL::Result inResult,
 				UpdateMetadataTaskPtr inTask);
+			void CreateFinishedUpdateMetadataFollowUps();
 
 		protected:
 			TaskScheduler();
@@ -854,6 +1034,7 @@ namespace PL
 				const ASL::Guid& inTaskID, 
 				ASL::Result inResult, 
 				const ResultReportVector& inResults);
+			void				OnUpdateMetadataTaskCanceled(const ASL::Guid& inTaskID);
 
 			// Listen to import task status and progress
 			void				OnImportTaskFinished(const ASL::Guid& inTaskID);
@@ -922,20 +1103,25 @@ namespace PL
 			// Figure out copy action.
 			bool				GenerateCopyAction(CopyTaskPtr ioTask);
 
+			// Preset file for a transcode task, shared with earlier tasks of the same source format.
+			ASL::String			GetTranscodePresetFile(TranscodeTaskPtr inTask, ASL::String const& inSrcFile);
+
 			static TaskSchedulerPtr			GetInstance();
 
 			void FindAndRemoveTranscodeTempFile(const ASL::String& inPath);
 
 		private:
-			CopyTaskList					mCopyTaskQueue;
-			ImportTaskList					mImportTaskQueue;
-			TranscodeTaskList				mTranscodeTaskQueue;
-			ConcatenateTaskList				mConcatenateTaskQueue;
-			UpdateMetadataTaskList			mUpdateMetadataTaskQueue;
+			CopyTaskQueue					mCopyTaskQueue;
+			ImportTaskQueue					mImportTaskQueue;
+			TranscodeTaskQueue				mTranscodeTaskQueue;
+			ConcatenateTaskQueue			mConcatenateTaskQueue;
+			UpdateMetadataTaskQueue			mUpdateMetadataTaskQueue;
 
 			CopyOperationPtr				mCopyOperation;
 			BaseOperationPtr				mImportOperation;
-			UpdateMetadataOperationPtr		mUpdateMetadataOperation;
+			// In-flight metadata updates keyed by task ID, at most one per worker.
+			UpdateMetadataOperationMap		mUpdateMetadataOperations;
+			UpdateMetadataFollowUpQueue		mUpdateMetadataFollowUps;
 
 			ASL::StationID					mStationID;
 			SchedulerState					mSchedulerState;
@@ -976,6 +1162,8 @@ namespace PL
 
 			ASL::StringVector				mTranscodeTempFiles;
 
+			TranscodePresetCachePtr			mTranscodePresetCache;
+
 			friend class TaskFactory;
 		};
 	}
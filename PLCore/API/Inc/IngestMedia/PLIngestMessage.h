@@ -134,6 +134,10 @@ ASL_DECLARE_MESSAGE_WITH_3_PARAM(
 	ASL::Result,
 	ResultReportVector);
 
+ASL_DECLARE_MESSAGE_WITH_1_PARAM(   
+	UpdateMetadataCanceledMessage,
+	ASL::Guid);
+
 // Import related messages
 ASL_DECLARE_MESSAGE_WITH_1_PARAM(	
 	ImportFinishedMessage,
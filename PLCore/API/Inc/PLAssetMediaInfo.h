@@ -48,6 +48,10 @@
 #include "dvamediatypes/TickTime.h"
 #endif
 
+#ifndef ASLCRITICALSECTION_H
+#include "ASLCriticalSection.h"
+#endif
+
 // boost
 #ifndef BOOST_SHARED_PTR_HPP_INCLUDED
 #include "boost/shared_ptr.hpp"
@@ -77,6 +81,29 @@ namespace PL
 	};
 
 
+	/*
+	**	Structural fingerprint of one XMP revision. The stem hash covers the packet with its
+	**	volatile fields (xmpMM history, instance IDs, modify date) stripped, so two revisions
+	**	that only differ in bookkeeping compare equal.
+	*/
+	struct XMPFingerprint
+	{
+		XMPFingerprint()
+			:
+			mStemHash(0),
+			mStemLength(0),
+			mIsValid(false)
+		{
+		}
+
+		std::uint64_t			mStemHash;
+		std::size_t				mStemLength;
+		ASL::StdString			mTracksChangeID;
+		ASL::StdString			mMetadataChangeID;
+		bool					mIsValid;
+	};
+	typedef boost::shared_ptr<const XMPFingerprint> XMPFingerprintPtr;
+
 	class AssetMediaInfo;
 	typedef boost::shared_ptr<AssetMediaInfo> AssetMediaInfoPtr;
 	typedef std::map<ASL::String, AssetMediaInfoPtr> AssetMediaInfoMap;
@@ -154,6 +181,19 @@ namespace PL
 		PL_EXPORT
 		XMPText GetXMPString() const;
 
+		/*
+		**	Fingerprint of the current XMP buffer, shared with every other holder of that buffer.
+		*/
+		PL_EXPORT
+		XMPFingerprintPtr GetXMPFingerprint() const;
+
+		/*
+		**	Switch to inXMP. XMP buffers are never modified once shared, so holders of the previous
+		**	buffer keep that revision together with its fingerprint.
+		*/
+		PL_EXPORT
+		void RefreshXMPString(XMPText const& inXMP);
+
 		/*
 		**
 		*/
@@ -270,8 +310,9 @@ namespace PL
 		//	EA mode it is MediaLocator
 		ASL::String				mMediaPath;
 
-		//	XMP String Data
+		//	XMP String Data. Replaced by RefreshXMPString under mXMPCriticalSection.
 		XMPText					mXMP;
+		mutable ASL::CriticalSection	mXMPCriticalSection;
 
 		//	CustomMetadata String
 		ASL::String				mCustomMetadata;
@@ -50,6 +50,7 @@
 
 namespace PL
 {
+	class AssetMediaInfoWrapper;
 
 	class AssetSelectionManagerQuieter
 	{
@@ -135,6 +136,11 @@ namespace PL
 		*/
 		void UpdateSelectedMediaURLSet(MediaURLSet const& inMediaURLSet);
 
+		/*
+		**	Drop the cached wrapper of inMediaURL if the project no longer holds it, and pick up its current one
+		*/
+		void ValidateSelectedMediaWrapper(ASL::String const& inMediaURL);
+
 		/*
 		**
 		*/
@@ -162,8 +168,13 @@ namespace PL
 
 
 	private:
+		typedef std::map<ASL::String, boost::shared_ptr<AssetMediaInfoWrapper> > MediaInfoWrapperMap;
+
 		MediaURLSet							mSelectedMediaURLSet;
 
+		//	Wrappers of the selected media that have one, checked against the project before use
+		MediaInfoWrapperMap					mSelectedMediaWrappers;
+
 		//	AssetItem selected in library
 		PL::AssetItemList					mSelectedAssetItemList;
 
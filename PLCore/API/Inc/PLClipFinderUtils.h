@@ -45,6 +45,14 @@ namespace PL
 				ASL::String& outClipName,
 				ASL::String& outProviderID);
 
+	/*
+	**	Drop all logical clips cached by GetLogicalClipFromMediaPath. Cached entries are
+	**	validated against the clip's files on lookup, this only releases memory once a
+	**	batch of clips has been handled.
+	*/
+	PL_EXPORT
+	void ClearLogicalClipCache();
+
 	PL_EXPORT
 	void GetLogicalClipNameFromMediaPath(
 				ASL::String const& inMediaPath,
@@ -52,6 +52,17 @@ public:
 	PL_EXPORT
 	~CottonwoodCompositeMarker();
 
+	/**
+	**	Copies own their summary, the cached one is updated in place by AddMarkers.
+	*/
+	PL_EXPORT
+	CottonwoodCompositeMarker(
+	const CottonwoodCompositeMarker& inOther);
+
+	PL_EXPORT
+	CottonwoodCompositeMarker& operator=(
+	const CottonwoodCompositeMarker& inOther);
+
 	PL_EXPORT 
 	ASL::Guid GetGUID() const;
 
@@ -153,9 +164,41 @@ public:
 	PL_EXPORT
 	dvacore::UTF8String ToPropertyXML() const;
 
+	/**
+	**	Keep the composite in sync with the selection without rebuilding it.
+	**	Added markers are merged into the cached summary, removals rebuild it on the next query.
+	**	Markers already in the composite are skipped.
+	*/
+	PL_EXPORT
+	void AddMarkers(
+		const PL::MarkerSet& inAddedMarkers);
+
+	PL_EXPORT
+	void RemoveMarkers(
+		const PL::MarkerSet& inRemovedMarkers);
+
+	/**
+	**	Brings the composite to inMarkerSelection through AddMarkers and RemoveMarkers, for
+	**	callers that would otherwise construct a new composite on every selection change.
+	*/
+	PL_EXPORT
+	void SyncWithSelection(
+		const PL::MarkerSet& inMarkerSelection);
 
 private:
+	/**
+	**	Every field of the composite, computed in a single pass over mMarkerList the first
+	**	time any of them is asked for.
+	*/
+	struct CompositeSummary;
+	typedef boost::shared_ptr<CompositeSummary> CompositeSummaryPtr;
+
+	const CompositeSummary& GetSummary() const;
+	void InvalidateSummary();
+
 	PL::CottonwoodMarkerList	mMarkerList;
+	bool						mHasPlaceholderMarker;
+	mutable CompositeSummaryPtr	mSummary;
 };
 
 }
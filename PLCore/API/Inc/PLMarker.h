@@ -269,6 +269,12 @@ public:
 	
 	PL_EXPORT
 	dvacore::UTF16String GetType() const;
+
+	/**
+	**	Interned ID of GetType(), for lock-free lookups in the marker type registry snapshot
+	*/
+	PL_EXPORT
+	MarkerTypeID GetTypeID() const;
 	
 	PL_EXPORT
 	dvacore::UTF16String GetName() const;
@@ -376,6 +382,16 @@ public:
 	PL_EXPORT
 	bool TagsEqual(const CottonwoodMarker& inMarker) const;
 
+	PL_EXPORT
+	void SetTagParams(const TagParamMap& inTagParams);
+
+	/**
+	**	If the text fields, cue points and tags of both markers are equal, let this marker share
+	**	the body of inMarker and return true. Used to keep undo records from holding duplicate payloads.
+	*/
+	PL_EXPORT
+	bool ShareBodyIfEqual(const CottonwoodMarker& inMarker);
+
 	PL_EXPORT
 	const TagParamMap& GetTagParams() const;
 
@@ -398,20 +414,22 @@ public:
 	ASL::Color GetColor() const;
 
 private:
+	/**
+	**	Text fields, cue points and tags live in a shared body which is only cloned when a marker
+	**	that shares it is modified, so copying markers into tracks, lists and messages is cheap.
+	**	Type, target and speaker are interned since only a handful of distinct values exist per project.
+	*/
+	struct MarkerBody;
+	typedef boost::shared_ptr<MarkerBody> MarkerBodyPtr;
+
+	const MarkerBody& GetBody() const;
+	MarkerBody& GetMutableBody();
+	bool BodyEquals(const CottonwoodMarker& inMarker) const;
+
 	ASL::Guid						mGUID;
 	dvamediatypes::TickTime			mStartTime;
 	dvamediatypes::TickTime			mDuration;
-	dvacore::UTF16String			mType;
-	dvacore::UTF16String			mName;
-	dvacore::UTF16String			mComment;
-	dvacore::UTF16String			mLocation;
-	dvacore::UTF16String			mTarget;
-	dvacore::UTF16String			mCuePointType;
-    dvatemporalxmp::CustomMarkerParamList	mCuePointList;
-	dvacore::UTF16String			mSpeaker;
-	dvacore::UTF16String			mProbability;
-	TagParamMap						mTagParams;
-
+	MarkerBodyPtr					mBody;
 
     PL::SRMarkerOwnerWeakRef        mMarkerOwner;
 
@@ -43,6 +43,8 @@
 #include "ASLStationID.h"
 #endif
 
+#include "boost/shared_ptr.hpp"
+
 namespace PL
 {
 
@@ -58,6 +60,60 @@ struct MarkerTypeHandlerInfo
 typedef std::map<dvacore::UTF16String, MarkerTypeHandlerInfo> MarkerTypeRegistry;
 typedef std::vector<dvacore::UTF16String> MarkerTypeNameList;
 
+/**
+**	Every marker type string seen by the process is interned to a small integer ID which stays
+**	valid until shutdown, whether or not the type is currently registered. ID 0 is the empty type.
+*/
+typedef std::uint32_t MarkerTypeID;
+
+struct MarkerTypeEntry
+{
+	dvacore::UTF16String	mType;
+	dvacore::UTF16String	mDisplayName;
+	MarkerTypeHandlerInfo	mInfo;
+	bool					mRegistered;
+};
+
+/**
+**	Immutable copy of the registry. Writers publish a new snapshot under the registry lock, readers
+**	grab the current one without locking and index it by MarkerTypeID, so code handling many markers
+**	(e.g. drawing the marker bar) should fetch one snapshot and reuse it.
+*/
+class MarkerTypeSnapshot
+{
+public:
+	typedef std::vector<MarkerTypeEntry> Entries;
+	typedef std::map<dvacore::UTF16String, MarkerTypeID> TypeIDMap;
+
+	/**
+	**	Returns NULL if the ID is unknown to this snapshot
+	*/
+	const MarkerTypeEntry* GetEntry(MarkerTypeID inTypeID) const
+	{
+		return inTypeID < mEntries.size() ? &mEntries[inTypeID] : NULL;
+	}
+
+	/**
+	**	Returns false if the type has never been interned
+	*/
+	bool FindTypeID(const dvacore::UTF16String& inType, MarkerTypeID& outTypeID) const
+	{
+		TypeIDMap::const_iterator iter = mTypeIDs.find(inType);
+		if (iter == mTypeIDs.end())
+		{
+			return false;
+		}
+		outTypeID = iter->second;
+		return true;
+	}
+
+	Entries				mEntries;
+	TypeIDMap			mTypeIDs;
+	MarkerTypeNameList	mSortedTypes;
+};
+
+typedef boost::shared_ptr<const MarkerTypeSnapshot> MarkerTypeSnapshotPtr;
+
 namespace MarkerType
 {
 
@@ -145,6 +201,33 @@ void AddMarkerToRegistry(
 PL_EXPORT
 const MarkerTypeRegistry GetAllMarkerTypes();
 
+/**
+**	Check if a marker type is registered, without copying the registry
+*/
+PL_EXPORT
+bool IsRegisteredMarkerType(
+	const dvacore::UTF16String& inType);
+
+/**
+**	Get the current registry snapshot. Never NULL.
+*/
+PL_EXPORT
+MarkerTypeSnapshotPtr GetMarkerTypeSnapshot();
+
+/**
+**	Get the ID for a marker type, interning it if it was not seen before
+*/
+PL_EXPORT
+MarkerTypeID GetMarkerTypeID(
+	const dvacore::UTF16String& inType);
+
+/**
+**	Get the marker type string an ID was interned from. Empty for an unknown ID.
+*/
+PL_EXPORT
+dvacore::UTF16String GetMarkerTypeName(
+	MarkerTypeID inTypeID);
+
 /**
 **	Get all registered marker types
 */
@@ -158,6 +241,10 @@ PL_EXPORT
 ASL::Color GetColorForType(
 	const dvacore::UTF16String& inType);
 
+PL_EXPORT
+ASL::Color GetColorForType(
+	MarkerTypeID inTypeID);
+
 /**
 **	Set the color associated with a marker type. Returns true if this is a change.
 */
@@ -170,6 +257,10 @@ PL_EXPORT
 dvacore::UTF16String GetDisplayNameForType( 
 	const dvacore::UTF16String& inType);
 
+PL_EXPORT
+dvacore::UTF16String GetDisplayNameForType( 
+	MarkerTypeID inTypeID);
+
 } //namespace MarkerType
 
 } // namespace PL
@@ -338,6 +338,15 @@ namespace PL
 		PL_EXPORT
 		AssetMediaInfoWrapperPtr GetAssetMediaInfoWrapper(const ASL::String& inMediaPath) const;
 
+		/*
+		**	Looks up the wrappers of several media paths under one acquisition of the project lock.
+		**	Paths without a wrapper are left out of outWrappers.
+		*/
+		PL_EXPORT
+		void GetAssetMediaInfoWrappers(
+			const std::set<ASL::String>& inMediaPaths,
+			AssetMediaInfoWrapperMap& outWrappers) const;
+
 		/**
 		**
 		*/
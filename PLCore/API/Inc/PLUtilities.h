@@ -459,6 +459,27 @@ namespace PL
 		PL_EXPORT
 		bool IsXMPStemEqual(const XMPText& inNewXMPData, const XMPText& inOldXMPData);
 
+		/*
+		**	Compares against the fingerprint cached on inOldMediaInfo, so only inNewXMPData is parsed.
+		*/
+		PL_EXPORT
+		bool IsXMPStemEqual(const XMPText& inNewXMPData, const AssetMediaInfoPtr& inOldMediaInfo);
+
+		/*
+		**	Parse inXMPData once and hash its stem (variable fields removed) together with
+		**	the change IDs of the tracks and metadata parts. Returns an invalid fingerprint
+		**	if the XMP cannot be parsed.
+		*/
+		PL_EXPORT
+		XMPFingerprintPtr ComputeXMPFingerprint(const XMPText& inXMPData);
+
+		/*
+		**	ComputeXMPFingerprint, cached per XMP buffer. Buffers must not be modified once
+		**	they have been fingerprinted; replace them instead.
+		*/
+		PL_EXPORT
+		XMPFingerprintPtr GetXMPFingerprint(const XMPText& inXMPData);
+
 		/*
 		**
 		*/
@@ -762,6 +783,33 @@ namespace PL
 		PL_EXPORT
 		EncoderHost::IPresetRef CreateCustomPresetForMedia(const ASL::String& inMediaPath, ML::IExporterModuleRef inExportModule);
 
+		/*
+		**	The source format properties a custom preset is derived from. Media with equal
+		**	signatures get equal custom presets for the same exporter module.
+		*/
+		struct MediaFormatSignature
+		{
+			bool								mHasVideo;
+			bool								mHasAudio;
+			dvamediatypes::FrameRate			mVideoFrameRate;
+			ASL::Rect							mVideoFrameRect;
+			dvamediatypes::PixelAspectRatio		mVideoPixelAspectRatio;
+			dvamediatypes::FieldType			mVideoFieldType;
+			dvamediatypes::FrameRate			mAudioFrameRate;
+			MF::AudioChannelType				mAudioChannelType;
+
+			bool operator==(const MediaFormatSignature& inOther) const;
+		};
+
+		/*
+		**	Returns false if the media can't be opened as a sequence.
+		*/
+		PL_EXPORT
+		bool GetMediaFormatSignature(
+				const ASL::String& inMediaPath,
+				MediaFormatSignature& outSignature,
+				BE::ISequenceRef& outSequence);
+
 		/*
 		** 
 		*/
@@ -52,6 +52,13 @@ ASL_DECLARE_MESSAGE_WITH_2_PARAM(PresetListChangedMessage, ASL::UInt32, ASL::UIn
 */
 ASL_DECLARE_MESSAGE_WITH_2_PARAM(PresetListChangedMessage_ReplaceUserPreset, IPLPresetRef, IPLPresetRef);
 
+/**
+**	Sent when a background load of the user presets has completed.
+**	1. category of the preset manager that loaded them
+**	2. the user presets now served by GetUserPresetSnapshot
+*/
+ASL_DECLARE_MESSAGE_WITH_2_PARAM(UserPresetsLoadedMessage, PLPresetCategory, IPLPresets);
+
 }
 
 #endif
\ No newline at end of file
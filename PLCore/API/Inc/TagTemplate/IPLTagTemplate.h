@@ -184,6 +184,22 @@ IPLTagTemplateReadonlyRef CreateDefaultTagTemplate(const ASL::String& inName = A
 PL_EXPORT
 IPLTagTemplateReadonlyRef LoadTagTemplate(const ASL::String& inPath);
 
+/**
+**	Name, GUID and dimension of a tag template, read without building its tag cells.
+*/
+struct TagTemplateHeader
+{
+	TagTemplateHeader() : mRows(0), mColumns(0) {}
+
+	dvacore::utility::Guid	mGuid;
+	ASL::String				mName;
+	ASL::UInt32				mRows;
+	ASL::UInt32				mColumns;
+};
+
+PL_EXPORT
+bool LoadTagTemplateHeader(const ASL::String& inPath, TagTemplateHeader& outHeader);
+
 PL_EXPORT
 IPLTagTemplateReadonlyRef BuildTagTemplate(const ASL::String& inContent);
 
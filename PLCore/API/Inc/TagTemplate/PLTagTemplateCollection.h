@@ -157,7 +157,8 @@ public:
 	static TagTemplateCollection::SharedPtr GetInstance();
 
 	/*
-	**
+	**	Lists the template files without holding GetLocker() and publishes the lists in one step.
+	**	Template headers are then read on a background executor, cells only when a template is loaded.
 	*/
 	PL_EXPORT
 	void LoadTagTemplateList();
@@ -209,12 +210,12 @@ private:
 	/*
 	**
 	*/
-	void ImportSystemTagTemplates();
+	void ImportSystemTagTemplates(TagTemplateList& outTagTemplates);
 
 	/*
 	**
 	*/
-	void ImportUserTagTemplates();
+	void ImportUserTagTemplates(TagTemplateList& outTagTemplates);
 
 	static TagTemplateCollection::SharedPtr			sTagTemplateCollection;
 	static ASL::CriticalSection						sCriticalSection;
@@ -27,6 +27,10 @@
 #include "ASLClass.h"
 #include "ASLResult.h"
 #include "ASLListener.h"
+#include "ASLCriticalSection.h"
+
+// boost
+#include "boost/enable_shared_from_this.hpp"
 
 // DVA
 #include "dvacore/config/UnicodeTypes.h"
@@ -35,6 +39,10 @@
 #include "PLExport.h"
 #endif
 
+#ifndef IPLTAGTEMPLATE_H
+#include "TagTemplate/IPLTagTemplate.h"
+#endif
+
 
 namespace PL
 {
@@ -58,6 +66,8 @@ typedef boost::shared_ptr<TagTemplateInfo> TagTemplateInfoPtr;
 typedef std::vector<TagTemplateInfoPtr> TagTemplateList;
 
 class TagTemplateInfo
+	:
+	public boost::enable_shared_from_this<TagTemplateInfo>
 {
 
 public:
@@ -105,7 +115,9 @@ public:
 	void SetTagTemlatePath(const dvacore::UTF16String& inTagTemplatePath);
 
 	/*
-	**
+	**	Name, GUID and dimension never parse on the caller's thread. Until the header has been
+	**	read they return the file-name placeholder and queue a background load, which sends
+	**	TagTemplateChangedMessage once the header lands.
 	*/
 	PL_EXPORT
 	dvacore::UTF16String GetTagTemplateName() const;
@@ -114,8 +126,41 @@ public:
 	**
 	*/
 	PL_EXPORT
+	dvacore::utility::Guid GetTagTemplateGUID() const;
+
+	/*
+	**
+	*/
+	PL_EXPORT
+	ASL::UInt32 GetRows() const;
+
+	/*
+	**
+	*/
+	PL_EXPORT
+	ASL::UInt32 GetColumns() const;
+
+	/*
+	**	Re-reads name, GUID and dimension from the template file.
+	*/
+	PL_EXPORT
 	void OnTagTemplateNameChanged() const;
 
+	/*
+	**	Reads name, GUID and dimension from the template file unless that already happened.
+	**	The tag cells are not built, use LoadTagTemplate for the full template.
+	**	Parses on the calling thread, readers should use the getters above instead.
+	*/
+	PL_EXPORT
+	void EnsureHeaderLoaded() const;
+
+	/*
+	**	Reads the headers of inTagTemplates on the header loader thread and sends one
+	**	TagTemplateChangedMessage for those that changed.
+	*/
+	PL_EXPORT
+	static void LoadHeadersInBackground(const TagTemplateList& inTagTemplates);
+
 	/*
 	**
 	*/
@@ -139,10 +184,33 @@ public:
 		bool inReadOnly);
 
 private:
+	/*
+	**	Returns the header read so far, and queues a background load if there is none yet.
+	*/
+	TagTemplateHeader GetHeader() const;
+
+	/*
+	**	Returns true if the stored header changed.
+	*/
+	bool LoadHeaderIfNeeded() const;
+
+	/*
+	**	Parses outside of mHeaderCriticalSection, readers only wait for the result to be stored.
+	**	Returns true if the stored header changed.
+	*/
+	bool LoadHeader() const;
+
+	static void LoadHeaders(TagTemplateList inTagTemplates);
+
 	dvacore::UTF16String					mTagTemplateID;
 	dvacore::UTF16String					mTagTemplatePath;
-	mutable dvacore::UTF16String			mTagTemplateName;
 	bool									mIsReadOnly;
+
+	mutable ASL::CriticalSection			mHeaderCriticalSection;
+	mutable TagTemplateHeader				mHeader;
+	mutable bool							mHeaderLoaded;
+	mutable bool							mHeaderLoadPending;
+	mutable bool							mHeaderParsed;	// mHeader was read from the file, not a fallback
 };
 
 /**
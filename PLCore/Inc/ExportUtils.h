@@ -100,10 +100,36 @@ ASL::Result CopyWithProgress(
 	ASL::File::ASLCopyProgressFunc inProgressFunc,
 	void* inProgressData);
 
+/**
+** Resolution of the aggregate progress reported by ExecuteTransferJobs, independent of file count and size.
+**/
+const ASL::UInt64 kTransferProgressSteps = 1000;
+
+/**
+** Transfers one planned file. inWorkerIndex is the pool thread running the job (0 to worker count - 1);
+** ioProgressData adds bytes to the shared total and returns true when the job should stop.
+**/
+typedef boost::function<ASL::Result (size_t inWorkerIndex, size_t inJobIndex, ExportProgressData& ioProgressData)> TransferJobFunction;
+
+/**
+** Run one transfer per entry of inJobSizes on at most inWorkerCount threads. The calling thread polls
+** the byte count and forwards it to inUpdateProgressFn in kTransferProgressSteps steps; a true return
+** cancels the transfer. The first failing job stops the remaining ones and its index goes to outFailedJob.
+** Returns kSuccess, eUserCanceled, or the result of the failing job.
+**/
+ASL::Result ExecuteTransferJobs(
+	ASL::StdString const& inExecutorName,
+	size_t inWorkerCount,
+	std::vector<ASL::UInt64> const& inJobSizes,
+	TransferJobFunction const& inTransferJob,
+	boost::function<bool (ASL::UInt64)> const& inUpdateProgressFn,
+	size_t& outFailedJob);
+
 /**
 ** Replace media path in project file. It is used when export a media to a new destination.
+** Leaves the project file untouched and returns the failure if it cannot be read or rewritten.
 **/
-void ReplaceMeidaPath(const ASL::String &inProjectFilePath,
+ASL::Result ReplaceMeidaPath(const ASL::String &inProjectFilePath,
 	const ASL::String &inDestProjectDir,
 	const PathPairVector &inMediaPaths);
 
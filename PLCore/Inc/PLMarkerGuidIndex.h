@@ -0,0 +1,139 @@
+/*******************************************************************/
+/*                                                                 */
+/*                      ADOBE CONFIDENTIAL                         */
+/*                   _ _ _ _ _ _ _ _ _ _ _ _ _                     */
+/*                                                                 */
+/* Copyright 2014 Adobe Systems Incorporated                       */
+/* All Rights Reserved.                                            */
+/*                                                                 */
+/* NOTICE:  All information contained herein is, and remains the   */
+/* property of Adobe Systems Incorporated and its suppliers, if    */
+/* any.  The intellectual and technical concepts contained         */
+/* herein are proprietary to Adobe Systems Incorporated and its    */
+/* suppliers and may be covered by U.S. and Foreign Patents,       */
+/* patents in process, and are protected by trade secret or        */
+/* copyright law.  Dissemination of this information or            */
+/* reproduction of this material is strictly forbidden unless      */
+/* prior written permission is obtained from Adobe Systems         */
+/* Incorporated.                                                   */
+/*                                                                 */
+/*******************************************************************/
+
+#pragma once
+
+#ifndef PLMARKERGUIDINDEX_H
+#define PLMARKERGUIDINDEX_H
+
+#ifndef PLMARKER_H
+#include "PLMarker.h"
+#endif
+
+#ifndef ASLGUID_H
+#include "ASLGuid.h"
+#endif
+
+#ifndef ASLCRITICALSECTION_H
+#include "ASLCriticalSection.h"
+#endif
+
+#ifndef BOOST_SHARED_PTR_HPP_INCLUDED
+#include "boost/shared_ptr.hpp"
+#endif
+
+namespace PL
+{
+
+typedef std::set<ASL::String> MarkerMediaPathSet;
+
+/**
+**	Project-wide map from a marker GUID to the media holding it. SRMarkers and
+**	SRUnassociatedMarkers keep it in step with their MarkerSets, so asking which clips
+**	own a marker does not need to walk every clip's markers.
+**	Entries are keyed by the MarkerSet that registered them: several SRMarkers can hold the
+**	same media path at once, and one of them going away must not hide the others' markers.
+*/
+class MarkerGuidIndex
+{
+public:
+	typedef boost::shared_ptr<MarkerGuidIndex> SharedPtr;
+
+	static void Initialize();
+
+	static void Terminate();
+
+	/**
+	**	NULL outside Initialize/Terminate, e.g. when markers are destroyed during shutdown.
+	*/
+	static SharedPtr GetInstance();
+
+	void AddMarker(
+		const ASL::Guid& inMarkerID,
+		const MarkerSet& inOwnerMarkers,
+		const ASL::String& inMediaPath,
+		bool inIsUnassociated);
+
+	/**
+	**	Adds every marker in inMarkers for the given owner under a single lock.
+	*/
+	void AddMarkers(
+		const CottonwoodMarkerList& inMarkers,
+		const MarkerSet& inOwnerMarkers,
+		const ASL::String& inMediaPath,
+		bool inIsUnassociated);
+
+	void RemoveMarker(
+		const ASL::Guid& inMarkerID,
+		const MarkerSet& inOwnerMarkers);
+
+	/**
+	**	Drops every marker inOwnerMarkers registered, used when a MarkerSet is rebuilt or
+	**	destroyed.
+	*/
+	void RemoveMarkers(const MarkerSet& inOwnerMarkers);
+
+	bool HasMarker(const ASL::Guid& inMarkerID) const;
+
+	/**
+	**	Media paths of the clips whose associated markers include inMarkerID.
+	*/
+	void GetMediaPaths(
+		const ASL::Guid& inMarkerID,
+		MarkerMediaPathSet& outMediaPaths) const;
+
+private:
+	MarkerGuidIndex();
+
+	//	Owners are MarkerSets, only used as an identity and never dereferenced.
+	typedef const MarkerSet* MarkerSetID;
+
+	//	Kept once per owner rather than once per marker.
+	struct OwnerInfo
+	{
+		ASL::String			mMediaPath;
+		bool				mIsUnassociated;
+		std::size_t			mMarkerCount;
+	};
+	typedef std::map<MarkerSetID, OwnerInfo> OwnerInfos;
+	typedef std::vector<MarkerSetID> OwnerList;
+	typedef std::map<ASL::Guid, OwnerList> MarkerOwners;
+
+	void AddMarkerNoLock(
+		const ASL::Guid& inMarkerID,
+		const MarkerSet& inOwnerMarkers,
+		const ASL::String& inMediaPath,
+		bool inIsUnassociated);
+
+	void RemoveMarkerNoLock(
+		const ASL::Guid& inMarkerID,
+		const MarkerSet& inOwnerMarkers);
+
+	MarkerOwners					mOwners;
+	OwnerInfos						mOwnerInfos;
+	mutable ASL::CriticalSection	mCriticalSection;
+
+	static SharedPtr				sMarkerGuidIndex;
+};
+
+}
+
+#endif
@@ -124,7 +124,9 @@ namespace PL
         
     private:
         
-        ASLStringSet            mMarkerSelection;
+        typedef std::set<ASL::Guid> MarkerGuidSet;
+
+        MarkerGuidSet           mMarkerSelection;
         ASL::Guid				mMRUMarkerGUID;
         PL::ISRPrimaryClipPlaybackRef  mPrimaryClipPlayback;
     };
@@ -0,0 +1,105 @@
+/*******************************************************************/
+/*                                                                 */
+/*                      ADOBE CONFIDENTIAL                         */
+/*                   _ _ _ _ _ _ _ _ _ _ _ _ _                     */
+/*                                                                 */
+/* Copyright 2014 Adobe Systems Incorporated                       */
+/* All Rights Reserved.                                            */
+/*                                                                 */
+/* NOTICE:  All information contained herein is, and remains the   */
+/* property of Adobe Systems Incorporated and its suppliers, if    */
+/* any.  The intellectual and technical concepts contained         */
+/* herein are proprietary to Adobe Systems Incorporated and its    */
+/* suppliers and may be covered by U.S. and Foreign Patents,       */
+/* patents in process, and are protected by trade secret or        */
+/* copyright law.  Dissemination of this information or            */
+/* reproduction of this material is strictly forbidden unless      */
+/* prior written permission is obtained from Adobe Systems         */
+/* Incorporated.                                                   */
+/*                                                                 */
+/*******************************************************************/
+
+#pragma once
+
+#ifndef PLMARKERTEXTINDEX_H
+#define PLMARKERTEXTINDEX_H
+
+#ifndef PLMARKER_H
+#include "PLMarker.h"
+#endif
+
+#ifndef ASLGUID_H
+#include "ASLGuid.h"
+#endif
+
+namespace PL
+{
+
+typedef std::set<ASL::Guid> MarkerIDSet;
+
+/**
+**	Trigram index over the searchable text of a set of markers, used to narrow the marker
+**	filter text to a few candidates instead of scanning every marker's fields on each keystroke.
+**	Markers are referred to by compact slot numbers and no text is kept, so the caller confirms
+**	candidates against the markers themselves with IsMarkerFilteredByString.
+**	Callers are responsible for locking; the index is kept next to the MarkerSet it describes.
+*/
+class MarkerTextIndex
+{
+public:
+	MarkerTextIndex();
+
+	~MarkerTextIndex();
+
+	void Clear();
+
+	/**
+	**	Does nothing if the marker's GUID is already indexed, like inserting into a MarkerSet.
+	*/
+	void AddMarker(const CottonwoodMarker& inMarker);
+
+	/**
+	**	inMarker must be the marker as it was indexed, its text locates the postings to drop.
+	*/
+	void RemoveMarker(const CottonwoodMarker& inMarker);
+
+	void ReplaceMarker(
+		const CottonwoodMarker& inOldMarker,
+		const CottonwoodMarker& inNewMarker);
+
+	/**
+	**	Collects every marker that may match inFilterText. Filters shorter than a trigram
+	**	return every indexed marker.
+	*/
+	void FindCandidateMarkers(
+		const dvacore::UTF16String& inFilterText,
+		MarkerIDSet& outMarkerIDs) const;
+
+private:
+	typedef std::uint64_t Trigram;
+	typedef std::uint32_t MarkerSlot;
+
+	//	Sorted, so candidate lists can be intersected in one pass.
+	typedef std::vector<MarkerSlot> PostingList;
+	typedef std::map<Trigram, PostingList> TrigramPostings;
+	typedef std::map<MarkerTypeID, PostingList> MarkerTypeIndex;
+	typedef std::map<ASL::Guid, MarkerSlot> MarkerSlots;
+
+	void CollectTrigrams(
+		const CottonwoodMarker& inMarker,
+		std::vector<Trigram>& outTrigrams) const;
+
+	void CollectTrigrams(
+		const dvacore::UTF16String& inFoldedText,
+		std::vector<Trigram>& outTrigrams) const;
+
+	MarkerSlots				mSlots;
+	std::vector<ASL::Guid>	mSlotGUIDs;
+	std::vector<MarkerSlot>	mFreeSlots;
+	TrigramPostings			mPostings;
+	MarkerTypeIndex			mTypes;
+};
+
+}
+
+#endif
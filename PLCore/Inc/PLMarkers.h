@@ -58,6 +58,10 @@
 #include "ASLStrongWeakClass.h"
 #endif
 
+#ifndef PLMARKERTEXTINDEX_H
+#include "PLMarkerTextIndex.h"
+#endif
+
 namespace PL
 {
 
@@ -107,6 +111,12 @@ public:
 							  const CottonwoodMarker&	inNewMarker);
 
 	virtual void UpdateMarkers(const CottonwoodMarkerList& inMarkers);
+
+	virtual void PartitionMarkers(
+		const CottonwoodMarkerList& inMarkers,
+		CottonwoodMarkerList& outNewMarkers,
+		CottonwoodMarkerList& outUpdatedMarkers,
+		CottonwoodMarkerList& outExistingMarkers);
 	
 	/**
 	 ** Checks, if there is a marker, matching the given properties
@@ -151,18 +161,26 @@ public:
 	
 	virtual BE::IMasterClipRef GetMediaMasterClip() const;
 
+	virtual ASL::String GetMediaPath() const;
+
 private:
     void Init(ISRMediaRef inSRMedia);
 	void MarkerChanged(const ASL::String& inMediaLocatorID);
 	void SetDirty(bool inDirty);
 	void RefineMarker(CottonwoodMarker& ioMarker);
+	void RefineMarker(
+		CottonwoodMarker& ioMarker,
+		const dvamediatypes::FrameRate& inMediaFrameRate,
+		const dvamediatypes::TickTime& inMediaDuration);
 	dvamediatypes::FrameRate GetMediaFrameRate();
 	dvamediatypes::TickTime  GetMediaDuration();
 	ASL::Guid GetMediaInfoID();
 	dvacore::StdString GetMarkerState(XMPText inXMPString);
+	MarkerTrack GetMarkersMatchingText(const dvacore::UTF16String& inFilterText);
 	
 private:
 	MarkerSet               mMarkers;
+	MarkerTextIndex			mTextIndex;
 	ASL::CriticalSection	mMarkerCriticalSection;
 	TrackTypes				mTrackTypes;
 	ISRMediaRef				mSRMedia;
@@ -208,6 +208,11 @@ private:
 	**
 	*/
 	void TryCacheProjectItem() const;
+
+	/*
+	**	Drops media info changes still waiting to be broadcast, so that none outlive the project.
+	*/
+	static void DiscardPendingMediaInfoChanges();
 	
 private:
     static BE::IOrphanItemRef       sOrphanItems;
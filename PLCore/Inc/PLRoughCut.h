@@ -367,6 +367,46 @@ private:
 	*/
 	void OnUndoStackCleared();
 
+	/*
+	**	Any undoable action while the rough cut is in the timeline is treated as a sequence edit,
+	**	unless it takes the undo stack back to the last synced position.
+	*/
+	void OnUndoStackChanged();
+
+	/*
+	**	Record a structural edit of the sequence. Caller holds mCriticalSection.
+	*/
+	void BumpEditVersion();
+
+	/*
+	**	Record an edit that undoing back to the synced position does not revert on its own.
+	**	Caller holds mCriticalSection.
+	*/
+	void RecordSequenceEdit();
+
+	/*
+	**	The undo stack moved: back at the synced position the sequence matches again, anywhere
+	**	else it is an edit. Caller holds mCriticalSection.
+	*/
+	void UpdateUndoPosition();
+
+	/*
+	**	mClipItems and the transitions match the sequence. Caller holds mCriticalSection.
+	*/
+	void MarkSynced();
+
+	/*
+	**	Remember the undo position once both clip items and transitions are synced.
+	**	Caller holds mCriticalSection.
+	*/
+	void NoteSyncPoint();
+
+	/*
+	**	Full comparison of the sequence against mClipItems and mAssetItem's transitions.
+	**	Only used to verify the edit versions in debug builds.
+	*/
+	bool DiffRoughCutWithSequence();
+
 	/*
 	**
 	*/
@@ -402,6 +442,18 @@ private:
 	// if user has choose Cancel at first time save failure dialog pop up, we will not pop up it again until close or exit.
 	bool							mUserHasCanceledSaveFailure;
 
+	// Monotonic edit versions of the sequence's clip items and transitions, and the versions at
+	// which mClipItems and mAssetItem's transitions were last known to match the sequence.
+	ASL::UInt64					mClipItemsVersion;
+	ASL::UInt64					mClipItemsSyncedVersion;
+	ASL::UInt64					mTransitionsVersion;
+	ASL::UInt64					mTransitionsSyncedVersion;
+
+	// Undo count when the versions were last synced, and whether undo can still get back there:
+	// going below it and coming back up may have been new actions rather than redo.
+	ASL::UInt32					mSyncedUndoableActionCount;
+	bool						mSyncedUndoPositionReachable;
+
 	ASL::CriticalSection		mCriticalSection;
 	
 	friend class SilkRoadPrivateCreator;
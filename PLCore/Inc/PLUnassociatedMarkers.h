@@ -62,6 +62,10 @@
 #include "ASLStrongWeakClass.h"
 #endif
 
+#ifndef PLMARKERTEXTINDEX_H
+#include "PLMarkerTextIndex.h"
+#endif
+
 namespace PL
 {
     ASL_DEFINE_CLASSREF(SRUnassociatedMarkers, ISRUnassociatedMarkers);
@@ -133,8 +137,10 @@ namespace PL
     private:
         
         void Init(ASL::String const& inFilePath);
+        MarkerTrack GetMarkersMatchingText(const dvacore::UTF16String& inFilterText);
     private:
         MarkerSet               mMarkers;
+        MarkerTextIndex         mTextIndex;
         ASL::String				mFilePath;
         ASL::CriticalSection	mMarkerCriticalSection;
         TrackTypes				mTrackTypes;
@@ -44,6 +44,11 @@ public:
 	*/
 	virtual IPLPresets GetUserPresets(bool inUseCache = false) = 0;
 
+	/**
+	**	Starts loading the user presets in the background.
+	*/
+	virtual void RequestUserPresets() = 0;
+
 	/**
 	**	Return false if you do not want to list a user preset.
 	**	@param inPresetRef		The preset in question
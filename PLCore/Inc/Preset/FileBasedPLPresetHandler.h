@@ -51,6 +51,12 @@ const ASL::StationID kFileBasePLPresetHandlerWorkerStation (ASL_STATIONID("MZ.St
 */
 ASL_DECLARE_MESSAGE_WITH_1_PARAM(PresetListCached, dvacore::UTF16String);
 
+/**
+**	Sent while a folder is scanned in the background, with a batch of presets read from it.
+**	PresetListCached follows once the whole folder has been delivered.
+*/
+ASL_DECLARE_MESSAGE_WITH_2_PARAM(PresetsLoaded, dvacore::UTF16String, IPLPresets);
+
 /*
 ** Sent when a preset has been added/deleted/modifed
 */
@@ -90,6 +96,11 @@ public:
 	*/
 	virtual IPLPresets GetUserPresets(bool inUseCache = false);
 
+	/**
+	**	Starts a background scan of the user preset folder, see GetPresetsAsync.
+	*/
+	virtual void RequestUserPresets();
+
 	
 	//virtual PresetProxyList GetUserProxyPresets();
 
@@ -210,6 +221,29 @@ public:
 		bool inRecurseSubfolders,
 		bool inUseCache = false);
 
+	/**
+	**	Scans inPresetFolder on the preset scan executor. Cached presets are posted at once,
+	**	the remaining files are parsed in parallel and posted as they complete. Everything is
+	**	delivered as PresetsLoaded on the handler station, followed by PresetListCached.
+	**	Must be called from the main thread.
+	*/
+	static void GetPresetsAsync(
+		const dvacore::UTF16String& inPresetFolder,
+		PLPresetCategory inCategory,
+		PLPresetType inPresetType);
+
+	/**
+	**	Waits for pending background scans and releases the scan executor.
+	*/
+	static void StopPresetScans();
+
+	/**
+	**	Reads a preset file without reporting errors to the user, safe to call off the main thread.
+	*/
+	static IPLPresetRef ParsePresetFile(
+		const dvacore::UTF16String& inPresetFile,
+		PLPresetCategory inCategory);
+
 	/**
 	**
 	*/
@@ -30,6 +30,7 @@
 #include "ASLTypes.h"
 #include "ASLFile.h"
 #include "ASLCriticalSection.h"
+#include "ASLListener.h"
 
 // DVA
 #include "dvacore/filesupport/file/File.h"
@@ -54,8 +55,12 @@ struct PLPresetRecord
 };
 
 class PLPresetCache
+	:
+	public ASL::Listener
 {
 public:
+	ASL_MESSAGE_MAP_DECLARE();
+
 	static PLPresetCache& Get();
 
 	static void Initialize();
@@ -81,6 +86,13 @@ private:
 	PLPresetCache();
 	~PLPresetCache();
 
+	/**
+	**	A background scan finished a folder, write the snapshot so the next start can use it.
+	*/
+	void OnPresetListCached(const dvacore::UTF16String& inPresetFolder);
+
+	void WriteSnapshot();
+
 	std::vector<dvacore::filesupport::File>		GetAllFilesInDir(
 		dvacore::filesupport::Dir inDir,
 		bool inRecursive);
@@ -31,6 +31,7 @@
 // Local
 #include "Preset/IPLPresetManager.h"
 #include "Preset/AbstractPLPresetHandler.h"
+#include "Preset/FileBasedPLPresetHandler.h"
 
 namespace PL
 {
@@ -42,12 +43,15 @@ ASL_DEFINE_CLASSREF(PLPresetManager, IPLPresetManager);
 
 class PLPresetManager
 	:
-	public IPLPresetManager
+	public IPLPresetManager,
+	public ASL::Listener
 {
 	ASL_BASIC_CLASS_SUPPORT(PLPresetManager);
 	ASL_QUERY_MAP_BEGIN
 		ASL_QUERY_ENTRY(IPLPresetManager);
 	ASL_QUERY_MAP_END
+
+	ASL_MESSAGE_MAP_DECLARE();
 public:
 	/**
 	**
@@ -101,6 +105,19 @@ public:
 	*/
 	IPLPresets GetUserPresets(bool inUseCache = false);
 
+	/**
+	**	Starts loading the user presets in the background. Results are posted as PresetsLoaded
+	**	messages, see FileBasedPLPresetHandler.
+	*/
+	void RequestUserPresets();
+
+	/**
+	**	Returns the user presets from the last completed background load without touching the
+	**	disk, and starts a load if none has run yet. UserPresetsLoadedMessage is broadcast
+	**	when a load completes.
+	*/
+	IPLPresets GetUserPresetSnapshot();
+
 	/**
 	**
 	*/
@@ -182,6 +199,24 @@ public:
 protected:
 
 protected:
+	/**
+	**	Collects a batch of a background user preset scan.
+	*/
+	void OnPresetsLoaded(
+		const dvacore::UTF16String& inPresetFolder,
+		const IPLPresets& inPresets);
+
+	/**
+	**	Publishes the collected presets once the scan of the user folder is complete.
+	*/
+	void OnPresetListCached(
+		const dvacore::UTF16String& inPresetFolder);
+
+	/**
+	**	Reloads the snapshot in the background after the user presets changed, if it is in use.
+	*/
+	void ReloadUserPresetSnapshot();
+
 	std::auto_ptr<AbstractPLPresetHandler>	mPresetHandler;
 
 	typedef std::vector<dvacore::UTF16String>	SystemPresetFoldersPathVector;
@@ -191,6 +226,13 @@ protected:
 	ASL::CriticalSection					m_rg;	//use resource guard to make class methods thread-safe
 
 	PLPresetCategory						mPresetCategory;
+
+	//	User presets of the last completed background load, and the one in progress
+	IPLPresets								mUserPresetSnapshot;
+	IPLPresets								mLoadingUserPresets;
+	bool									mUserPresetSnapshotLoaded;
+	bool									mUserPresetLoadPending;
+	bool									mUserPresetReloadRequested;
 };
 
 }
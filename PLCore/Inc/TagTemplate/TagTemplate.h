@@ -156,6 +156,8 @@ public:
 	static
 	PL::IPLTagTemplateWritableRef FromFile(const dvacore::UTF16String& inPath, FileType inType = kFileType_JSON);
 	static
+	bool HeaderFromFile(const dvacore::UTF16String& inPath, TagTemplateHeader& outHeader, FileType inType = kFileType_JSON);
+	static
 	PL::IPLTagTemplateWritableRef FromContent(const dvacore::UTF16String& inContent, FileType inType = kFileType_JSON);
 
 	bool ToFile(const dvacore::UTF16String& inPath, FileType inType = kFileType_JSON);
@@ -170,6 +172,9 @@ private:
 	static
 	PL::IPLTagTemplateWritableRef FromPTree(const boost::property_tree::wptree& inPTree);
 
+	static
+	bool HeaderFromPTree(const boost::property_tree::wptree& inPTree, TagTemplateHeader& outHeader);
+
 	void ToPTree(boost::property_tree::wptree& outPTree);
 
 private:
@@ -24,6 +24,9 @@
 //	Self
 #include "PLAssetMediaInfo.h"
 
+//	PL
+#include "PLUtilities.h"
+
 //	ASL
 #include "ASLStringCompare.h"
 
@@ -205,9 +208,28 @@ ASL::String AssetMediaInfo::GetMediaPath() const
 */
 XMPText AssetMediaInfo::GetXMPString() const
 {
+	ASL::CriticalSectionLock lock(mXMPCriticalSection);
 	return mXMP;
 }
 
+/*
+**
+*/
+XMPFingerprintPtr AssetMediaInfo::GetXMPFingerprint() const
+{
+	return Utilities::GetXMPFingerprint(GetXMPString());
+}
+
+/*
+**
+*/
+void AssetMediaInfo::RefreshXMPString(XMPText const& inXMP)
+{
+	ASL_ASSERT(inXMP != NULL);
+	ASL::CriticalSectionLock lock(mXMPCriticalSection);
+	mXMP = inXMP;
+}
+
 /*
 **
 */
@@ -130,6 +130,7 @@ namespace PL
 				{
 					if (inAssetMediaInfoID == assetItem->GetAssetMediaInfoGUID().AsString())
 					{
+						ValidateSelectedMediaWrapper(assetItem->GetMediaPath());
 						CalcMediaLocatorAndUpdateInPanel(mSelectedMediaURLSet);
 						break;
 					}
@@ -139,6 +140,7 @@ namespace PL
 			{
 				if (mSelectedMediaURLSet.find(inAssetMediaInfoID) != mSelectedMediaURLSet.end())
 				{
+					ValidateSelectedMediaWrapper(inAssetMediaInfoID);
 					CalcMediaLocatorAndUpdateInPanel(mSelectedMediaURLSet);
 				}
 			}
@@ -188,6 +190,7 @@ namespace PL
 		ASL::CriticalSectionLock lock(mCriticalSection); //serialize concurrent threads
 
 		mSelectedMediaURLSet.clear();
+		mSelectedMediaWrappers.clear();
 		mSelectedAssetItemList.clear();
 	}
 
@@ -320,38 +323,72 @@ namespace PL
 		MediaURLSet toRemove;
 		set_difference(mSelectedMediaURLSet.begin(), mSelectedMediaURLSet.end(), inMediaURLSet.begin(), inMediaURLSet.end(),
 			std::inserter(toRemove, toRemove.begin()));
-
 		MediaURLSet toAdd;
 		set_difference(inMediaURLSet.begin(), inMediaURLSet.end(), mSelectedMediaURLSet.begin(), mSelectedMediaURLSet.end(),
 			std::inserter(toAdd, toAdd.begin()));
 
-		MediaURLSet::const_iterator iter = toRemove.begin();
-		MediaURLSet::const_iterator end = toRemove.end();
-		for (; iter != end; ++iter)
+		//	Media leaving the selection use the wrapper cached when they were selected,
+		//	which is the station the listener was actually added to.
+		BOOST_FOREACH(ASL::String const& mediaURL, toRemove)
 		{
-			if (SRProject::GetInstance()->GetAssetMediaInfoWrapper(*iter))
+			MediaInfoWrapperMap::iterator wrapperIter = mSelectedMediaWrappers.find(mediaURL);
+			if (wrapperIter != mSelectedMediaWrappers.end())
 			{
-				ASL::StationUtils::RemoveListener(
-					SRProject::GetInstance()->GetAssetMediaInfoWrapper(*iter)->GetStationID(),
-					this);
+				ASL::StationUtils::RemoveListener(wrapperIter->second->GetStationID(), this);
+				mSelectedMediaWrappers.erase(wrapperIter);
 			}
 		}
 
 		mSelectedMediaURLSet = inMediaURLSet;
 
-		iter = toAdd.begin();
-		end = toAdd.end();
+		//	Media staying in the selection keep their wrappers; only the new ones are looked up,
+		//	all under one acquisition of the project lock.
+		MediaInfoWrapperMap addedWrappers;
+		SRProject::SharedPtr project = SRProject::GetInstance();
+		if (project && !toAdd.empty())
+		{
+			project->GetAssetMediaInfoWrappers(toAdd, addedWrappers);
+		}
 
-		for (; iter != end; ++iter)
+		BOOST_FOREACH(MediaInfoWrapperMap::value_type const& wrapperPair, addedWrappers)
 		{
-			if (SRProject::GetInstance()->GetAssetMediaInfoWrapper(*iter))
+			if (mSelectedMediaWrappers.insert(wrapperPair).second)
 			{
-				ASL::StationUtils::AddListener(
-					SRProject::GetInstance()->GetAssetMediaInfoWrapper(*iter)->GetStationID(),
-					this);
+				ASL::StationUtils::AddListener(wrapperPair.second->GetStationID(), this);
 			}
 		}
+	}
 
+	/*
+	**	SRProject may unregister or replace the wrapper of a selected media, e.g. when it
+	**	drops unreferenced media infos or restores its backup. Re-read the wrapper of inMediaURL
+	**	and move the listener to the current one.
+	*/
+	void SRAssetSelectionManager::ValidateSelectedMediaWrapper(ASL::String const& inMediaURL)
+	{
+		AssetMediaInfoWrapperPtr currentWrapper;
+		SRProject::SharedPtr project = SRProject::GetInstance();
+		if (project && mSelectedMediaURLSet.find(inMediaURL) != mSelectedMediaURLSet.end())
+		{
+			currentWrapper = project->GetAssetMediaInfoWrapper(inMediaURL);
+		}
+
+		MediaInfoWrapperMap::iterator cachedIter = mSelectedMediaWrappers.find(inMediaURL);
+		if (cachedIter != mSelectedMediaWrappers.end())
+		{
+			if (cachedIter->second == currentWrapper)
+			{
+				return;
+			}
+			ASL::StationUtils::RemoveListener(cachedIter->second->GetStationID(), this);
+			mSelectedMediaWrappers.erase(cachedIter);
+		}
+
+		if (currentWrapper)
+		{
+			mSelectedMediaWrappers[inMediaURL] = currentWrapper;
+			ASL::StationUtils::AddListener(currentWrapper->GetStationID(), this);
+		}
 	}
 
 	/*
@@ -377,7 +414,10 @@ namespace PL
 		BOOST_FOREACH(ASL::String const& mediaURL, inMediaURLSet)
 		{
 			ASL::String mediaLocator;
-			PL::AssetMediaInfoPtr assetMediaInfo = SRProject::GetInstance()->GetAssetMediaInfo(mediaURL);
+			MediaInfoWrapperMap::const_iterator wrapperIter = mSelectedMediaWrappers.find(mediaURL);
+			PL::AssetMediaInfoPtr assetMediaInfo = (wrapperIter != mSelectedMediaWrappers.end())
+				? wrapperIter->second->GetAssetMediaInfo()
+				: SRProject::GetInstance()->GetAssetMediaInfo(mediaURL);
 
 			if (MZ::Utilities::IsEAMediaPath(mediaURL))
 			{
@@ -27,9 +27,16 @@
 
 // ASL
 #include "ASLPathUtils.h"
+#include "ASLFile.h"
+#include "ASLCriticalSection.h"
 
 // boost
 #include "boost/foreach.hpp"
+#include "boost/shared_ptr.hpp"
+
+// std
+#include <list>
+#include <map>
 
 namespace PL
 {
@@ -144,6 +151,158 @@ namespace PL
 			return sourceStem;
 		}
 
+		/*
+		**	At most this many media paths are cached; the least recently used one is dropped first.
+		*/
+		const std::size_t kMaxCachedLogicalClips = 10000;
+
+		typedef std::map<ASL::String, ASL::FileTime> FileTimeMap;
+
+		/*
+		**	What GetLogicalClipFromMediaPath resolved for one media path. The file list and the
+		**	fallback name depend on the path asked for, so every path keeps its own result.
+		**	It stays valid while none of the clip's files has been modified, moved or deleted.
+		*/
+		struct LogicalClipRecord
+		{
+			ASL::String			mSourceStem;
+			ASL::PathnameList	mFileList;
+			ASL::String			mClipName;
+			ASL::String			mProviderID;
+			FileTimeMap			mFileModificationTimes;
+		};
+
+		typedef boost::shared_ptr<LogicalClipRecord const> LogicalClipRecordPtr;
+
+		// Media paths, most recently used first.
+		typedef std::list<ASL::String> LogicalClipUseList;
+
+		struct CachedLogicalClip
+		{
+			LogicalClipRecordPtr			mClip;
+			LogicalClipUseList::iterator	mUse;
+		};
+
+		typedef std::map<ASL::String, CachedLogicalClip> LogicalClipMap;
+
+		ASL::CriticalSection	sLogicalClipCacheCriticalSection;
+		LogicalClipMap			sLogicalClipCache;
+		LogicalClipUseList		sLogicalClipUseOrder;
+
+		/*
+		**
+		*/
+		bool GetModificationTime(
+			ASL::String const& inPath,
+			ASL::FileTime& outModificationTime)
+		{
+			outModificationTime = 0;
+			return !inPath.empty() && ASL::ResultSucceeded(ASL::File::GetLastModificationTime(inPath, outModificationTime));
+		}
+
+		/*
+		**	Returns true and fills the outputs if inMediaPath was resolved before and none of
+		**	the clip's files has changed since.
+		*/
+		bool FindCachedLogicalClip(
+			ASL::String const& inMediaPath,
+			ASL::String& outSourceStem,
+			ASL::PathnameList& outFileList,
+			ASL::String& outClipName,
+			ASL::String& outProviderID)
+		{
+			LogicalClipRecordPtr clip;
+			{
+				ASL::CriticalSectionLock lock(sLogicalClipCacheCriticalSection);
+				LogicalClipMap::iterator clipIter = sLogicalClipCache.find(inMediaPath);
+				if (clipIter == sLogicalClipCache.end())
+				{
+					return false;
+				}
+				clip = clipIter->second.mClip;
+				sLogicalClipUseOrder.splice(sLogicalClipUseOrder.begin(), sLogicalClipUseOrder, clipIter->second.mUse);
+			}
+
+			// Stat outside the lock, file system calls can be slow on network volumes.
+			bool isValid = true;
+			BOOST_FOREACH(FileTimeMap::value_type const& file, clip->mFileModificationTimes)
+			{
+				ASL::FileTime fileTime = 0;
+				if (!GetModificationTime(file.first, fileTime) || fileTime != file.second)
+				{
+					isValid = false;
+					break;
+				}
+			}
+
+			if (!isValid)
+			{
+				ASL::CriticalSectionLock lock(sLogicalClipCacheCriticalSection);
+				LogicalClipMap::iterator clipIter = sLogicalClipCache.find(inMediaPath);
+				if (clipIter != sLogicalClipCache.end() && clipIter->second.mClip == clip)
+				{
+					sLogicalClipUseOrder.erase(clipIter->second.mUse);
+					sLogicalClipCache.erase(clipIter);
+				}
+				return false;
+			}
+
+			outSourceStem = clip->mSourceStem;
+			outFileList.insert(outFileList.end(), clip->mFileList.begin(), clip->mFileList.end());
+			outClipName = clip->mClipName;
+			outProviderID = clip->mProviderID;
+			return true;
+		}
+
+		/*
+		**	Cache what was resolved for inMediaPath, evicting the least recently used path when full.
+		*/
+		void CacheLogicalClip(
+			ASL::String const& inMediaPath,
+			ASL::String const& inSourceStem,
+			ASL::PathnameList const& inFileList,
+			ASL::String const& inClipName,
+			ASL::String const& inProviderID)
+		{
+			boost::shared_ptr<LogicalClipRecord> clip(new LogicalClipRecord());
+			clip->mSourceStem = inSourceStem;
+			clip->mFileList = inFileList;
+			clip->mClipName = inClipName;
+			clip->mProviderID = inProviderID;
+
+			ASL::PathnameList clipFiles(inFileList);
+			clipFiles.push_back(inMediaPath);
+			BOOST_FOREACH(ASL::String const& filePath, clipFiles)
+			{
+				ASL::FileTime fileTime = 0;
+				if (!GetModificationTime(filePath, fileTime))
+				{
+					return;
+				}
+				clip->mFileModificationTimes[filePath] = fileTime;
+			}
+
+			ASL::CriticalSectionLock lock(sLogicalClipCacheCriticalSection);
+			LogicalClipMap::iterator clipIter = sLogicalClipCache.find(inMediaPath);
+			if (clipIter != sLogicalClipCache.end())
+			{
+				clipIter->second.mClip = clip;
+				sLogicalClipUseOrder.splice(sLogicalClipUseOrder.begin(), sLogicalClipUseOrder, clipIter->second.mUse);
+				return;
+			}
+
+			if (sLogicalClipCache.size() >= kMaxCachedLogicalClips)
+			{
+				sLogicalClipCache.erase(sLogicalClipUseOrder.back());
+				sLogicalClipUseOrder.pop_back();
+			}
+
+			sLogicalClipUseOrder.push_front(inMediaPath);
+			CachedLogicalClip& cachedClip = sLogicalClipCache[inMediaPath];
+			cachedClip.mClip = clip;
+			cachedClip.mUse = sLogicalClipUseOrder.begin();
+		}
+
 	}//	End namespace
 
 /*
@@ -178,8 +337,14 @@ void GetLogicalClipFromMediaPath(
 				ASL::String& outClipName,
 				ASL::String& outProviderID)
 {
+	if (FindCachedLogicalClip(inMediaPath, outSourceStem, outFileList, outClipName, outProviderID))
+	{
+		return;
+	}
+
 	ASL::String mediakey;
 	ASL::String folderPath;
+	ASL::PathnameList::size_type const firstNewFile = outFileList.size();
 
 	PLMBC::Provider::Value_t value = PLMBC::GetRelatedFiles(
 												inMediaPath,
@@ -231,6 +396,26 @@ void GetLogicalClipFromMediaPath(
 	{
 		outSourceStem = GetSourceStem(folderPath);
 	}
+
+	if (!outProviderID.empty())
+	{
+		CacheLogicalClip(
+			inMediaPath,
+			outSourceStem,
+			ASL::PathnameList(outFileList.begin() + firstNewFile, outFileList.end()),
+			outClipName,
+			outProviderID);
+	}
+}
+
+/*
+**
+*/
+void ClearLogicalClipCache()
+{
+	ASL::CriticalSectionLock lock(sLogicalClipCacheCriticalSection);
+	sLogicalClipCache.clear();
+	sLogicalClipUseOrder.clear();
 }
 
 /*
@@ -61,8 +61,10 @@ namespace
 
 	const ASL::String CSV_FILE_EXT = ASL_STR(".csv");
 	const ASL::String EMPTY_MARKER_STR = ASL_STR("\t\t\t\t\t\t\t");
+	const ASL::String CSV_LINE_BREAK = ASL_STR("\r\n");
 
-	typedef std::vector<ASL::String> MarkerRows;
+	// Characters buffered before the CSV output is written to disk.
+	const size_t kCSVWriteBufferSize = 128 * 1024;
 
 
 	ASL::String EscapeSpecialChar(const ASL::String& inString)
@@ -190,106 +192,166 @@ namespace
 		return validFullPath;
 	}
 
-	bool WriteCSVFile(const std::vector<ASL::String>& inMarkersLineVec, 
-							 const ASL::String& inFilePath,
-							 const ASL::String& inFileExtension)
+	/*
+	** Format every row of one asset, in marker order, each followed by a line break.
+	*/
+	void FormatAssetRows(
+		const ExportMarker::AssetItemMarkersInfoPair& inItem,
+		ASL::String* outRows)
 	{
-		typedef dvacore::oUTF16StringStream OutputStringStream;
-
-		OutputStringStream outputStream;
+		const ASL::String assetName = EscapeSpecialChar(inItem.first->name) + tabDelimiter;
+		const ASL::String assetParentBinPath = EscapeSpecialChar(inItem.first->parentBinPath) + tabDelimiter;
+		const ASL::String assetFilePath = EscapeSpecialChar(inItem.first->mediaPath);
 
-		BOOST_FOREACH(const ASL::String& item, inMarkersLineVec)
+		// have markers in an asset
+		if (inItem.second.size() != 0)
 		{
-			outputStream << item << ASL_STR("\r\n");
+			BOOST_FOREACH(const CottonwoodMarker& marker, inItem.second)
+			{
+				*outRows += assetName;
+				*outRows += assetParentBinPath;
+				*outRows += BuildMarkerRow(
+					marker, 
+					inItem.first->frameRate, 
+					inItem.first->mediaOffset, 
+					inItem.first->isDropFrame);
+				*outRows += assetFilePath;
+				*outRows += CSV_LINE_BREAK;
+			}
 		}
+		else
+		{
+			*outRows += assetName + assetParentBinPath + EMPTY_MARKER_STR + assetFilePath;
+			*outRows += CSV_LINE_BREAK;
+		}
+	}
 
-		ASL::Result result;
-		ASL::File outputFile;
+	/*
+	** Buffered writer for the UTF-16 CSV file. Rows are appended as they are built and go to
+	** disk in large blocks, so memory use is bounded by the buffer whatever the marker count.
+	*/
+	class CSVFileWriter
+	{
+	public:
+		explicit CSVFileWriter(const ASL::String& inFilePath)
+			:
+			mFilePath(inFilePath),
+			mResult(ASL::kSuccess)
+		{
+			mBuffer.reserve(kCSVWriteBufferSize + kCSVWriteBufferSize / 4);
+		}
 
-		try 
+		bool Open()
 		{
-			result = outputFile.Create(
-				inFilePath,
+			mResult = mFile.Create(
+				mFilePath,
 				ASL::FileAccessFlags::kWrite,
 				ASL::FileShareModeFlags::kNone,
 				ASL::FileCreateDispositionFlags::kCreateAlways,
 				ASL::FileAttributesFlags::kAttributeNormal);
 
-			if (ASL::ResultSucceeded(result))
+			if (ASL::ResultSucceeded(mResult))
 			{
 				// Unicode BOM
 				ASL::UInt16 unicodeIdentifier = 0xFEFF;
 				ASL::UInt32 headToWrite = 2;
 				ASL::UInt32 headsWritten = 0;
-				result = outputFile.Write(&unicodeIdentifier, headToWrite, headsWritten);
+				mResult = mFile.Write(&unicodeIdentifier, headToWrite, headsWritten);
+			}
+			return ASL::ResultSucceeded(mResult);
+		}
 
-				dvacore::UTF16String str = outputStream.str();
-				ASL::UInt32 bytesToWrite = static_cast<ASL::UInt32>(str.size() * sizeof(dvacore::UTF16String::value_type));
-				ASL::UInt32 bytesWritten = 0;
-				result = outputFile.Write(str.data(), bytesToWrite, bytesWritten);
+		/*
+		** Returns false once a write has failed; nothing more reaches the file after that.
+		*/
+		bool AppendRow(const ASL::String& inRow)
+		{
+			mBuffer += inRow;
+			mBuffer += CSV_LINE_BREAK;
+			if (mBuffer.size() >= kCSVWriteBufferSize)
+			{
+				Flush();
 			}
+			return ASL::ResultSucceeded(mResult);
+		}
 
-			if (!ASL::ResultSucceeded(result))
+		/*
+		** Append rows that already carry their line breaks.
+		*/
+		bool AppendRows(const ASL::String& inRows)
+		{
+			mBuffer += inRows;
+			if (mBuffer.size() >= kCSVWriteBufferSize)
 			{
-				ML::SDKErrors::SetSDKErrorString(dvacore::ZString(kFailToWriteToFile, inFilePath));
-				return false;
+				Flush();
 			}
+			return ASL::ResultSucceeded(mResult);
 		}
-		catch (...)
+
+		bool Close()
 		{
-			ML::SDKErrors::SetSDKErrorString(dvacore::ZString(kWriteToFileException, inFilePath));
-			return false;
+			Flush();
+			mFile.Close();
+			return ASL::ResultSucceeded(mResult);
 		}
 
-		return true;
-	}
+	private:
+		void Flush()
+		{
+			if (ASL::ResultSucceeded(mResult) && !mBuffer.empty())
+			{
+				ASL::UInt32 bytesToWrite = static_cast<ASL::UInt32>(mBuffer.size() * sizeof(dvacore::UTF16String::value_type));
+				ASL::UInt32 bytesWritten = 0;
+				mResult = mFile.Write(mBuffer.data(), bytesToWrite, bytesWritten);
+			}
+			mBuffer.clear();
+		}
+
+		ASL::String mFilePath;
+		ASL::File mFile;
+		dvacore::UTF16String mBuffer;
+		ASL::Result mResult;
+	};
 
  } // namespace
 
  bool SaveSingleFile(const PL::ExportMarker::AssetItemMarkersInfoPairVec& inItemMarkersInfo,
 					 const ASL::String& inCSVHeader, 
 					 const ASL::String& inFilePath,
-					 ASL::String& ioFileName )
+					 ASL::String& ioFileName)
  {
 	 DVA_ASSERT(!inCSVHeader.empty());
 
-	 ASL::String markerRow;
-	 ASL::String assetName;
-	 ASL::String assetParentBinPath;
-	 ASL::String assetFilePath;
-
-	 MarkerRows rows;
-	 rows.push_back(inCSVHeader);
+	 ASL::String validFullPath = GetValidFilePath(inFilePath, ioFileName, CSV_FILE_EXT);
 
-	 BOOST_FOREACH(const ExportMarker::AssetItemMarkersInfoPair& item, inItemMarkersInfo)
+	 try
 	 {
-		 assetName = EscapeSpecialChar(item.first->name) + tabDelimiter;
-		 assetParentBinPath = EscapeSpecialChar(item.first->parentBinPath) + tabDelimiter;
-		 assetFilePath = EscapeSpecialChar(item.first->mediaPath);
+		 CSVFileWriter writer(validFullPath);
+		 bool succeeded = writer.Open() && writer.AppendRow(inCSVHeader);
 
-		 // have markers in an asset
-		 if (item.second.size() != 0)
+		 ASL::String assetRows;
+		 for (size_t i = 0; succeeded && i < inItemMarkersInfo.size(); ++i)
 		 {
-			 BOOST_FOREACH(const CottonwoodMarker& marker, item.second)
-			 {
-				 markerRow = BuildMarkerRow(
-					 marker, 
-					 item.first->frameRate, 
-					 item.first->mediaOffset, 
-					 item.first->isDropFrame);
-				 markerRow = assetName + assetParentBinPath + markerRow + assetFilePath;
-				 rows.push_back(markerRow);
-			 }
+			 assetRows.clear();
+			 FormatAssetRows(inItemMarkersInfo[i], &assetRows);
+			 succeeded = writer.AppendRows(assetRows);
 		 }
-		 else
+
+		 succeeded = writer.Close() && succeeded;
+
+		 if (!succeeded)
 		 {
-			 markerRow = assetName + assetParentBinPath + EMPTY_MARKER_STR + assetFilePath;
-			 rows.push_back(markerRow);
+			 ML::SDKErrors::SetSDKErrorString(dvacore::ZString(kFailToWriteToFile, validFullPath));
+			 return false;
 		 }
-	 } 
+	 }
+	 catch (...)
+	 {
+		 ML::SDKErrors::SetSDKErrorString(dvacore::ZString(kWriteToFileException, validFullPath));
+		 return false;
+	 }
 
-	 ASL::String validFullPath = GetValidFilePath(inFilePath, ioFileName, CSV_FILE_EXT);
-	 return  WriteCSVFile(rows, validFullPath, CSV_FILE_EXT);
+	 return true;
  }
 
  bool SaveMutlipeFile(const PL::ExportMarker::AssetItemMarkersInfoPairVec& inItemMarkersInfo,
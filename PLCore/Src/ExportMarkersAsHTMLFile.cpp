@@ -72,17 +72,45 @@ namespace
 	const ASL::StdString tableThreadCellTagRegex("<td[^>]*?>");
 	const ASL::StdString tableRowTagRegex("(<tr[^>]*?>.*?</tr>)(.*)");
 
-	const ASL::StdString assetNameRegex("\\{ASSETNAME\\}");
-	const ASL::StdString assetParentBinPathRegex("\\{BIN\\}");
-	const ASL::StdString markerThumbnailImageRegex("\\{THUMBNAILIMAGE\\}");
-	const ASL::StdString markerNameRegex("\\{MARKERNAME\\}");
-	const ASL::StdString markerCommentRegex("\\{DESCRIPTION\\}");
-	const ASL::StdString markerInTimeRegex("\\{IN\\}");
-	const ASL::StdString markerOutTimeRegex("\\{OUT\\}");
-	const ASL::StdString markerDurationRegex("\\{DURATION\\}");
-	const ASL::StdString markerTypeRegex("\\{MARKERTYPE\\}");
-	const ASL::StdString assetMediaPathRegex("\\{FILEPATH\\}");
-	const ASL::StdString markerTagsRegex("\\{TAGS\\}");
+	/*
+	** placeholders a template row may contain, in the same order as sTemplateFieldNames
+	*/
+	enum TemplateField
+	{
+		kTemplateField_AssetName,
+		kTemplateField_AssetParentBinPath,
+		kTemplateField_MarkerThumbnailImage,
+		kTemplateField_MarkerName,
+		kTemplateField_MarkerComment,
+		kTemplateField_MarkerInTime,
+		kTemplateField_MarkerOutTime,
+		kTemplateField_MarkerDuration,
+		kTemplateField_MarkerType,
+		kTemplateField_AssetMediaPath,
+		kTemplateField_MarkerTags,
+		kTemplateField_Count,
+		kTemplateField_None = kTemplateField_Count
+	};
+
+	const char* const sTemplateFieldNames[kTemplateField_Count] =
+	{
+		"{ASSETNAME}",
+		"{BIN}",
+		"{THUMBNAILIMAGE}",
+		"{MARKERNAME}",
+		"{DESCRIPTION}",
+		"{IN}",
+		"{OUT}",
+		"{DURATION}",
+		"{MARKERTYPE}",
+		"{FILEPATH}",
+		"{TAGS}",
+	};
+
+	typedef ASL::StdString TemplateFieldValues[kTemplateField_Count];
+
+	// HTML output is flushed to disk whenever this much is buffered.
+	const size_t kHTMLWriteChunkSize = 256 * 1024;
 
 	const char* const sCreateFolderError = "$$$/Prelude/PLCore/ExportMarkersAsHTMLFile/CreatFolderError=Fail to create folder @0.";
 	const char* const sCreateFileError   = "$$$/Prelude/PLCore/ExportMarkersAsHTMLFile/CreatFileError=Fail to create HTML file @0.";
@@ -91,6 +119,61 @@ namespace
 	const char* const sTemplateMissing   = "$$$/Prelude/PLCore/ExportMarkersAsHTMLFile/TemplateMissing=The HTML template @0 is missing.";
 	const char* const sTemplateDamaged   = "$$$/Prelude/PLCore/ExportMarkersAsHTMLFile/TemplateDamaged=The HTML template @0 is damaged.";
 
+	/*
+	** Streams rendered table rows into the HTML file. Rows are already UTF-8
+	** and are appended as is; the buffer is flushed in kHTMLWriteChunkSize chunks.
+	*/
+	class HTMLRowWriter
+	{
+	public:
+		HTMLRowWriter(
+			ASL::File& inHTMLFile,
+			const ASL::String& inFileFullPath)
+			:
+			mHTMLFile(inHTMLFile),
+			mFileFullPath(inFileFullPath)
+		{
+			mBuffer.reserve(kHTMLWriteChunkSize * 2);
+		}
+
+		ASL::Result WriteRow(const ASL::StdString& inRow)
+		{
+			mBuffer += inRow;
+			mBuffer += "\n\r";
+			if (mBuffer.size() >= kHTMLWriteChunkSize)
+			{
+				return Flush();
+			}
+			return ASL::kSuccess;
+		}
+
+		ASL::Result Flush()
+		{
+			if (mBuffer.empty())
+			{
+				return ASL::kSuccess;
+			}
+
+			ASL::UInt32 numberOfBytesWriten = 0;
+			ASL::Result result = mHTMLFile.Write(
+				mBuffer.data(), 
+				static_cast<ASL::UInt32>(mBuffer.size()),
+				numberOfBytesWriten);
+			if (!ASL::ResultSucceeded(result))
+			{
+				ML::SDKErrors::SetSDKErrorString(dvacore::ZString(sWriteFileError, mFileFullPath));
+				return result;
+			}
+			mBuffer.clear();
+			return result;
+		}
+
+	private:
+		ASL::File& mHTMLFile;
+		const ASL::String& mFileFullPath;
+		ASL::StdString mBuffer;
+	};
+
 	enum MediaType
 	{
 		kVideo,
@@ -141,42 +224,127 @@ namespace
 
 	typedef boost::shared_ptr<FileManagementInfo> FileManagementInfoPtr;
 
+	/*
+	** one piece of a compiled template row
+	** @var	literal	text copied as is
+	** @var field	placeholder following the literal, or kTemplateField_None
+	*/
+	struct TemplateRowToken
+	{
+		ASL::StdString literal;
+		TemplateField field;
+	};
+
+	typedef std::vector<TemplateRowToken> TemplateRow;
+
+	/*
+	** Split a template row into literal text and placeholders once, so that rendering
+	** a row is only concatenation.
+	*/
+	TemplateRow CompileTemplateRow(const ASL::StdString& inRow)
+	{
+		TemplateRow compiledRow;
+		ASL::StdString::size_type literalStart = 0;
+		ASL::StdString::size_type pos = inRow.find('{');
+
+		while (pos != ASL::StdString::npos)
+		{
+			TemplateField field = kTemplateField_None;
+			for (int i = 0; i < kTemplateField_Count; ++i)
+			{
+				if (inRow.compare(pos, std::strlen(sTemplateFieldNames[i]), sTemplateFieldNames[i]) == 0)
+				{
+					field = static_cast<TemplateField>(i);
+					break;
+				}
+			}
+
+			if (field == kTemplateField_None)
+			{
+				pos = inRow.find('{', pos + 1);
+				continue;
+			}
+
+			TemplateRowToken token;
+			token.literal = inRow.substr(literalStart, pos - literalStart);
+			token.field = field;
+			compiledRow.push_back(token);
+
+			literalStart = pos + std::strlen(sTemplateFieldNames[field]);
+			pos = inRow.find('{', literalStart);
+		}
+
+		if (literalStart < inRow.size())
+		{
+			TemplateRowToken token;
+			token.literal = inRow.substr(literalStart);
+			token.field = kTemplateField_None;
+			compiledRow.push_back(token);
+		}
+
+		return compiledRow;
+	}
+
+	/*
+	** Render a compiled row into outRow, reusing its storage.
+	*/
+	void RenderTemplateRow(
+		const TemplateRow& inRow,
+		const TemplateFieldValues& inValues,
+		ASL::StdString& outRow)
+	{
+		outRow.clear();
+		BOOST_FOREACH(const TemplateRowToken& token, inRow)
+		{
+			outRow += token.literal;
+			if (token.field != kTemplateField_None)
+			{
+				outRow += inValues[token.field];
+			}
+		}
+	}
+
 	/*
 	** use to store template table 
-	** @var	header	table header string of template
-	** @var rows	table rows with style
+	** @var	header	compiled table header of template
+	** @var rows	compiled table rows with style
 	*/
 	class TemplateTableElement
 	{
 	public:
-		void SetHeader(const ASL::StdString inHeader)
+		void SetHeader(const ASL::StdString& inHeader)
 		{
-			header = inHeader;
+			header = CompileTemplateRow(inHeader);
 		};
 
-		ASL::StdString GetHeader()
+		const TemplateRow& GetHeader() const
 		{
 			return header;
 		};
 
-		void AddRow(const ASL::StdString inRow)
+		bool HasHeader() const
 		{
-			rows.push_back(inRow);
+			return !header.empty();
+		};
+
+		void AddRow(const ASL::StdString& inRow)
+		{
+			rows.push_back(CompileTemplateRow(inRow));
 		};
 		
-		ASL::StdString GetRow(const ASL::UInt32 inRowsCount)
+		const TemplateRow& GetRow(const ASL::UInt32 inRowsCount) const
 		{
 			return rows.at(inRowsCount%rows.size());
 		};
 
-		size_t GetRowsSize()
+		size_t GetRowsSize() const
 		{
 			return rows.size();
 		};
 
 	private:	
-		ASL::StdString header;
-		std::vector<ASL::StdString> rows;
+		TemplateRow header;
+		std::vector<TemplateRow> rows;
 	};
 
 	typedef boost::shared_ptr<TemplateTableElement> TemplateTableElementPtr;
@@ -298,56 +466,207 @@ namespace
 
 
 	/*
-	**
+	** one thumbnail extraction shared by every marker at the same media position
+	** @var	thumbnailPos	the position of thumbnail in the clip
+	** @var imagePaths	dest paths of all markers that need this thumbnail
+	*/
+	struct ThumbnailRequest
+	{
+		dvamediatypes::TickTime thumbnailPos;
+		std::vector<ASL::String> imagePaths;
+	};
+
+	/*
+	** all thumbnail requests of one clip, in time order so the decoder seeks forward
+	*/
+	struct MediaThumbnailRequests
+	{
+		ASL::String mediaPath;
+		MediaType mediaType;
+		std::vector<ThumbnailRequest> requests;
+	};
+
+	/*
+	** a worker lane extracts the thumbnails of one clip after another
+	** @var	mediaIndex	clip currently handled by the lane
+	** @var requestIndex	next request of that clip
+	** @var issuing	the lane is inside RequestThumbnailAsync
+	** @var completedInline	the request finished before RequestThumbnailAsync returned
+	*/
+	struct ThumbnailLane
+	{
+		size_t mediaIndex;
+		size_t requestIndex;
+		bool issuing;
+		bool completedInline;
+	};
+
+	/*
+	** use to schedule thumbnail exporting
+	** @var	medias	de-duplicated requests grouped by clip
+	** @var nextMediaIndex	first clip no lane has claimed yet
+	** @var lanes	at most kMaxThumbnailLanes clips are decoded at the same time
+	** @var criticalSection	control access to the lanes
+	*/
+	struct ThumbnailExportStage
+	{
+		std::vector<MediaThumbnailRequests> medias;
+		size_t nextMediaIndex;
+		std::vector<ThumbnailLane> lanes;
+		ASL::CriticalSection criticalSection;
+
+		ThumbnailManagementInfoPtr thumbnailManagementInfoPtr;
+		FileManagementInfoPtr fileManagementInfoPtr;
+		PL::ExportMarker::ExportMarkersResultPtr exportMarkersResultPtr;
+	};
+
+	typedef boost::shared_ptr<ThumbnailExportStage> ThumbnailExportStagePtr;
+
+	// Thumbnails of at most this many clips are requested at the same time.
+	const size_t kMaxThumbnailLanes = 4;
+
+	void IssueThumbnailRequests(ThumbnailExportStagePtr inStagePtr, size_t inLaneIndex);
+
+	/*
+	** Place the extracted thumbnail at every path that asked for it.
 	*/
 	void ExportThumbnailImageCallback(
-		const ASL::String& inImageFullPath,
-		MediaType inMediaType,
-		PL::ExportMarker::ExportMarkersResultPtr inExportMarkersResultPtr,
-		ThumbnailManagementInfoPtr inThumbnailManagementInfoPtr,
-		FileManagementInfoPtr inFileManagementInfoPtr,
+		ThumbnailExportStagePtr inStagePtr,
+		size_t inLaneIndex,
+		size_t inMediaIndex,
+		size_t inRequestIndex,
 		const ASL::String& inThumbnailFileName,
 		ASL::Result inResult)
 	{
+		const MediaThumbnailRequests& media = inStagePtr->medias[inMediaIndex];
+		const ThumbnailRequest& request = media.requests[inRequestIndex];
 
-		if (ASL::PathUtils::ExistsOnDisk(inImageFullPath))
+		ASL::Result result = ASL::kSuccess;
+		for (size_t i = 0; i < request.imagePaths.size(); ++i)
 		{
-			ASL::File::Delete(inImageFullPath);
+			const ASL::String& imageFullPath = request.imagePaths[i];
+			if (ASL::PathUtils::ExistsOnDisk(imageFullPath))
+			{
+				ASL::File::Delete(imageFullPath);
+			}
+
+			if (i > 0)
+			{
+				// Markers at the same position share one extraction.
+				result = ASL::ResultSucceeded(result) ?
+					ASL::File::Copy(request.imagePaths[0], imageFullPath) :
+					result;
+			}
+			else
+			{
+				/*
+				**  Thumbnail image of audio is not dynamically generated and probably used by other components,
+				**  so don't use Move to change its position and use Copy instead.
+				*/
+				switch (media.mediaType)
+				{
+				case kVideo:
+					result = ASL::File::Move(
+						inThumbnailFileName, imageFullPath);
+					break;
+				case kAudio:
+					result = ASL::File::Copy(
+						inThumbnailFileName, imageFullPath);
+					break;
+				default:
+					result = ASL::ResultFlags::kResultTypeFailure;
+					break;
+				}
+			}
+
+			if (!ASL::ResultSucceeded(result))
+			{
+				inStagePtr->exportMarkersResultPtr->allSaveSucceed = false;
+				ASL::AsyncCallFromMainThread(boost::bind(
+					ExportThumbnailImageFail, 
+					imageFullPath));
+			}
+
+			CheckThumbnailExportProgress(
+				inStagePtr->fileManagementInfoPtr, 
+				inStagePtr->thumbnailManagementInfoPtr, 
+				inStagePtr->exportMarkersResultPtr);
 		}
 
-		ASL::Result result = ASL::kSuccess;
-			
-		/*
-		**  Thumbnail image of audio is not dynamically generated and probably used by other components,
-		**  so don't use Move to change its position and use Copy instead.
-		*/
-		switch (inMediaType)
+		bool continueLane = false;
 		{
-		case kVideo:
-			result = ASL::File::Move(
-				inThumbnailFileName, inImageFullPath);
-			break;
-		case kAudio:
-			result = ASL::File::Copy(
-				inThumbnailFileName, inImageFullPath);
-			break;
-		default:
-			result = ASL::ResultFlags::kResultTypeFailure;
-			break;
+			ASL::CriticalSectionLock lock(inStagePtr->criticalSection);
+			ThumbnailLane& lane = inStagePtr->lanes[inLaneIndex];
+			if (lane.issuing)
+			{
+				// The issuing loop is still on the stack and will go on by itself.
+				lane.completedInline = true;
+			}
+			else
+			{
+				continueLane = true;
+			}
 		}
 
-		if (!ASL::ResultSucceeded(result))
+		if (continueLane)
 		{
-			inExportMarkersResultPtr->allSaveSucceed = false;
-			ASL::AsyncCallFromMainThread(boost::bind(
-				ExportThumbnailImageFail, 
-				inImageFullPath));
+			IssueThumbnailRequests(inStagePtr, inLaneIndex);
 		}
-
-		CheckThumbnailExportProgress(inFileManagementInfoPtr, inThumbnailManagementInfoPtr, inExportMarkersResultPtr);
 	}	// end of ExportThumbnailImageCallback
 
 
+	/*
+	** Request the next thumbnail of a lane, claiming the next clip when the current one is done.
+	** Requests that complete synchronously are looped over here rather than recursing.
+	*/
+	void IssueThumbnailRequests(ThumbnailExportStagePtr inStagePtr, size_t inLaneIndex)
+	{
+		for (;;)
+		{
+			size_t mediaIndex = 0;
+			size_t requestIndex = 0;
+			{
+				ASL::CriticalSectionLock lock(inStagePtr->criticalSection);
+				ThumbnailLane& lane = inStagePtr->lanes[inLaneIndex];
+				if (lane.requestIndex >= inStagePtr->medias[lane.mediaIndex].requests.size())
+				{
+					if (inStagePtr->nextMediaIndex >= inStagePtr->medias.size())
+					{
+						return;
+					}
+					lane.mediaIndex = inStagePtr->nextMediaIndex++;
+					lane.requestIndex = 0;
+				}
+
+				mediaIndex = lane.mediaIndex;
+				requestIndex = lane.requestIndex++;
+				lane.issuing = true;
+				lane.completedInline = false;
+			}
+
+			SRLibrarySupport::RequestThumbnailAsync(
+				inStagePtr->medias[mediaIndex].mediaPath,
+				inStagePtr->medias[mediaIndex].requests[requestIndex].thumbnailPos,
+				boost::bind<void>(
+					ExportThumbnailImageCallback, 
+					inStagePtr,
+					inLaneIndex,
+					mediaIndex,
+					requestIndex,
+					_1, _2));
+
+			ASL::CriticalSectionLock lock(inStagePtr->criticalSection);
+			ThumbnailLane& lane = inStagePtr->lanes[inLaneIndex];
+			lane.issuing = false;
+			if (!lane.completedInline)
+			{
+				// The callback will continue this lane.
+				return;
+			}
+		}
+	}	// end of IssueThumbnailRequests
+
+
 	/*
 	**
 	*/
@@ -364,30 +683,77 @@ namespace
 			return;
 		}
 
+		ThumbnailExportStagePtr stagePtr(new ThumbnailExportStage());
+		stagePtr->nextMediaIndex = 0;
+		stagePtr->thumbnailManagementInfoPtr = inThumbnailManagementInfoPtr;
+		stagePtr->fileManagementInfoPtr = inFileManagementInfoPtr;
+		stagePtr->exportMarkersResultPtr = inExportMarkersResultPtr;
+
+		// Group by clip and collapse markers at the same position into one request.
+		typedef std::map<dvamediatypes::TickTime, std::vector<ASL::String> > PositionImagesMap;
+		std::map<ASL::String, size_t> mediaIndexMap;
+		std::vector<PositionImagesMap> mediaPositions;
+
 		BOOST_FOREACH(ThumbnailImageInfoPtr thumbnailImageInfoItem, inThumbnailImagesInfoVec)
 		{
-			if (ASL::PathUtils::ExistsOnDisk(thumbnailImageInfoItem->mediaPath))
-			{
-				SRLibrarySupport::RequestThumbnailAsync(
-					thumbnailImageInfoItem->mediaPath,
-					thumbnailImageInfoItem->thumbnailPos,
-					boost::bind<void>(
-						ExportThumbnailImageCallback, 
-						thumbnailImageInfoItem->imagePath, 
-						thumbnailImageInfoItem->mediaType, 
-						inExportMarkersResultPtr,
-						inThumbnailManagementInfoPtr,
-						inFileManagementInfoPtr,
-						_1, _2));
-			} 
-			else
+			if (!ASL::PathUtils::ExistsOnDisk(thumbnailImageInfoItem->mediaPath))
 			{
 				inExportMarkersResultPtr->allSaveSucceed = false;
 				ML::SDKErrors::SetSDKErrorString(dvacore::ZString(sExportFileError, thumbnailImageInfoItem->imagePath));
 				CheckThumbnailExportProgress(inFileManagementInfoPtr, inThumbnailManagementInfoPtr, inExportMarkersResultPtr);
+				continue;
+			}
+
+			std::map<ASL::String, size_t>::iterator mediaIter = mediaIndexMap.find(thumbnailImageInfoItem->mediaPath);
+			if (mediaIter == mediaIndexMap.end())
+			{
+				MediaThumbnailRequests media;
+				media.mediaPath = thumbnailImageInfoItem->mediaPath;
+				media.mediaType = thumbnailImageInfoItem->mediaType;
+				stagePtr->medias.push_back(media);
+				mediaPositions.push_back(PositionImagesMap());
+				mediaIter = mediaIndexMap.insert(std::make_pair(media.mediaPath, stagePtr->medias.size() - 1)).first;
+			}
+
+			mediaPositions[mediaIter->second][thumbnailImageInfoItem->thumbnailPos].push_back(thumbnailImageInfoItem->imagePath);
+		}
+
+		for (size_t i = 0; i < stagePtr->medias.size(); ++i)
+		{
+			for (PositionImagesMap::const_iterator positionIter = mediaPositions[i].begin(); 
+				positionIter != mediaPositions[i].end(); 
+				++positionIter)
+			{
+				ThumbnailRequest request;
+				request.thumbnailPos = positionIter->first;
+				request.imagePaths = positionIter->second;
+				stagePtr->medias[i].requests.push_back(request);
 			}
 		}
 
+		if (stagePtr->medias.empty())
+		{
+			return;
+		}
+
+		{
+			ASL::CriticalSectionLock lock(stagePtr->criticalSection);
+			size_t const laneCount = std::min(stagePtr->medias.size(), kMaxThumbnailLanes);
+			for (size_t i = 0; i < laneCount; ++i)
+			{
+				ThumbnailLane lane;
+				lane.mediaIndex = stagePtr->nextMediaIndex++;
+				lane.requestIndex = 0;
+				lane.issuing = false;
+				lane.completedInline = false;
+				stagePtr->lanes.push_back(lane);
+			}
+		}
+
+		for (size_t i = 0; i < stagePtr->lanes.size(); ++i)
+		{
+			IssueThumbnailRequests(stagePtr, i);
+		}
 	}	// end of ExportAllThumbnailImages
 
 
@@ -435,11 +801,42 @@ namespace
 		return ASL_STR("./images/") + imageFilename;
 	}	// end of CreateThumbnailImageName
 
+	/*
+	** Fills one value per template placeholder, in the order of sTemplateFieldNames.
+	*/
+	void MakeTemplateFieldValues(
+		const ASL::String& inAssetName,
+		const ASL::String& inAssetParentBinPath,
+		const ASL::String& inMarkerThumbnailImage,
+		const ASL::String& inMarkerName,
+		const ASL::String& inMarkerComment,
+		const ASL::String& inMarkerInTime,
+		const ASL::String& inMarkerOutTime,
+		const ASL::String& inMarkerDuration,
+		const ASL::String& inMarkerType,
+		const ASL::String& inAssetMediaPath,
+		const ASL::String& inMarkerTags,
+		TemplateFieldValues& outValues)
+	{
+		outValues[kTemplateField_AssetName] = ASL::MakeStdString(inAssetName);
+		outValues[kTemplateField_AssetParentBinPath] = ASL::MakeStdString(inAssetParentBinPath);
+		outValues[kTemplateField_MarkerThumbnailImage] = ASL::MakeStdString(inMarkerThumbnailImage);
+		outValues[kTemplateField_MarkerName] = ASL::MakeStdString(inMarkerName);
+		outValues[kTemplateField_MarkerComment] = ASL::MakeStdString(inMarkerComment);
+		outValues[kTemplateField_MarkerInTime] = ASL::MakeStdString(inMarkerInTime);
+		outValues[kTemplateField_MarkerOutTime] = ASL::MakeStdString(inMarkerOutTime);
+		outValues[kTemplateField_MarkerDuration] = ASL::MakeStdString(inMarkerDuration);
+		outValues[kTemplateField_MarkerType] = ASL::MakeStdString(inMarkerType);
+		outValues[kTemplateField_AssetMediaPath] = ASL::MakeStdString(inAssetMediaPath);
+		outValues[kTemplateField_MarkerTags] = ASL::MakeStdString(inMarkerTags);
+	}	// end of MakeTemplateFieldValues
+
+
 	/*
 	**
 	*/	
 	ASL::Result ConvertMarkerInfoToHTML(
-		ASL::String& outMarkerRow,
+		ASL::StdString& outMarkerRow,
 		const CottonwoodMarker& inMarkerItem,
 		const ASL::String& inAssetName,
 		const ASL::String& inAssetParentBinPath,
@@ -453,7 +850,6 @@ namespace
 		TemplateTableElementPtr inTemplateTableElementPtr)
 	{
 		ASL::Result result = ASL::kSuccess;
-		ASL::StdString outMarkerRowStd = inTemplateTableElementPtr->GetRow(inRowsCount-1);
 		ASL::String markerName = inMarkerItem.GetName();
 
 		ASL::String assetName = inAssetName;
@@ -500,38 +896,22 @@ namespace
 		TagParamMap markerTagParamMap = inMarkerItem.GetTagParams();
 		ASL::String markerTags = PL::SRUtilitiesPrivate::ConvertMarkerTagsToString(markerTagParamMap);
 
-		try
-		{
-			outMarkerRowStd = boost::regex_replace(outMarkerRowStd, 
-				boost::regex(assetNameRegex), ASL::MakeStdString(assetName), boost::regex_constants::format_literal);
-			outMarkerRowStd = boost::regex_replace(outMarkerRowStd, 
-				boost::regex(assetParentBinPathRegex), ASL::MakeStdString(assetParentBinPath), boost::regex_constants::format_literal);
-			outMarkerRowStd = boost::regex_replace(outMarkerRowStd, 
-				boost::regex(markerThumbnailImageRegex), ASL::MakeStdString(markerThumbnailImage), boost::regex_constants::format_literal);
-			outMarkerRowStd = boost::regex_replace(outMarkerRowStd, 
-				boost::regex(markerNameRegex), ASL::MakeStdString(markerName), boost::regex_constants::format_literal);
-			outMarkerRowStd = boost::regex_replace(outMarkerRowStd, 
-				boost::regex(markerCommentRegex), ASL::MakeStdString(markerComment), boost::regex_constants::format_literal);
-			outMarkerRowStd = boost::regex_replace(outMarkerRowStd, 
-				boost::regex(markerInTimeRegex), ASL::MakeStdString(markerInTime), boost::regex_constants::format_literal);
-			outMarkerRowStd = boost::regex_replace(outMarkerRowStd, 
-				boost::regex(markerOutTimeRegex), ASL::MakeStdString(markerOutTime), boost::regex_constants::format_literal);
-			outMarkerRowStd = boost::regex_replace(outMarkerRowStd, 
-				boost::regex(markerDurationRegex), ASL::MakeStdString(markerDuration), boost::regex_constants::format_literal);
-			outMarkerRowStd = boost::regex_replace(outMarkerRowStd, 
-				boost::regex(markerTypeRegex), ASL::MakeStdString(markerType), boost::regex_constants::format_literal);
-			outMarkerRowStd = boost::regex_replace(outMarkerRowStd, 
-				boost::regex(assetMediaPathRegex), ASL::MakeStdString(assetMediaPath), boost::regex_constants::format_literal);
-			outMarkerRowStd = boost::regex_replace(outMarkerRowStd, 
-				boost::regex(markerTagsRegex), ASL::MakeStdString(markerTags), boost::regex_constants::format_literal);
-		}
-		catch (boost::bad_expression bad) 
-		{
-			boost::regex_constants::error_type err = bad.code();
-			std::ptrdiff_t diff = bad.position();
-		}
-
-		outMarkerRow = ASL::MakeString(outMarkerRowStd);
+		TemplateFieldValues values;
+		MakeTemplateFieldValues(
+			assetName,
+			assetParentBinPath,
+			markerThumbnailImage,
+			markerName,
+			markerComment,
+			markerInTime,
+			markerOutTime,
+			markerDuration,
+			markerType,
+			assetMediaPath,
+			markerTags,
+			values);
+
+		RenderTemplateRow(inTemplateTableElementPtr->GetRow(inRowsCount-1), values, outMarkerRow);
 		return result;
 	}	// end of ConvertMarkerInfoToHTML
 
@@ -539,11 +919,9 @@ namespace
 	/*
 	**
 	*/
-	ASL::String ConvertTableHeaderToHTML(
+	ASL::StdString ConvertTableHeaderToHTML(
 		TemplateTableElementPtr inTemplateTableElementPtr)
 	{
-		ASL::String headerRow;
-		ASL::StdString headerRowStd = inTemplateTableElementPtr->GetHeader();
 
 		ASL::String assetName(dvacore::ZString(PL::ExportMarker::sAssetName));
 		ASL::String assetParentBinPath(dvacore::ZString(PL::ExportMarker::sAssetParentBinPath));
@@ -569,38 +947,23 @@ namespace
 		assetMediaPath = EncodeHTMLReservedCharacters(assetMediaPath);
 		markerTags = EncodeHTMLReservedCharacters(markerTags);
 
-		try 
-		{
-			headerRowStd = boost::regex_replace(headerRowStd, 
-				boost::regex(assetNameRegex), ASL::MakeStdString(assetName), boost::regex_constants::format_literal);
-			headerRowStd = boost::regex_replace(headerRowStd, 
-				boost::regex(assetParentBinPathRegex), ASL::MakeStdString(assetParentBinPath), boost::regex_constants::format_literal);
-			headerRowStd = boost::regex_replace(headerRowStd, 
-				boost::regex(markerThumbnailImageRegex), ASL::MakeStdString(markerThumbnailImage), boost::regex_constants::format_literal);
-			headerRowStd = boost::regex_replace(headerRowStd, 
-				boost::regex(markerNameRegex), ASL::MakeStdString(markerName), boost::regex_constants::format_literal);
-			headerRowStd = boost::regex_replace(headerRowStd,
-				boost::regex(markerCommentRegex), ASL::MakeStdString(markerComment), boost::regex_constants::format_literal);
-			headerRowStd = boost::regex_replace(headerRowStd, 
-				boost::regex(markerInTimeRegex), ASL::MakeStdString(markerInTime), boost::regex_constants::format_literal);
-			headerRowStd = boost::regex_replace(headerRowStd, 
-				boost::regex(markerOutTimeRegex), ASL::MakeStdString(markerOutTime), boost::regex_constants::format_literal);
-			headerRowStd = boost::regex_replace(headerRowStd, 
-				boost::regex(markerDurationRegex), ASL::MakeStdString(markerDuration), boost::regex_constants::format_literal);
-			headerRowStd = boost::regex_replace(headerRowStd, 
-				boost::regex(markerTypeRegex), ASL::MakeStdString(markerType), boost::regex_constants::format_literal);
-			headerRowStd = boost::regex_replace(headerRowStd, 
-				boost::regex(assetMediaPathRegex), ASL::MakeStdString(assetMediaPath), boost::regex_constants::format_literal);
-			headerRowStd = boost::regex_replace(headerRowStd, 
-				boost::regex(markerTagsRegex), ASL::MakeStdString(markerTags), boost::regex_constants::format_literal);
-		}
-		catch (boost::bad_expression bad) 
-		{
-			boost::regex_constants::error_type err = bad.code();
-			std::ptrdiff_t diff = bad.position();
-		}
-
-		headerRow = ASL::MakeString(headerRowStd);
+		TemplateFieldValues values;
+		MakeTemplateFieldValues(
+			assetName,
+			assetParentBinPath,
+			markerThumbnailImage,
+			markerName,
+			markerComment,
+			markerInTime,
+			markerOutTime,
+			markerDuration,
+			markerType,
+			assetMediaPath,
+			markerTags,
+			values);
+
+		ASL::StdString headerRow;
+		RenderTemplateRow(inTemplateTableElementPtr->GetHeader(), values, headerRow);
 		return headerRow;
 	}	// end of ConvertTableHeaderToHTML
 
@@ -610,13 +973,13 @@ namespace
 	*/
 	ASL::Result ConvertAssetInfoToHTML(
 		const PL::ExportMarker::AssetItemMarkersInfoPair& inAssetItem,
-		std::vector<ASL::String>& outMarkerListOfHTML,
+		HTMLRowWriter& inRowWriter,
 		const ASL::String& inImageDirFullPath,
 		ThumbnailImageInfoVec& outThumbnailImagesInfoVec,
 		ASL::UInt32& ioRowsCount,
 		TemplateTableElementPtr inTemplateTableElementPtr)
 	{
-		ASL::String markerRow; 
+		ASL::StdString markerRow; 
 		ASL::Result result = ASL::kSuccess;
 
 		dvamediatypes::FrameRate& assetFrameRate = inAssetItem.first->frameRate;
@@ -629,7 +992,6 @@ namespace
 		BOOST_FOREACH(CottonwoodMarker markerItem, inAssetItem.second)
 		{
 			ioRowsCount++;
-			markerRow = ASL_STR("");
 			result = ConvertMarkerInfoToHTML(
 								markerRow, 
 								markerItem,
@@ -648,7 +1010,9 @@ namespace
 			if (!ASL::ResultSucceeded(result))
 				return result;
 
-			outMarkerListOfHTML.push_back(markerRow);
+			result = inRowWriter.WriteRow(markerRow);
+			if (!ASL::ResultSucceeded(result))
+				return result;
 		}
 
 		return result;
@@ -657,44 +1021,28 @@ namespace
 
 	ASL::Result ConvertBlankAssetInfoToHTML(
 		const PL::ExportMarker::AssetItemMarkersInfoPair& inAssetItem,
-		std::vector<ASL::String>& outMarkerListOfHTML,
+		HTMLRowWriter& inRowWriter,
 		ASL::UInt32& ioRowsCount,
 		TemplateTableElementPtr inTemplateTableElementPtr)
 	{
-		ASL::String assetRow = ASL_STR(""); 
 		ASL::Result result = ASL::kSuccess;
 		
 		ioRowsCount++;
 
-		ASL::StdString assetRowStd = inTemplateTableElementPtr->GetRow(ioRowsCount-1);
 		ASL::String assetName = inAssetItem.first->name;
 		ASL::String assetParentBinPath = inAssetItem.first->parentBinPath;
 
 		assetName = EncodeHTMLReservedCharacters(assetName);
 		assetParentBinPath = EncodeHTMLReservedCharacters(assetParentBinPath);
 
-		try
-		{
-			assetRowStd = boost::regex_replace(assetRowStd, boost::regex(assetNameRegex), ASL::MakeStdString(assetName), boost::regex_constants::format_literal);
-			assetRowStd = boost::regex_replace(assetRowStd, boost::regex(assetParentBinPathRegex), ASL::MakeStdString(assetParentBinPath), boost::regex_constants::format_literal);
-			assetRowStd = boost::regex_replace(assetRowStd, boost::regex(markerThumbnailImageRegex), "");
-			assetRowStd = boost::regex_replace(assetRowStd, boost::regex(markerNameRegex), "");
-			assetRowStd = boost::regex_replace(assetRowStd, boost::regex(markerCommentRegex), "");
-			assetRowStd = boost::regex_replace(assetRowStd, boost::regex(markerInTimeRegex), "");
-			assetRowStd = boost::regex_replace(assetRowStd, boost::regex(markerOutTimeRegex), "");
-			assetRowStd = boost::regex_replace(assetRowStd, boost::regex(markerDurationRegex), "");
-			assetRowStd = boost::regex_replace(assetRowStd, boost::regex(markerTypeRegex), "");
-			assetRowStd = boost::regex_replace(assetRowStd, boost::regex(assetMediaPathRegex), "");
-			assetRowStd = boost::regex_replace(assetRowStd, boost::regex(markerTypeRegex), "");
-		}
-		catch (boost::bad_expression bad) 
-		{
-			boost::regex_constants::error_type err = bad.code();
-			std::ptrdiff_t diff = bad.position();
-		}
+		// Marker columns stay empty for an asset without markers.
+		TemplateFieldValues values;
+		values[kTemplateField_AssetName] = ASL::MakeStdString(assetName);
+		values[kTemplateField_AssetParentBinPath] = ASL::MakeStdString(assetParentBinPath);
 
-		assetRow = ASL::MakeString(assetRowStd);
-		outMarkerListOfHTML.push_back(assetRow);
+		ASL::StdString assetRow;
+		RenderTemplateRow(inTemplateTableElementPtr->GetRow(ioRowsCount-1), values, assetRow);
+		result = inRowWriter.WriteRow(assetRow);
 
 		return result;
 	}	// end of ConvertBlankAssetInfoToHTML
@@ -703,40 +1051,69 @@ namespace
 	/*
 	**
 	*/
-	ASL::Result  WriteHTMLFile(
-		const std::vector<ASL::String>& markerListOfHTML,
+	ASL::Result WriteAssetRows(
+		HTMLRowWriter& inRowWriter,
+		const PL::ExportMarker::AssetItemMarkersInfoPairVec& inAssetItemMarkersInfoPairVec,
+		const ASL::String& inImageDirFullPath,
+		ThumbnailImageInfoVec& outThumbnailImagesInfoVec,
+		TemplateTableElementPtr inTemplateTableElementPtr)
+	{
+		ASL::UInt32 RowsCount = 0;
+		ASL::Result result = inRowWriter.WriteRow(ConvertTableHeaderToHTML(inTemplateTableElementPtr));
+		if (!ASL::ResultSucceeded(result))
+			return result;
+
+		BOOST_FOREACH(const PL::ExportMarker::AssetItemMarkersInfoPair& assetItem, inAssetItemMarkersInfoPairVec)
+		{	
+			if (assetItem.second.size() == 0) 
+			{
+				result = ConvertBlankAssetInfoToHTML(assetItem, inRowWriter, RowsCount, inTemplateTableElementPtr);
+			}
+			else
+			{
+				result = ConvertAssetInfoToHTML(assetItem, inRowWriter, inImageDirFullPath, outThumbnailImagesInfoVec, RowsCount, inTemplateTableElementPtr);
+			}
+
+			if (!ASL::ResultSucceeded(result))
+				return result;
+		}
+
+		return inRowWriter.Flush();
+	}	// end of WriteAssetRows
+
+
+	/*
+	** Marker rows are rendered and written while the template is copied, so
+	** the whole table is never held in memory.
+	*/
+	ASL::Result  WriteHTMLContent(
+		ASL::File& inHTMLFile,
+		const PL::ExportMarker::AssetItemMarkersInfoPairVec& inAssetItemMarkersInfoPairVec,
+		const ASL::String& inImageDirFullPath,
+		ThumbnailImageInfoVec& outThumbnailImagesInfoVec,
+		TemplateTableElementPtr inTemplateTableElementPtr,
 		const ASL::String& inFileFullPath,
 		const ASL::String& inTemplateFilePath,
 		const ASL::String& inProjectName)
 	{
-		ASL::Result result;
+		ASL::Result result = ASL::kSuccess;
 		ASL::String linebreak = ASL_STR("\n\r");
 		bool tableStartTagNotFound = true;
 		bool tableEndTagNotFound = true;
 		bool titleStartTagNotFound = true;
+		const boost::regex tableStartTag(tableStartTagRegex, boost::regex::icase);
+		const boost::regex tableEndTag(tableEndTagRegex, boost::regex::icase);
+		const boost::regex titleStartTag(titleStartTagRegex, boost::regex::icase);
 
 		// Read HTML template into a file stream
 		std::ifstream templateFileStream(
 			reinterpret_cast<const char*>(dvacore::utility::UTF16to8(inTemplateFilePath).c_str()), 
 			std::ios::in);
-		
-		// create HTML file
-		ASL::File htmlFile;
-		result = htmlFile.Create(
-			inFileFullPath,
-			ASL::FileAccessFlags::kWrite,
-			ASL::FileShareModeFlags::kNone,
-			ASL::FileCreateDispositionFlags::kCreateAlways,
-			ASL::FileAttributesFlags::kAttributeNormal);
-		if (!ASL::ResultSucceeded(result))
-		{
-			ML::SDKErrors::SetSDKErrorString(dvacore::ZString(sCreateFileError, inFileFullPath));
-			return result;
-		}
 
 		// write HTML file
+		ASL::File& htmlFile = inHTMLFile;
 		ASL::UInt32 numberOfBytesWriten = 0;
-		dvacore::UTF8String makerHTMLUtf8;
+		HTMLRowWriter rowWriter(htmlFile, inFileFullPath);
 		ASL::String templateHTML;
 		dvacore::UTF8String templateHTMLUtf8;
 		ASL::StdString templateHTMLStd;
@@ -761,26 +1138,23 @@ namespace
 
 			// write marker info 
 			if (tableStartTagNotFound 
-					&& boost::regex_search(templateHTMLStd, boost::regex(tableStartTagRegex, boost::regex::icase)))
+					&& boost::regex_search(templateHTMLStd, tableStartTag))
 			{
 				tableStartTagNotFound = false;	
-				BOOST_FOREACH(ASL::String markerHTML, markerListOfHTML)
-				{
-					makerHTMLUtf8 = dvacore::utility::UTF16to8(markerHTML + linebreak);
-					result = htmlFile.Write(makerHTMLUtf8.data(), 
-							static_cast<ASL::UInt32>(makerHTMLUtf8.size() * sizeof(dvacore::UTF8String::value_type)),
-							numberOfBytesWriten);
-					if (!ASL::ResultSucceeded(result))
-					{
-						ML::SDKErrors::SetSDKErrorString(dvacore::ZString(sWriteFileError, inFileFullPath));
-						return result;
-					}
-				}
+
+				result = WriteAssetRows(
+					rowWriter,
+					inAssetItemMarkersInfoPairVec,
+					inImageDirFullPath,
+					outThumbnailImagesInfoVec,
+					inTemplateTableElementPtr);
+				if (!ASL::ResultSucceeded(result))
+					return result;
 			}
 
 			// write project name
 			if (titleStartTagNotFound
-					&& boost::regex_search(templateHTMLStd, boost::regex(titleStartTagRegex, boost::regex::icase)))
+					&& boost::regex_search(templateHTMLStd, titleStartTag))
 			{
 				titleStartTagNotFound = false;	
 				inProjectNameUtf8 = dvacore::utility::UTF16to8(inProjectName);
@@ -795,7 +1169,7 @@ namespace
 			}
 
 			if (tableEndTagNotFound  
-					&& boost::regex_search(templateHTMLStd, boost::regex(tableEndTagRegex, boost::regex::icase)))
+					&& boost::regex_search(templateHTMLStd, tableEndTag))
 			{
 				tableEndTagNotFound = false;
 				templateHTML = ASL::MakeString(templateHTMLStd);
@@ -818,6 +1192,80 @@ namespace
 			return ASL::ResultFlags::kResultTypeFailure;
 		}
 
+		return result;
+	}	// end of WriteHTMLContent
+
+
+	/*
+	** The page is written to a temp file next to inFileFullPath and swapped into
+	** place once complete, so a failed export never leaves a partial page behind.
+	*/
+	ASL::Result  WriteHTMLFile(
+		const PL::ExportMarker::AssetItemMarkersInfoPairVec& inAssetItemMarkersInfoPairVec,
+		const ASL::String& inImageDirFullPath,
+		ThumbnailImageInfoVec& outThumbnailImagesInfoVec,
+		TemplateTableElementPtr inTemplateTableElementPtr,
+		const ASL::String& inFileFullPath,
+		const ASL::String& inTemplateFilePath,
+		const ASL::String& inProjectName)
+	{
+		ASL::String tempFilePath = ASL::File::MakeUniqueTempPath(inFileFullPath);
+
+		// create HTML file
+		ASL::File htmlFile;
+		ASL::Result result = htmlFile.Create(
+			tempFilePath,
+			ASL::FileAccessFlags::kWrite,
+			ASL::FileShareModeFlags::kNone,
+			ASL::FileCreateDispositionFlags::kCreateAlways,
+			ASL::FileAttributesFlags::kAttributeNormal);
+		if (!ASL::ResultSucceeded(result))
+		{
+			ML::SDKErrors::SetSDKErrorString(dvacore::ZString(sCreateFileError, inFileFullPath));
+			return result;
+		}
+
+		result = WriteHTMLContent(
+			htmlFile,
+			inAssetItemMarkersInfoPairVec,
+			inImageDirFullPath,
+			outThumbnailImagesInfoVec,
+			inTemplateTableElementPtr,
+			inFileFullPath,
+			inTemplateFilePath,
+			inProjectName);
+		htmlFile.Close();
+
+		// SwapTempFile needs an existing destination.
+		if (ASL::ResultSucceeded(result) && !ASL::PathUtils::ExistsOnDisk(inFileFullPath))
+		{
+			ASL::File destinationFile;
+			result = destinationFile.Create(
+				inFileFullPath,
+				ASL::FileAccessFlags::kWrite,
+				ASL::FileShareModeFlags::kNone,
+				ASL::FileCreateDispositionFlags::kCreateAlways,
+				ASL::FileAttributesFlags::kAttributeNormal);
+			destinationFile.Close();
+			if (!ASL::ResultSucceeded(result))
+			{
+				ML::SDKErrors::SetSDKErrorString(dvacore::ZString(sCreateFileError, inFileFullPath));
+			}
+		}
+
+		if (ASL::ResultSucceeded(result))
+		{
+			result = ASL::File::SwapTempFile(tempFilePath, inFileFullPath);
+			if (!ASL::ResultSucceeded(result))
+			{
+				ML::SDKErrors::SetSDKErrorString(dvacore::ZString(sWriteFileError, inFileFullPath));
+			}
+		}
+
+		if (!ASL::ResultSucceeded(result))
+		{
+			ASL::File::Delete(tempFilePath);
+		}
 		return result;
 	}	// end of WriteHTMLFile
 
@@ -897,9 +1345,15 @@ namespace
 
 		try
 		{
+			const boost::regex tableStartTag(tableStartTagRegex, boost::regex::icase);
+			const boost::regex tableEndTag(tableEndTagRegex, boost::regex::icase);
+			const boost::regex tableRowTag(tableRowTagRegex, boost::regex::icase);
+			const boost::regex tableHeaderCellTag(tableHeaderCellTagRegex, boost::regex::icase);
+			const boost::regex tableThreadCellTag(tableThreadCellTagRegex, boost::regex::icase);
+
 			while (std::getline(templateFileStream, templateHTMLLineStd))
 			{
-				if (boost::regex_search(templateHTMLLineStd, boost::regex(tableStartTagRegex, boost::regex::icase)))
+				if (boost::regex_search(templateHTMLLineStd, tableStartTag))
 				{
 					tableStartTagFound = true;
 				}
@@ -909,7 +1363,7 @@ namespace
 					templateHTMLTableStd += templateHTMLLineStd;
 				}
 
-				if (boost::regex_search(templateHTMLLineStd, boost::regex(tableEndTagRegex, boost::regex::icase)))
+				if (boost::regex_search(templateHTMLLineStd, tableEndTag))
 				{
 					break;
 				}
@@ -918,15 +1372,15 @@ namespace
 			ASL::StdString tableRow;
 			boost::smatch matchResult;
 
-			while (boost::regex_search(templateHTMLTableStd, matchResult, boost::regex(tableRowTagRegex, boost::regex::icase)))
+			while (boost::regex_search(templateHTMLTableStd, matchResult, tableRowTag))
 			{
 				tableRow = ASL::StdString(matchResult[1].first, matchResult[1].second);
 
-				if (boost::regex_search(tableRow, boost::regex(tableHeaderCellTagRegex, boost::regex::icase)))
+				if (boost::regex_search(tableRow, tableHeaderCellTag))
 				{
 					outTemplateTableElementPtr->SetHeader(tableRow);
 				}	
-				else if(boost::regex_search(tableRow, boost::regex(tableThreadCellTagRegex, boost::regex::icase)))
+				else if(boost::regex_search(tableRow, tableThreadCellTag))
 				{
 					outTemplateTableElementPtr->AddRow(tableRow);
 				}
@@ -940,7 +1394,7 @@ namespace
 			std::ptrdiff_t diff = bad.position();
 		}
 
-		if (outTemplateTableElementPtr->GetHeader() == "" || outTemplateTableElementPtr->GetRowsSize() == 0)
+		if (!outTemplateTableElementPtr->HasHeader() || outTemplateTableElementPtr->GetRowsSize() == 0)
 		{
 			ML::SDKErrors::SetSDKErrorString(dvacore::ZString(sTemplateDamaged, inTemplateFilePath));
 			return ASL::ResultFlags::kResultTypeFailure;
@@ -1015,10 +1469,8 @@ namespace
 		TemplateTableElementPtr inTemplateTableElementPtr)
 	{
 		ASL::Result result = ASL::kSuccess;
-		std::vector<ASL::String> markerListOfHTML;
 		ASL::String fileFullPath = ASL::PathUtils::AddTrailingSlash(inDirFullPath);	
 		fileFullPath +=  inFileName + ASL_STR(".html");
-		ASL::UInt32 RowsCount = 0;
 		ThumbnailImageInfoVec thumbnailImagesInfoVec;
 		ThumbnailManagementInfoPtr thumbnailManagementInfoPtr(new ThumbnailManagementInfo());
 		thumbnailManagementInfoPtr->pendingCount = 0;
@@ -1028,25 +1480,14 @@ namespace
 		if (!ASL::ResultSucceeded(result))
 			return result;
 		
-		const ASL::String tableHeader = ConvertTableHeaderToHTML(inTemplateTableElementPtr);
-		markerListOfHTML.push_back(tableHeader);
-
-		BOOST_FOREACH(PL::ExportMarker::AssetItemMarkersInfoPair assetItem, inAssetItemMarkersInfoPairVec)
-		{	
-			if (assetItem.second.size() == 0) 
-			{
-				result = ConvertBlankAssetInfoToHTML(assetItem, markerListOfHTML, RowsCount, inTemplateTableElementPtr);
-			}
-			else
-			{
-				result = ConvertAssetInfoToHTML(assetItem, markerListOfHTML, imageDirFullPath, thumbnailImagesInfoVec, RowsCount, inTemplateTableElementPtr);
-			}
-
-			if (!ASL::ResultSucceeded(result))
-				return result;
-		}
-
-		result = WriteHTMLFile(markerListOfHTML, fileFullPath, inTemplateFilePath, inProjectName);
+		result = WriteHTMLFile(
+			inAssetItemMarkersInfoPairVec,
+			imageDirFullPath,
+			thumbnailImagesInfoVec,
+			inTemplateTableElementPtr,
+			fileFullPath,
+			inTemplateFilePath,
+			inProjectName);
 
 		if (!ASL::ResultSucceeded(result))
 			return result;
@@ -24,8 +24,11 @@
 #include "ExportUtils.h"
 
 // ASL
+#include "ASLAtomic.h"
+#include "ASLCriticalSection.h"
 #include "ASLPathUtils.h"
 #include "ASLResults.h"
+#include "ASLSleep.h"
 #include "ASLString.h"
 
 // MBC
@@ -36,6 +39,7 @@
 #include "dvacore/utility/StringUtils.h"
 #include "dvacore/utility/NumberString.h"
 #include "dvacore/debug/debug.h"
+#include "dvacore/threads/AsyncThreadedExecutor.h"
 #include "dvacore/utility/UnicodeCaseConversion.h"
 
 // MZ
@@ -47,16 +51,53 @@
 // UIF
 #include "UIFMessageBox.h"
 
+// boost
+#include "boost/bind.hpp"
+
+// STL
+#include <algorithm>
+#include <cstring>
+
 namespace PL
 {
 
 namespace ExportUtils
 {
 
-static const ASL::String kActualMeidaFilePathBeginTag = ASL_STR("<ActualMediaFilePath>");
-static const ASL::String kActualMeidaFilePathEndTag = ASL_STR("</ActualMediaFilePath>");
-static const ASL::String kRelativePathBeginTag = ASL_STR("<RelativePath>");
-static const ASL::String kRelativePathEndTag = ASL_STR("</RelativePath>");
+/*
+** Tags whose content is a media path. <Note> In project file, ActualMediaFilePath and RelativePath
+** are pair. RelativePath always follows ActualMediaFilePath. We also assume mediaFile and the
+** projectFile have the same parent directory, so the new relativePath is computed from the new
+** actual media path and the projectFileContainer.
+*/
+struct MediaPathTag
+{
+	const char*		mBeginTag;
+	std::size_t		mBeginTagLength;
+	const char*		mEndTag;
+	std::size_t		mEndTagLength;
+	bool			mIsRelativePath;
+};
+
+#define MEDIA_PATH_TAG(name, isRelative) { "<" name ">", sizeof(name) + 1, "</" name ">", sizeof(name) + 2, isRelative }
+
+static const MediaPathTag kMediaPathTags[] =
+{
+	MEDIA_PATH_TAG("ActualMediaFilePath", false),
+	MEDIA_PATH_TAG("RelativePath", true),
+	MEDIA_PATH_TAG("FilePath", false),
+	MEDIA_PATH_TAG("ConformedAudioPath", false)
+};
+
+#undef MEDIA_PATH_TAG
+
+static const std::size_t kMediaPathTagCount = sizeof(kMediaPathTags) / sizeof(kMediaPathTags[0]);
+
+// Read and write the project file in pieces of this size.
+static const std::size_t kRewriteBufferSize = 1024 * 1024;
+
+// normalized old media path -> new media path
+typedef std::map<ASL::String, ASL::String> MediaPathLookup;
 
 /*
 ** We cannot use ASL::PathUtils::RemoveTrailingSlash here because for ftp, we use 
@@ -76,167 +117,192 @@ static ASL::String RemoveLastSlash(ASL::String const& inPath)
 }
 
 /*
-** <Note> In project file, ActualMediaFilePath and RelativePath are pair. RelativePath always
-** follows AcautlMeidaFilePath. We also assume meidaFile and the projectFile have the same parent
-** directory. For relativePath, just use the lastesActualMediaFilePath and projectFileContainer 
-** to calculate the relativePath.
+**
 */
-static void ReplaceLineContent(
-	ASL::String &inOutLine,
-	const std::vector<ASL::String> &inXMLTags,
-	const PathPairVector &inMediaPaths,
-	const ASL::String &inProjectFileContainer)
+static ASL::String MakeMediaPathKey(ASL::String const& inPath)
 {
-	//Check the XML flag
-	for (std::vector<ASL::String>::const_iterator it = inXMLTags.begin(); it != inXMLTags.end(); ++it)
-	{	
-		if (inOutLine.find(it->c_str()) == ASL::String::npos)
-			continue;
-
-		if (kRelativePathBeginTag == *it)
-		{
-			int beginIndex = inOutLine.find(kRelativePathBeginTag) + kRelativePathBeginTag.size();
-			int endIndex = inOutLine.find(kRelativePathEndTag);
-
-			ASL_ASSERT(beginIndex != ASL::String::npos);
-			ASL_ASSERT(endIndex != ASL::String::npos);
-
-			// we must compute the correct actual media path based on old relative path,
-			// then get the new actual path from the old actual path
-			ASL::String const& oldRelativePath = inOutLine.substr(beginIndex, endIndex - beginIndex);
-			ASL::String const& oldActualMediaPath = MZ::Utilities::CombinePathsWithoutRelativeInfo(
-								ASL::PathUtils::AddTrailingSlash(inProjectFileContainer), oldRelativePath);
-			ASL::String newActualMediaPath;
-
-			PathPairVector::const_iterator pathIterator;
-			for (pathIterator = inMediaPaths.begin(); pathIterator != inMediaPaths.end(); ++pathIterator)
-			{
 #if ASL_TARGET_OS_WIN
-				if (pathIterator->first.c_str() == oldActualMediaPath)
+	return inPath;
 #else
-					if (MZ::Utilities::AddHeadingSlash(pathIterator->first.c_str()) ==
-						MZ::Utilities::AddHeadingSlash(oldActualMediaPath))
+	return MZ::Utilities::AddHeadingSlash(inPath);
 #endif
-				{
-					newActualMediaPath = pathIterator->second;
-					break;
-				}
-			}
-
-			if (newActualMediaPath.empty())
-			{
-				continue;
-			}
-
-			//ActualMediaFilePath and RelativePath must be pair.
-			//MeidaFile and projectFile must have the same parent directory.
-			ASL_ASSERT(newActualMediaPath.find(inProjectFileContainer) != ASL::String::npos);
-
-			// Calculate the relativePath
-			// If the projectFileContainer is empty(this only happens when exporting to through ftp),
-			// we just add ./ for the relative path
-			ASL::String relativePath = inProjectFileContainer.empty() ? 
-									newActualMediaPath.insert(0,  ASL_STR("./")) :
-									newActualMediaPath.replace(
-										newActualMediaPath.find(inProjectFileContainer),
-										inProjectFileContainer.size(),
-										ASL_STR("."));
-
-			inOutLine.replace(beginIndex, endIndex - beginIndex, relativePath);
-		}
-		else
-		{
-			PathPairVector::const_iterator pathIterator;
-			for (pathIterator = inMediaPaths.begin(); pathIterator != inMediaPaths.end(); ++pathIterator)
-			{
-				int pathIndex = inOutLine.find(pathIterator->first.c_str());
-				if (pathIndex != ASL::String::npos)
-				{
-					inOutLine.replace(pathIndex, pathIterator->first.size(), pathIterator->second);
-					break;
-				}
-			}			
-		}
-	} // end Check XML tag
 }
 
-static void ReplaceContent(const ASL::String &inString,
-	const std::vector<ASL::String> &inXMLTags,
-	const PathPairVector &inMediaPaths,
-	const ASL::String &inProjectFileContainer,
-	ASL::String &outString)
+/*
+** Build the lookup once instead of walking every path pair for every tag.
+*/
+static void BuildMediaPathLookup(
+	const PathPairVector& inMediaPaths,
+	MediaPathLookup& outLookup)
 {
-
-	char delimiter = '\n';
-	int startIndex = 0, endIndex = 0;
-
-	while ((endIndex = inString.find(delimiter, startIndex)) != ASL::String::npos)
+	for (PathPairVector::const_iterator it = inMediaPaths.begin(); it != inMediaPaths.end(); ++it)
 	{
-		ASL::String line = inString.substr(startIndex, endIndex - startIndex + 1);
-		ReplaceLineContent(line, inXMLTags, inMediaPaths, inProjectFileContainer);
-		outString += line;
-		startIndex = endIndex + 1;
+		// The first pair wins, as the old linear search did.
+		outLookup.insert(std::make_pair(MakeMediaPathKey(it->first), it->second));
 	}
+}
 
-	//the LastLine
-	if (startIndex != std::string::npos)
+/*
+** Match one of kMediaPathTags at inCursor, which points to a '<'.
+*/
+static const MediaPathTag* MatchMediaPathTag(const char* inCursor, const char* inEnd)
+{
+	std::size_t available = static_cast<std::size_t>(inEnd - inCursor);
+	for (std::size_t i = 0; i < kMediaPathTagCount; ++i)
 	{
-		ASL::String line = inString.substr(startIndex);
-		ReplaceLineContent(line, inXMLTags, inMediaPaths, inProjectFileContainer);
-		outString += line;
+		const MediaPathTag& tag = kMediaPathTags[i];
+		if (available >= tag.mBeginTagLength && std::memcmp(inCursor, tag.mBeginTag, tag.mBeginTagLength) == 0)
+		{
+			return &tag;
+		}
 	}
+	return NULL;
 }
 
 /*
 **
 */
-void ReplaceMeidaPath(const ASL::String &inProjectFilePath,
-	const ASL::String &inDestProjectDir,
-	const PathPairVector &inMediaPaths)
+static bool FindNewMediaPath(
+	const MediaPathTag& inTag,
+	const ASL::String& inOldContent,
+	const MediaPathLookup& inMediaPaths,
+	const ASL::String& inProjectFileContainer,
+	ASL::String& outNewContent)
 {
-	ASL::String stringFileContent;
+	if (!inTag.mIsRelativePath)
+	{
+		MediaPathLookup::const_iterator found = inMediaPaths.find(MakeMediaPathKey(inOldContent));
+		if (found == inMediaPaths.end())
+		{
+			return false;
+		}
+		outNewContent = found->second;
+		return true;
+	}
 
-	//Get the content of the inFilePath
-	{	
-		ASL::File file;
-		ASL::Result result = ASL::File::Open(inProjectFilePath, ASL::FileAccessFlags::kRead, file);
+	// we must compute the correct actual media path based on old relative path,
+	// then get the new actual path from the old actual path
+	ASL::String const& oldActualMediaPath = MZ::Utilities::CombinePathsWithoutRelativeInfo(
+						ASL::PathUtils::AddTrailingSlash(inProjectFileContainer), inOldContent);
+	MediaPathLookup::const_iterator found = inMediaPaths.find(MakeMediaPathKey(oldActualMediaPath));
+	if (found == inMediaPaths.end() || found->second.empty())
+	{
+		return false;
+	}
 
-		DVA_ASSERT_MSG(ASL::ResultSucceeded(result), "File: " << inProjectFilePath << "unable to open.");
+	ASL::String newActualMediaPath = found->second;
+
+	//ActualMediaFilePath and RelativePath must be pair.
+	//MeidaFile and projectFile must have the same parent directory.
+	ASL_ASSERT(newActualMediaPath.find(inProjectFileContainer) != ASL::String::npos);
+
+	// Calculate the relativePath
+	// If the projectFileContainer is empty(this only happens when exporting to through ftp),
+	// we just add ./ for the relative path
+	outNewContent = inProjectFileContainer.empty() ? 
+							newActualMediaPath.insert(0,  ASL_STR("./")) :
+							newActualMediaPath.replace(
+								newActualMediaPath.find(inProjectFileContainer),
+								inProjectFileContainer.size(),
+								ASL_STR("."));
+	return true;
+}
 
-		std::vector<char> fileContents;
-		ASL::UInt32 bytesRead = 0;
-		std::size_t bytesOnDisk = static_cast<std::size_t>(file.SizeOnDisk());
-		fileContents.resize(bytesOnDisk + 1);
-		void* readIntoBuffer = &(fileContents[0]);
-		result = file.Read(readIntoBuffer, static_cast<ASL::UInt32>(bytesOnDisk), bytesRead);
+/*
+** Rewrite the media path tags of one line in a single scan and append the result to ioOutput.
+** Everything outside a replaced tag content is copied through as UTF-8 bytes.
+*/
+static void RewriteLine(
+	const char* inBegin,
+	const char* inEnd,
+	const MediaPathLookup& inMediaPaths,
+	const ASL::String& inProjectFileContainer,
+	dvacore::UTF8String& ioOutput)
+{
+	const char* copiedUpTo = inBegin;
+	const char* cursor = std::find(inBegin, inEnd, '<');
+	while (cursor != inEnd)
+	{
+		const MediaPathTag* tag = MatchMediaPathTag(cursor, inEnd);
+		if (tag == NULL)
+		{
+			cursor = std::find(cursor + 1, inEnd, '<');
+			continue;
+		}
 
-		// Add zero termination byte
-		fileContents[bytesOnDisk] = 0; 
+		const char* contentBegin = cursor + tag->mBeginTagLength;
+		const char* contentEnd = std::search(contentBegin, inEnd, tag->mEndTag, tag->mEndTag + tag->mEndTagLength);
+		if (contentEnd == inEnd)
+		{
+			cursor = std::find(contentBegin, inEnd, '<');
+			continue;
+		}
 
-		stringFileContent = ASL::MakeString(&fileContents[0]);
+		ASL::String newContent;
+		if (FindNewMediaPath(
+				*tag,
+				dvacore::utility::UTF8to16(dvacore::UTF8String(contentBegin, contentEnd)),
+				inMediaPaths,
+				inProjectFileContainer,
+				newContent))
+		{
+			ioOutput.append(copiedUpTo, contentBegin);
+			ioOutput += dvacore::utility::UTF16to8(newContent);
+			copiedUpTo = contentEnd;
+		}
+		cursor = std::find(contentEnd + tag->mEndTagLength, inEnd, '<');
+	}
+	ioOutput.append(copiedUpTo, inEnd);
+}
 
-		DVA_ASSERT_MSG(ASL::ResultSucceeded(result), "File: " << inProjectFilePath << " unable to read file on disk.");
+/*
+**
+*/
+static ASL::Result FlushRewrittenContent(ASL::File& inFile, dvacore::UTF8String& ioContent)
+{
+	if (ioContent.empty())
+	{
+		return ASL::kSuccess;
 	}
 
-	std::vector<ASL::String> xmlToFindTags;
-	xmlToFindTags.push_back(kActualMeidaFilePathBeginTag);
-	xmlToFindTags.push_back(kRelativePathBeginTag);
-	xmlToFindTags.push_back(ASL_STR("<FilePath>"));
-	xmlToFindTags.push_back(ASL_STR("<ConformedAudioPath>"));
+	ASL::UInt32 numberOfBytesWritten;
+	ASL::Result result = inFile.Write(ioContent.c_str(), static_cast<ASL::UInt32>(ioContent.length()), numberOfBytesWritten);
+	DVA_ASSERT_MSG(ASL::ResultSucceeded(result), "unable to write rewritten project file.");
+	ioContent.clear();
+	return result;
+}
 
-	ASL::String newStringFileContent;
-	
-	ASL::String projectFileContainer = RemoveLastSlash(inDestProjectDir);
+/*
+** Streams the project file through a temp file line by line, so memory stays bounded by
+** kRewriteBufferSize plus the longest line, and each tag content costs one map lookup.
+** The project file is only replaced once the whole file was rewritten.
+*/
+ASL::Result ReplaceMeidaPath(const ASL::String &inProjectFilePath,
+	const ASL::String &inDestProjectDir,
+	const PathPairVector &inMediaPaths)
+{
+	MediaPathLookup mediaPathLookup;
+	BuildMediaPathLookup(inMediaPaths, mediaPathLookup);
 
-	ReplaceContent(stringFileContent, xmlToFindTags, inMediaPaths, projectFileContainer, newStringFileContent);
+	ASL::String projectFileContainer = RemoveLastSlash(inDestProjectDir);
 
-	//Write newStringFileContent into an temp File
+	//Write the new content into an temp File
 	ASL::String tmpName = ASL::PathUtils::AddTrailingSlash(ASL::PathUtils::GetTempDirectory()) + ASL_STR("tmp.file");
 	ASL::String uniqueTmpFileName = ASL::PathUtils::MakeUniqueFilename(tmpName);
 
-	{	
+	ASL::Result result = ASL::kSuccess;
+	{
+		ASL::File file;
+		result = ASL::File::Open(inProjectFilePath, ASL::FileAccessFlags::kRead, file);
+
+		DVA_ASSERT_MSG(ASL::ResultSucceeded(result), "File: " << inProjectFilePath << "unable to open.");
+		if (ASL::ResultFailed(result))
+		{
+			return result;
+		}
+
 		ASL::File tmpFile;
-		ASL::Result result = tmpFile.Create(
+		result = tmpFile.Create(
 			uniqueTmpFileName,
 			ASL::FileAccessFlags::kWrite,
 			ASL::FileShareModeFlags::kNone,
@@ -244,15 +310,74 @@ void ReplaceMeidaPath(const ASL::String &inProjectFilePath,
 			ASL::FileAttributesFlags::kFlagSequentialScan);
 
 		DVA_ASSERT_MSG(ASL::ResultSucceeded(result), "File: " << uniqueTmpFileName << "unable to create.");
+		if (ASL::ResultFailed(result))
+		{
+			return result;
+		}
+
+		std::vector<char> readBuffer(kRewriteBufferSize);
+		std::string pendingLine;
+		dvacore::UTF8String output;
+		output.reserve(kRewriteBufferSize);
+
+		ASL::UInt32 bytesRead = 0;
+		for (;;)
+		{
+			result = file.Read(&readBuffer[0], static_cast<ASL::UInt32>(readBuffer.size()), bytesRead);
+			DVA_ASSERT_MSG(ASL::ResultSucceeded(result), "File: " << inProjectFilePath << " unable to read file on disk.");
+			if (ASL::ResultFailed(result) || bytesRead == 0)
+			{
+				break;
+			}
 
-		dvacore::UTF8String string8 = dvacore::utility::UTF16to8(newStringFileContent);
-		ASL::UInt32 numberOfBytesWritten;
+			const char* chunkBegin = &readBuffer[0];
+			const char* chunkEnd = chunkBegin + bytesRead;
+			const char* lineBegin = chunkBegin;
+			const char* lineEnd;
+			while ((lineEnd = std::find(lineBegin, chunkEnd, '\n')) != chunkEnd)
+			{
+				++lineEnd;
+				if (pendingLine.empty())
+				{
+					RewriteLine(lineBegin, lineEnd, mediaPathLookup, projectFileContainer, output);
+				}
+				else
+				{
+					// Line started in the previous chunk.
+					pendingLine.append(lineBegin, lineEnd);
+					RewriteLine(pendingLine.data(), pendingLine.data() + pendingLine.size(), mediaPathLookup, projectFileContainer, output);
+					pendingLine.clear();
+				}
+				lineBegin = lineEnd;
+			}
+			pendingLine.append(lineBegin, chunkEnd);
 
-		result = tmpFile.Write(string8.c_str(),
-			string8.length(),
-			numberOfBytesWritten);
+			if (output.size() >= kRewriteBufferSize)
+			{
+				result = FlushRewrittenContent(tmpFile, output);
+				if (ASL::ResultFailed(result))
+				{
+					break;
+				}
+			}
+		}
 
-		DVA_ASSERT_MSG(ASL::ResultSucceeded(result), "File: " << uniqueTmpFileName << " unable to write file.");
+		if (ASL::ResultSucceeded(result))
+		{
+			//the LastLine
+			if (!pendingLine.empty())
+			{
+				RewriteLine(pendingLine.data(), pendingLine.data() + pendingLine.size(), mediaPathLookup, projectFileContainer, output);
+			}
+			result = FlushRewrittenContent(tmpFile, output);
+		}
+	}
+
+	// Never swap a truncated rewrite in for the project file.
+	if (ASL::ResultFailed(result))
+	{
+		ASL::File::Delete(uniqueTmpFileName);
+		return result;
 	}
 
 // If dest file exists, ASL::Copy will fail on mac and ASL::Move will fail on win
@@ -262,6 +387,7 @@ void ReplaceMeidaPath(const ASL::String &inProjectFilePath,
 #else
 	ASL::File::SwapTempFile(uniqueTmpFileName, inProjectFilePath);
 #endif
+	return ASL::kSuccess;
 }
 
 /*
@@ -358,6 +484,169 @@ ASL::Result CopyWithProgress(
 	return ASL::kSuccess;
 }
 
+/*
+** State shared by the transfer workers and the thread polling them. Job indices, byte counts and
+** the failing job are guarded by mLock; mCancel is read without it so running jobs can stop early.
+*/
+struct TransferJobQueue
+{
+	TransferJobQueue(
+		std::vector<ASL::UInt64> const& inJobSizes,
+		TransferJobFunction const& inTransferJob)
+		:
+		mJobSizes(inJobSizes),
+		mTransferJob(inTransferJob),
+		mNextJob(0),
+		mActiveWorkers(0),
+		mTransferredBytes(0),
+		mFailedJob(inJobSizes.size()),
+		mFailedResult(ASL::kSuccess),
+		mCancel(0)
+	{
+	}
+
+	bool AddTransferredBytes(ASL::UInt64 inBytes)
+	{
+		ASL::CriticalSectionLock lock(mLock);
+		mTransferredBytes += inBytes;
+		return IsCanceled();
+	}
+
+	bool IsCanceled() const
+	{
+		return ASL::AtomicRead(mCancel) != 0;
+	}
+
+	std::vector<ASL::UInt64> const&	mJobSizes;
+	TransferJobFunction const&		mTransferJob;
+	ASL::CriticalSection			mLock;
+	size_t							mNextJob;
+	size_t							mActiveWorkers;
+	ASL::UInt64						mTransferredBytes;
+	size_t							mFailedJob;
+	ASL::Result						mFailedResult;
+	volatile ASL::AtomicInt			mCancel;
+};
+
+/*
+** Worker body. Each worker keeps pulling the next unclaimed job until the list is drained or the
+** transfer is canceled.
+*/
+static void RunTransferWorker(TransferJobQueue* ioQueue, size_t inWorkerIndex)
+{
+	for (;;)
+	{
+		size_t jobIndex = 0;
+		{
+			ASL::CriticalSectionLock lock(ioQueue->mLock);
+			if (ioQueue->mNextJob >= ioQueue->mJobSizes.size() || ioQueue->IsCanceled())
+			{
+				--ioQueue->mActiveWorkers;
+				return;
+			}
+			jobIndex = ioQueue->mNextJob++;
+		}
+
+		ASL::UInt64 const jobSize = ioQueue->mJobSizes[jobIndex];
+		ExportProgressData progressData;
+		progressData.UpdateProgress = boost::bind(&TransferJobQueue::AddTransferredBytes, ioQueue, _1);
+		progressData.totalProgress = jobSize;
+		progressData.currentProgress = 0;
+
+		ASL::Result const result = ioQueue->mTransferJob(inWorkerIndex, jobIndex, progressData);
+		if (ASL::ResultFailed(result))
+		{
+			// Only the failure that stops the transfer is reported, the jobs failing after it were
+			// most likely stopped by it.
+			if (ASL::AtomicCompareAndSet(ioQueue->mCancel, 0, 1))
+			{
+				ASL::CriticalSectionLock lock(ioQueue->mLock);
+				ioQueue->mFailedJob = jobIndex;
+				ioQueue->mFailedResult = result;
+			}
+		}
+		else if (progressData.currentProgress < jobSize)
+		{
+			// Progress is reported in rounded steps, top the job up so the aggregate reaches 100%.
+			ioQueue->AddTransferredBytes(jobSize - progressData.currentProgress);
+		}
+	}
+}
+
+/*
+**
+*/
+ASL::Result ExecuteTransferJobs(
+	ASL::StdString const& inExecutorName,
+	size_t inWorkerCount,
+	std::vector<ASL::UInt64> const& inJobSizes,
+	TransferJobFunction const& inTransferJob,
+	boost::function<bool (ASL::UInt64)> const& inUpdateProgressFn,
+	size_t& outFailedJob)
+{
+	outFailedJob = inJobSizes.size();
+
+	size_t const workerCount = std::min(inWorkerCount, inJobSizes.size());
+	if (workerCount == 0)
+	{
+		return ASL::kSuccess;
+	}
+
+	ASL::UInt64 totalBytes = 0;
+	for (std::vector<ASL::UInt64>::const_iterator jobSize = inJobSizes.begin(); jobSize != inJobSizes.end(); ++jobSize)
+	{
+		totalBytes += *jobSize;
+	}
+	totalBytes = std::max<ASL::UInt64>(totalBytes, 1);
+
+	TransferJobQueue queue(inJobSizes, inTransferJob);
+	queue.mActiveWorkers = workerCount;
+
+	dvacore::threads::AsyncThreadedExecutorPtr executor = 
+		dvacore::threads::CreateAsyncThreadedExecutor(inExecutorName, static_cast<int>(workerCount));
+	for (size_t i = 0; i < workerCount; ++i)
+	{
+		executor->CallAsynchronously(boost::bind(&RunTransferWorker, &queue, i));
+	}
+
+	// Workers never touch the progress stack; this thread forwards the aggregate byte count, which
+	// is also where user cancellation is picked up and handed to the workers.
+	ASL::UInt64 reportedSteps = 0;
+	bool workersRunning = true;
+	while (workersRunning)
+	{
+		ASL::Sleep(10);
+
+		ASL::UInt64 transferredBytes = 0;
+		{
+			ASL::CriticalSectionLock lock(queue.mLock);
+			transferredBytes = queue.mTransferredBytes;
+			workersRunning = queue.mActiveWorkers > 0;
+		}
+
+		ASL::UInt64 const steps = std::min<ASL::UInt64>(transferredBytes * kTransferProgressSteps / totalBytes, kTransferProgressSteps);
+		if (inUpdateProgressFn && inUpdateProgressFn(steps - reportedSteps))
+		{
+			ASL::AtomicCompareAndSet(queue.mCancel, 0, 1);
+		}
+		reportedSteps = steps;
+	}
+
+	executor->Terminate();
+	executor->Flush();
+
+	if (!queue.IsCanceled())
+	{
+		return ASL::kSuccess;
+	}
+	if (ASL::ResultFailed(queue.mFailedResult))
+	{
+		outFailedJob = queue.mFailedJob;
+		return queue.mFailedResult;
+	}
+	return ASL::eUserCanceled;
+}
+
 /*
 **
 */
@@ -63,12 +63,18 @@
 // UIF
 #include "UIFMessageBox.h"
 
+// boost
+#include "boost/foreach.hpp"
+
 namespace PL
 {
 
 
 namespace
 {
+	// Upper bound on concurrent FTP sessions used for uploading media.
+	const size_t kMaxUploadConnections = 4;
+
 	ASL::StdString NormalizeServerName(ASL::String const& inServer)
 	{
 		return (inServer.substr(0, 6) != ASL_STR("ftp://"))
@@ -246,12 +252,21 @@ namespace
 			mActionResultList = inActionResultList;
 		}
 
-		void CheckFilesOnDestPath(ASL::String& outExistFiles) const;
+		std::set<ASL::String> CheckFilesOnDestPath(ASL::String& outExistFiles) const;
 
 		virtual ASL::Result PrecheckExportFiles() const
+		{
+			std::set<ASL::String> existingRemoteFiles;
+			return PrecheckExportFiles(existingRemoteFiles);
+		}
+
+		/*
+		**	Same as above, also returning the remote media files the user agreed to overwrite.
+		*/
+		ASL::Result PrecheckExportFiles(std::set<ASL::String>& outExistingRemoteFiles) const
 		{
 			ASL::String existFiles;
-			CheckFilesOnDestPath(existFiles);
+			outExistingRemoteFiles = CheckFilesOnDestPath(existFiles);
 
 			if (!existFiles.empty())
 			{
@@ -271,9 +286,32 @@ namespace
 
 		void OnConvertToFinalProject();
 
-		ASL::Result ExportMediaFiles();
+		ASL::Result ExportMediaFiles(std::set<ASL::String> const& inExistingRemoteFiles);
+
+		bool EnsureRemoteDir(ASL::String const& inRemoteDir);
+		bool PlanUploadJobs(std::set<ASL::String> const& inExistingRemoteFiles, PL::ExportUtils::PathPairVector& outPathPairs);
+		ASL::Result ExecuteUploadJobs(size_t& outFailedJob);
+		ASL::Result UploadPlannedFile(
+			std::vector<FTPUtils::FTPConnectionDataPtr> const& inConnections,
+			size_t inWorkerIndex,
+			size_t inJobIndex,
+			PL::ExportUtils::ExportProgressData& ioProgressData);
 
 	private:
+		/*
+		**	One planned file upload.
+		*/
+		struct UploadJob
+		{
+			UploadJob() : mSize(0) {}
+
+			ASL::String		mSourcePath;
+			ASL::String		mDestinationPath;
+			ASL::String		mRemoteDestinationFile;
+			ASL::UInt64		mSize;
+		};
+		typedef std::vector<UploadJob> UploadJobList;
+
 		ASL::String							mTitleString;
 		ASL::Result							mResult;
 		ASL::StationID						mStationID;
@@ -298,6 +336,12 @@ namespace
 		PL::ExportUtils::MeidaPathToExportItemMap mMediaPathToExportItems;
 
 		FTPUtils::FTPConnectionDataPtr		mFTPConnection;
+
+		// Remote directories known to exist, to avoid asking the server twice.
+		std::set<ASL::String>				mKnownRemoteDirs;
+
+		UploadJobList						mUploadJobs;
+		std::vector<ASL::String>			mPlannedMediaPaths;
 	};
 
 }
@@ -374,7 +418,8 @@ void FTPExportLibraryItemsOperation::Process()
 			break;
 		}
 
-		mResult = PrecheckExportFiles();
+		std::set<ASL::String> existingRemoteFiles;
+		mResult = PrecheckExportFiles(existingRemoteFiles);
 		if (!ASL::ResultSucceeded(mResult))
 		{
 			break;
@@ -382,7 +427,7 @@ void FTPExportLibraryItemsOperation::Process()
 
 		descriptionMsg = dvacore::config::Localizer::Get()->GetLocalizedString("$$$/Prelude/Mezzanine/FTPExportingTitle=Export");
 		ASL::StationUtils::PostMessageToUIThread(mStationID, ASL::UpdateOperationDescriptionMessage(descriptionMsg), true);
-		mResult = ExportMediaFiles();
+		mResult = ExportMediaFiles(existingRemoteFiles);
 
 		if (GetAbort())
 		{
@@ -418,9 +463,14 @@ void FTPExportLibraryItemsOperation::Process()
 	FTPUtils::CloseFTPConncection(mFTPConnection);
 }
 
-void FTPExportLibraryItemsOperation::CheckFilesOnDestPath(ASL::String& outExistFiles) const
+/*
+**	Collect the message listing what the export would overwrite, and return the remote media files
+**	that already exist so the upload plan can warn about them without asking the server again.
+*/
+std::set<ASL::String> FTPExportLibraryItemsOperation::CheckFilesOnDestPath(ASL::String& outExistFiles) const
 {
 	outExistFiles.clear();
+	std::set<ASL::String> existingRemoteFiles;
 
 	// Check project file
 	ASL::String	tmpProjFile = BuildProjectPath(mDestinationFolder, mProjectFile);
@@ -460,6 +510,7 @@ void FTPExportLibraryItemsOperation::CheckFilesOnDestPath(ASL::String& outExistF
 			{
 				if (FTPUtils::FTPExistOnDisk(mFTPConnection, destPath, false))
 				{
+					existingRemoteFiles.insert(destPath);
 					if (++warningMsgCount <= PL::ExportUtils::nMaxWarningMessageNum)
 					{
 						outExistFiles += ASL_STR("\n") + mFTPSettingsDataPtr->GetServerName() + ASL_STR("/") + destPath;
@@ -476,16 +527,45 @@ void FTPExportLibraryItemsOperation::CheckFilesOnDestPath(ASL::String& outExistF
 
 		outExistFiles += message;
 	}
+	return existingRemoteFiles;
 }
 
-ASL::Result FTPExportLibraryItemsOperation::ExportMediaFiles()
+/*
+**	Make sure a remote directory exists, talking to the server at most once per directory for
+**	the whole export.
+*/
+bool FTPExportLibraryItemsOperation::EnsureRemoteDir(ASL::String const& inRemoteDir)
 {
-	PL::ExportUtils::PathPairVector pathPairs;
+	// Callers build directories both with and without a trailing separator, so the cache is
+	// keyed on a single spelling with exactly one trailing forward slash.
+	ASL::String remoteDirKey(inRemoteDir);
+	remoteDirKey.erase(remoteDirKey.find_last_not_of(ASL_STR("/\\")) + 1);
+	remoteDirKey += ASL_STR("/");
+
+	if (mKnownRemoteDirs.find(remoteDirKey) != mKnownRemoteDirs.end())
+	{
+		return true;
+	}
+
+	bool success = FTPUtils::FTPExistOnDisk(mFTPConnection, inRemoteDir, true) || 
+					FTPUtils::FTPMakeDir(mFTPConnection, inRemoteDir);
+	if (success)
+	{
+		mKnownRemoteDirs.insert(remoteDirKey);
+	}
+	return success;
+}
 
+/*
+**	Turn every media item into upload jobs. All remote directories are created here, ahead of
+**	the uploads, and overwrite warnings come from what CheckFilesOnDestPath already found.
+*/
+bool FTPExportLibraryItemsOperation::PlanUploadJobs(
+	std::set<ASL::String> const& inExistingRemoteFiles,
+	PL::ExportUtils::PathPairVector& outPathPairs)
+{
 	ASL::String const& remoteDir =  mDestinationFolder +  ASL_STR("media");
-	ASL::String const& remoteRoot = mFTPSettingsDataPtr->GetServerName() + ASL_STR("/");
-	
-	// Export every media
+
 	for (PL::ExportUtils::MeidaPathToExportItemMap::iterator iter = mMediaPathToExportItems.begin();
 		iter != mMediaPathToExportItems.end();
 		++iter)
@@ -511,7 +591,7 @@ ASL::Result FTPExportLibraryItemsOperation::ExportMediaFiles()
 			continue;
 		}
 
-		StartProgress(1, exportFilePaths.size());
+		mPlannedMediaPaths.push_back(mediaPath);
 
 		for (ASL::PathnameList::const_iterator bf = exportFilePaths.begin(), bl = exportFilePaths.end(); bf != bl; ++bf)
 		{
@@ -524,72 +604,150 @@ ASL::Result FTPExportLibraryItemsOperation::ExportMediaFiles()
 			if (itemPath.empty())
 				continue;
 
-			PL::ExportUtils::ExportProgressData progressData;
-			progressData.UpdateProgress = boost::bind(&FTPExportLibraryItemsOperation::UpdateProgress, this, _1);
-			progressData.totalProgress = 100;
-			progressData.currentProgress = 0;
-			StartProgress(1, progressData.totalProgress);
-
 			ASL::String destPath = BuildUnqiueDestinationPathForFTP(itemPath, remoteDir, exportItem);
 			
-			bool success = true;
 			if (ASL::PathUtils::IsDirectory(itemPath))
 			{
-				ASL::String const& remoteDestDir = destPath;
-				bool exist = FTPUtils::FTPExistOnDisk(mFTPConnection, remoteDestDir, true);
-				if (!exist)
+				if (!EnsureRemoteDir(destPath))
 				{
-					success = FTPUtils::FTPMakeDir(mFTPConnection, remoteDestDir);
-					if (!success)
-					{
-						ASL::String message = dvacore::ZString("$$$/Prelude/Mezzanine/ExportFTP/Failure/CanNotMakeDir=Cannot make remote directory \"@0\".");
-						message = dvacore::utility::ReplaceInString(message, remoteDestDir);
-						mExportErrors.push_back(message);
-					}
+					ASL::String message = dvacore::ZString("$$$/Prelude/Mezzanine/ExportFTP/Failure/CanNotMakeDir=Cannot make remote directory \"@0\".");
+					message = dvacore::utility::ReplaceInString(message, destPath);
+					mExportErrors.push_back(message);
+					return false;
 				}
+				continue;
 			}
-			else
-			{
-				if (itemPath == *bf)
-				{
-					pathPairs.push_back(PL::ExportUtils::PathPair(*bf, destPath));
-				}
-
-				ASL::String remoteDestFile = mFTPSettingsDataPtr->GetServerName() + ASL_STR("/") + destPath;
 
-				if (FTPUtils::FTPExistOnDisk(mFTPConnection, destPath, false))
-				{								
-					ASL::String message = dvacore::ZString("$$$/Prelude/Mezzanine/ExportFTP/Warning/CopyOverwrite=Overwrite \"@0\" from \"@1\".");
-					message = dvacore::utility::ReplaceInString(message, remoteDestFile, itemPath);
-					mExportWarnings.push_back(message);				
-				}
-
-				success = FTPUtils::FTPUpload(mFTPConnection, destPath, itemPath, &progressData);
-				if (!success)
-				{
-					ASL::String message = dvacore::ZString("$$$/Prelude/Mezzanine/ExportFTP/Failure/CanNotUploadFile=Cannot upload file \"@0\" to \"@1\".");
-					message = dvacore::utility::ReplaceInString(message, itemPath, remoteDestFile);
-					mExportErrors.push_back(message);
-				}
+			if (itemPath == *bf)
+			{
+				outPathPairs.push_back(PL::ExportUtils::PathPair(*bf, destPath));
 			}
 
-			EndProgress();
+			ASL::String remoteDestFile = mFTPSettingsDataPtr->GetServerName() + ASL_STR("/") + destPath;
 
-			if (UpdateProgress(0))
-			{
-				return ASL::eUserCanceled;
+			if (inExistingRemoteFiles.find(destPath) != inExistingRemoteFiles.end())
+			{								
+				ASL::String message = dvacore::ZString("$$$/Prelude/Mezzanine/ExportFTP/Warning/CopyOverwrite=Overwrite \"@0\" from \"@1\".");
+				message = dvacore::utility::ReplaceInString(message, remoteDestFile, itemPath);
+				mExportWarnings.push_back(message);				
 			}
 
-			if (!success)
+			// Upload itself would create a missing parent, but doing it here keeps every
+			// directory round trip on this one connection and out of the parallel uploads.
+			ASL::String const& destDir = MZ::Utilities::AddTrailingForwardSlash(ASL::PathUtils::GetDirectoryPart(destPath));
+			if (!EnsureRemoteDir(destDir))
 			{
-				return ASL::eAccessIsDenied;
+				ASL::String message = dvacore::ZString("$$$/Prelude/Mezzanine/ExportFTP/Failure/CanNotMakeDir=Cannot make remote directory \"@0\".");
+				message = dvacore::utility::ReplaceInString(message, destDir);
+				mExportErrors.push_back(message);
+				return false;
 			}
+
+			UploadJob job;
+			job.mSourcePath = itemPath;
+			job.mDestinationPath = destPath;
+			job.mRemoteDestinationFile = remoteDestFile;
+			ASL::File::SizeOnDisk(itemPath, job.mSize);
+			mUploadJobs.push_back(job);
+		}
+	}
+
+	return true;
+}
+
+/*
+**	Upload one planned file over the session owned by the worker running it.
+*/
+ASL::Result FTPExportLibraryItemsOperation::UploadPlannedFile(
+	std::vector<FTPUtils::FTPConnectionDataPtr> const& inConnections,
+	size_t inWorkerIndex,
+	size_t inJobIndex,
+	PL::ExportUtils::ExportProgressData& ioProgressData)
+{
+	UploadJob const& job = mUploadJobs[inJobIndex];
+	return FTPUtils::FTPUpload(inConnections[inWorkerIndex], job.mDestinationPath, job.mSourcePath, &ioProgressData)
+		? ASL::kSuccess
+		: ASL::eAccessIsDenied;
+}
+
+/*
+**	Run the planned uploads over a small pool of FTP sessions, one worker per session. The export's
+**	own connection is always part of the pool; extra sessions are opened until the server refuses one.
+*/
+ASL::Result FTPExportLibraryItemsOperation::ExecuteUploadJobs(size_t& outFailedJob)
+{
+	outFailedJob = mUploadJobs.size();
+	if (mPlannedMediaPaths.empty())
+	{
+		return ASL::kSuccess;
+	}
+
+	StartProgress(mPlannedMediaPaths.size(), PL::ExportUtils::kTransferProgressSteps);
+
+	std::vector<FTPUtils::FTPConnectionDataPtr> connections;
+	connections.push_back(mFTPConnection);
+	size_t const wantedConnections = std::min(mUploadJobs.size(), kMaxUploadConnections);
+	while (connections.size() < wantedConnections)
+	{
+		FTPUtils::FTPConnectionDataPtr connection;
+		if (!FTPInternalUtils::CreateFTPConnection(connection, mFTPSettingsDataPtr))
+		{
+			break;
 		}
+		connections.push_back(connection);
+	}
 
-		// The clip is exported.
-		EndProgress();
+	std::vector<ASL::UInt64> jobSizes;
+	jobSizes.reserve(mUploadJobs.size());
+	for (UploadJobList::const_iterator job = mUploadJobs.begin(); job != mUploadJobs.end(); ++job)
+	{
+		jobSizes.push_back(job->mSize);
+	}
+
+	ASL::Result result = PL::ExportUtils::ExecuteTransferJobs(
+		"FTP Export Upload",
+		connections.size(),
+		jobSizes,
+		boost::bind(&FTPExportLibraryItemsOperation::UploadPlannedFile, this, boost::cref(connections), _1, _2, _3),
+		boost::bind(&FTPExportLibraryItemsOperation::UpdateProgress, this, _1),
+		outFailedJob);
 
-		// Todo: not affect to Roughcut for mediaPath of Roughcut is changed to its media path.
+	// The export's own connection is still needed for the project file.
+	for (size_t i = 1; i < connections.size(); ++i)
+	{
+		FTPUtils::CloseFTPConncection(connections[i]);
+	}
+
+	EndProgress();
+	return result;
+}
+
+ASL::Result FTPExportLibraryItemsOperation::ExportMediaFiles(std::set<ASL::String> const& inExistingRemoteFiles)
+{
+	PL::ExportUtils::PathPairVector pathPairs;
+
+	if (!PlanUploadJobs(inExistingRemoteFiles, pathPairs))
+	{
+		return ASL::eAccessIsDenied;
+	}
+
+	size_t failedJob = 0;
+	ASL::Result uploadResult = ExecuteUploadJobs(failedJob);
+	if (ASL::ResultFailed(uploadResult))
+	{
+		if (failedJob < mUploadJobs.size())
+		{
+			UploadJob const& job = mUploadJobs[failedJob];
+			ASL::String message = dvacore::ZString("$$$/Prelude/Mezzanine/ExportFTP/Failure/CanNotUploadFile=Cannot upload file \"@0\" to \"@1\".");
+			message = dvacore::utility::ReplaceInString(message, job.mSourcePath, job.mRemoteDestinationFile);
+			mExportErrors.push_back(message);
+		}
+		return uploadResult;
+	}
+
+	// Todo: not affect to Roughcut for mediaPath of Roughcut is changed to its media path.
+	BOOST_FOREACH (ASL::String const& mediaPath, mPlannedMediaPaths)
+	{
 		for (ActionResultList::iterator resultit=mActionResultList.begin(); resultit!=mActionResultList.end(); ++resultit)
 		{
 			if ((*resultit)->mFilePath == mediaPath)
@@ -600,7 +758,14 @@ ASL::Result FTPExportLibraryItemsOperation::ExportMediaFiles()
 	//Modify the paths of media in project file
 	if (!mProjectFile.empty() && pathPairs.size() > 0)
 	{
-		PL::ExportUtils::ReplaceMeidaPath(mSeedPremiereProjectFile, mDestinationFolder, pathPairs);
+		ASL::Result result = PL::ExportUtils::ReplaceMeidaPath(mSeedPremiereProjectFile, mDestinationFolder, pathPairs);
+		if (ASL::ResultFailed(result))
+		{
+			ASL::String message = dvacore::ZString("$$$/Prelude/Mezzanine/ExportFTP/Failure/CanNotUpdateProject=Cannot update media paths in project file \"@0\".");
+			message = dvacore::utility::ReplaceInString(message, mProjectFile);
+			mExportErrors.push_back(message);
+			return result;
+		}
 	}
 
 	// Todo: now just change to success.
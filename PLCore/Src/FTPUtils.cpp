@@ -77,6 +77,10 @@ namespace PL
 		}
 
 #if ASL_TARGET_OS_WIN
+		// WinINet data connections keep up much better with large writes, so the upload loop
+		// reads the local file in 1 MB chunks instead of going through kMyBufferSize.
+		const ASL::UInt32 kUploadBufferSize = 1024 * 1024;
+
 		static bool ValidFTPConnection(const FTPConnectionDataPtr& inFTPConnection)
 		{
 			return (inFTPConnection && inFTPConnection->hInternet && inFTPConnection->hSession);
@@ -199,7 +203,7 @@ namespace PL
 			char* pBuf = NULL;
 			try
 			{
-				pBuf = new char[kMyBufferSize];
+				pBuf = new char[kUploadBufferSize];
 			}
 			catch(...)
 			{
@@ -215,7 +219,7 @@ namespace PL
 			ASL::UInt64 totalBytesWritten = 0;
 			do 
 			{
-				if (ReadFile(hLocal, pBuf, kMyBufferSize, &dwRead, NULL))
+				if (ReadFile(hLocal, pBuf, kUploadBufferSize, &dwRead, NULL))
 				{
 					DWORD dwWritten = 0;
 
@@ -230,7 +234,8 @@ namespace PL
 							{
 								if (inProgressData->UpdateProgress(0))
 								{
-									break;
+									// Canceled, the remote file is incomplete.
+									success = false;
 								}
 							}
 						}
@@ -244,12 +249,18 @@ namespace PL
 				{
 					success = false;
 				}
-			} while ( (dwRead == kMyBufferSize) && success );
+			} while ( (dwRead == kUploadBufferSize) && success );
 
 			delete [] pBuf;
 			InternetCloseHandle(hFTPFile);
 			CloseHandle(hLocal);
 
+			if (!success)
+			{
+				// Don't leave a truncated file behind that looks like a finished upload.
+				FtpDeleteFileA(inFTPConnection->hSession, (LPCSTR)inUTF8OutName.c_str());
+			}
+
 			return success;
 		}
 
@@ -1018,7 +1029,8 @@ namespace PL
                                     ASL_TRACE("MyUploadCallback",5,"User canceled");
 									if (pResult)
 									{
-										*pResult = true;
+										// The remote file is incomplete, so the upload did not succeed.
+										*pResult = false;
 									}
 									MyCleanupStreamInfo(info);
 									CFRunLoopStop(CFRunLoopGetCurrent());
@@ -1452,11 +1464,17 @@ namespace PL
 			
 			ASL::UInt64 fileSize;
 			ASL::File::SizeOnDisk(inSourcePath, fileSize);
+			dvacore::UTF8String const& utf8FileName = dvacore::utility::UTF16to8(ASL::PathUtils::GetFullFilePart(inDestPath));
 			result = FTPUploadInternal(inFTPConnection, 
-									   utf8FTPPath + dvacore::utility::UTF16to8(ASL::PathUtils::GetFullFilePart(inDestPath)), 
+									   utf8FTPPath + utf8FileName, 
 									   dvacore::utility::UTF16to8(inSourcePath),
 									   (ExportUtils::ExportProgressData*)inProgressData,
 									   fileSize);
+			if (!result && inProgressData != NULL)
+			{
+				// Don't leave a truncated file behind that looks like a finished upload.
+				FTPDeleteInternal(inFTPConnection, utf8FTPPath, utf8FileName);
+			}
 			
 			return result;
 		}
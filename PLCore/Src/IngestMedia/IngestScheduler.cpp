@@ -46,6 +46,7 @@
 #include "ASLCoercion.h"
 #include "ASLStringCompare.h"
 #include "ASLAsyncCallFromMainThread.h"
+#include "ASLCriticalSection.h"
 
 // DVA
 #include "dvacore/debug/Debug.h"
@@ -60,11 +61,38 @@ namespace PL
 {
 namespace IngestTask
 {
+	/*
+	**	Custom presets and saved preset files shared by the transcode tasks of one run, so that
+	**	clips with the same source format don't each build and write their own preset.
+	*/
+	struct TranscodePresetCache
+	{
+		struct CustomPresetRecord
+		{
+			EncoderHost::IEncoderFactory::IExporterModuleRef	mExportModule;
+			PL::Utilities::MediaFormatSignature		mSignature;
+			EncoderHost::IPresetRef					mPreset;
+		};
+
+		struct PresetFileRecord
+		{
+			EncoderHost::IPresetRef					mPreset;
+			ASL::String								mPresetFile;
+		};
+
+		std::vector<CustomPresetRecord>				mCustomPresets;
+		std::vector<PresetFileRecord>				mPresetFiles;
+	};
+
 	namespace
 	{
 		ASL::Guid sJobID("A289E6A8-D0E8-45A5-A545-5C6C2F1F1855");
 		const ASL::String kCopyExecutorName = ASL_STR("IngestCopyExecutor");
 		const ASL::String kUpdateMetadataExecutorName = ASL_STR("IngestUpdateMetadataExecutor");
+		// Metadata updates of different tasks touch different files, so their renames can run
+		// at once. XMP reads and writes still go one file at a time, see sXMPUpdateCriticalSection.
+		const std::size_t kMaxUpdateMetadataWorkers = 4;
+		ASL::CriticalSection sXMPUpdateCriticalSection;
 		const ASL::String kSingleFileFormat = ASL_STR("Single");
 
 		dvacore::threads::AsyncThreadedExecutorPtr CreateOrGetCopyExecutor()
@@ -81,7 +109,9 @@ namespace IngestTask
 		dvacore::threads::AsyncThreadedExecutorPtr CreateOrGetUpdateMetadataExecutor()
 		{
 			dvacore::threads::AsyncThreadedExecutorPtr existInstance = PL::threads::GetExecutor(kUpdateMetadataExecutorName);
-			return existInstance != NULL ? existInstance : PL::threads::CreateAndRegisterExecutor(kUpdateMetadataExecutorName);
+			return existInstance != NULL ? existInstance : PL::threads::CreateAndRegisterExecutor(
+																kUpdateMetadataExecutorName,
+																static_cast<int>(kMaxUpdateMetadataWorkers));
 		}
 
 		void ReleaseUpdateMetadataExecutor()
@@ -89,22 +119,6 @@ namespace IngestTask
 			PL::threads::UnregisterExecutor(kUpdateMetadataExecutorName);
 		}
 
-		template <typename T>
-		bool IncludeRunningTask(T& t)
-		{
-			typename T::iterator itr = t.begin();
-			typename T::iterator end = t.end();
-			for (; itr != end; ++itr)
-			{
-				if ( (*itr)->GetTaskState() == kTaskState_Running )
-				{
-					return true;
-				}
-			}
-
-			return false;
-		}
-
 		template <typename T>
 		void PauseTask(T& t)
 		{
@@ -129,6 +143,7 @@ namespace IngestTask
 				if ( (*itr)->GetTaskState() == kTaskState_Paused )
 				{
 					(*itr)->SetTaskState(kTaskState_Init);
+					t.MarkReady(*itr);
 				}
 			}
 		}
@@ -163,78 +178,6 @@ namespace IngestTask
 			std::swap(t, tempTaskList);
 		}
 
-		template <typename T, typename F>
-		F FindTask(T& t, const ASL::Guid& inID)
-		{
-			F val;
-			typename T::iterator itr = t.begin();
-			typename T::iterator end = t.end();
-			for (; itr != end; ++itr)
-			{
-				if ( (*itr)->GetTaskID() == inID )
-				{
-					val = *itr;
-				}
-			}
-			return val;
-		}
-
-		template <typename T, typename F>
-		F FindBatch(T& t, const ASL::Guid& inID)
-		{
-			F val;
-			typename T::iterator itr = t.begin();
-			typename T::iterator end = t.end();
-			for (; itr != end; ++itr)
-			{
-				if ( (*itr)->GetBatchID() == inID )
-				{
-					val = *itr;
-					break;
-				}
-			}
-			return val;
-		}
-
-		template <typename T>
-		bool FindTask(T& t, TaskBase* task)
-		{
-			typename T::iterator itr = t.begin();
-			typename T::iterator end = t.end();
-			for (; itr != end; ++itr)
-			{
-				if ( (*itr).get() == task )
-				{
-					return true;
-				}
-			}
-			return false;
-		}
-
-		template<typename T, typename P>
-		void AddTask(T& t, P& val)
-		{
-			if ( !FindTask<T>(t, val.get()) )
-			{
-				t.push_back(val);
-			}
-		}
-
-		template<typename T>
-		void RemoveTask(T& t, TaskBase* task)
-		{
-			typename T::iterator itr = t.begin();
-			typename T::iterator end = t.end();
-			for (; itr != end; ++itr)
-			{
-				if ( (*itr).get() == task )
-				{
-					t.remove(*itr);
-					break;
-				}
-			}
-		}
-
 		// [TODO] This is only a work around to keep CopyOperationPtr when async call its process function.
 		// Should refactor to keep the shared ptr by a better way.
 		void DoCopyOperation(CopyOperationPtr inOperation)
@@ -695,6 +638,7 @@ namespace IngestTask
 	{
 		if (!CanContinue())
 		{
+			NotifyCanceled();
 			return;
 		}
 
@@ -728,6 +672,7 @@ namespace IngestTask
 				}
 				if (!CanContinue())
 				{
+					NotifyCanceled();
 					return;
 				}
 			}
@@ -760,6 +705,10 @@ namespace IngestTask
 					continue;
 				}
 
+				// The SRLibrarySupport XMP helpers are not known to be thread-safe, so only the
+				// renames above run in parallel; each file's XMP round trip is serialized.
+				ASL::CriticalSectionLock xmpLock(sXMPUpdateCriticalSection);
+
 				PL::XMPText xmpBuffer(new ASL::StdString());
 				ASL::String errorInfo;
 				ASL::Result result = PL::SRLibrarySupport::ReadXMPFromFile(filePath, xmpBuffer, errorInfo);
@@ -831,18 +780,14 @@ namespace IngestTask
 
 				if (!CanContinue())
 				{
+					NotifyCanceled();
 					return;
 				}
 			}
 		}
 
-		// Create import task
-		ASL::AsyncCallFromMainThread(boost::bind(
-			&TaskScheduler::CreateSubsequentTaskAfterUpdateMetadata,
-			mTaskScheduler,
-			mTotalResult,
-			mTask));
-
+		// The import task is created on the main thread when the finish message arrives,
+		// in the order the updates were started.
 		Done();
 
 		ASL::StationUtils::PostMessageToUIThread(
@@ -851,6 +796,14 @@ namespace IngestTask
 			true);
 	}
 
+	void UpdateMetadataOperation::NotifyCanceled()
+	{
+		ASL::StationUtils::PostMessageToUIThread(
+			GetStationID(),
+			UpdateMetadataCanceledMessage(mTask->GetTaskID()),
+			true);
+	}
+
 	//------------------------------------------------------------------------------
 	// class TaskBase
 
@@ -1232,6 +1185,7 @@ namespace IngestTask
 		ASL_MESSAGE_HANDLER(CopyFinishedMessage,			OnCopyTaskFinished)
 
 		ASL_MESSAGE_HANDLER(UpdateMetadataFinishedMessage,	OnUpdateMetadataTaskFinished)
+		ASL_MESSAGE_HANDLER(UpdateMetadataCanceledMessage,	OnUpdateMetadataTaskCanceled)
 
 		ASL_MESSAGE_HANDLER(MZ::RenderProgressMessage,			OnTranscodeTaskProgress)
 		ASL_MESSAGE_HANDLER(MZ::RenderStatusMessage,			OnTranscodeTaskStatus)
@@ -1272,7 +1226,8 @@ namespace IngestTask
 		mFailedTranscodeFileCount(0),
 		mFailedConcatenateFileCount(0),
 		mFailedImportFileCount(0),
-		mFailedUpdateMetadataCount(0)
+		mFailedUpdateMetadataCount(0),
+		mTranscodePresetCache(new TranscodePresetCache())
 	{
 		ASL::StationUtils::AddListener(mStationID, this);
 		ASL::StationUtils::AddListener(kStation_IngestMedia, this);
@@ -1332,9 +1287,7 @@ namespace IngestTask
 	{
 		if ( sTaskScheduler != NULL )
 		{
-			ImportTaskPtr task = FindTask<ImportTaskList, ImportTaskPtr>(
-				sTaskScheduler->mImportTaskQueue, 
-				inImportTaskID);
+			ImportTaskPtr task = sTaskScheduler->mImportTaskQueue.Find(inImportTaskID);
 			return (task != NULL);
 		}
 
@@ -1494,17 +1447,19 @@ namespace IngestTask
 		case kSchedulerState_Init:
 		case kSchedulerState_Running:
 		case kSchedulerState_Paused:
-			CancelTask<CopyTaskList>(mCopyTaskQueue);
-			CancelTask<UpdateMetadataTaskList>(mUpdateMetadataTaskQueue);
-			CancelTask<ImportTaskList>(mImportTaskQueue);
-			CancelTask<TranscodeTaskList>(mTranscodeTaskQueue);
-			CancelTask<ConcatenateTaskList>(mConcatenateTaskQueue);
+			CancelTask<CopyTaskQueue>(mCopyTaskQueue);
+			CancelTask<UpdateMetadataTaskQueue>(mUpdateMetadataTaskQueue);
+			CancelTask<ImportTaskQueue>(mImportTaskQueue);
+			CancelTask<TranscodeTaskQueue>(mTranscodeTaskQueue);
+			CancelTask<ConcatenateTaskQueue>(mConcatenateTaskQueue);
 
 			mCopyTaskQueue.clear();
 			mUpdateMetadataTaskQueue.clear();
 			mImportTaskQueue.clear();
 			mTranscodeTaskQueue.clear();
 			mConcatenateTaskQueue.clear();
+			mUpdateMetadataOperations.clear();
+			mUpdateMetadataFollowUps.clear();
 			ReleaseCopyExecutor();
 			ReleaseUpdateMetadataExecutor();
 			break;
@@ -1543,11 +1498,11 @@ namespace IngestTask
 		{
 		case kSchedulerState_Init:
 		case kSchedulerState_Running:
-			PauseTask<CopyTaskList>(mCopyTaskQueue);
-			PauseTask<UpdateMetadataTaskList>(mUpdateMetadataTaskQueue);
-			PauseTask<ImportTaskList>(mImportTaskQueue);
-			PauseTask<TranscodeTaskList>(mTranscodeTaskQueue);
-			PauseTask<ConcatenateTaskList>(mConcatenateTaskQueue);
+			PauseTask<CopyTaskQueue>(mCopyTaskQueue);
+			PauseTask<UpdateMetadataTaskQueue>(mUpdateMetadataTaskQueue);
+			PauseTask<ImportTaskQueue>(mImportTaskQueue);
+			PauseTask<TranscodeTaskQueue>(mTranscodeTaskQueue);
+			PauseTask<ConcatenateTaskQueue>(mConcatenateTaskQueue);
 
 			break;
 
@@ -1577,6 +1532,7 @@ namespace IngestTask
 				SRProject::GetInstance()->GetAssetLibraryNotifier()->IngestBatchFinished(sJobID, batchID);
 			}
 			mBatchGuidSet.clear();
+			PL::ClearLogicalClipCache();
 
 			ASL::StationUtils::RemoveListener(MZ::EncoderManager::Instance()->GetStationID(), this);
 			SRProject::GetInstance()->GetAssetLibraryNotifier()->IngestTaskFinished(sJobID);
@@ -1641,11 +1597,11 @@ namespace IngestTask
 		switch (mSchedulerState)
 		{
 		case kSchedulerState_Paused:
-			ResumeTask<CopyTaskList>(mCopyTaskQueue);
-			ResumeTask<UpdateMetadataTaskList>(mUpdateMetadataTaskQueue);
-			ResumeTask<ImportTaskList>(mImportTaskQueue);
-			ResumeTask<TranscodeTaskList>(mTranscodeTaskQueue);
-			ResumeTask<ConcatenateTaskList>(mConcatenateTaskQueue);
+			ResumeTask<CopyTaskQueue>(mCopyTaskQueue);
+			ResumeTask<UpdateMetadataTaskQueue>(mUpdateMetadataTaskQueue);
+			ResumeTask<ImportTaskQueue>(mImportTaskQueue);
+			ResumeTask<TranscodeTaskQueue>(mTranscodeTaskQueue);
+			ResumeTask<ConcatenateTaskQueue>(mConcatenateTaskQueue);
 			break;
 
 		default:
@@ -1683,23 +1639,20 @@ namespace IngestTask
 
 	void TaskScheduler::StartCopyTask()
 	{
-		if ( mCopyTaskQueue.empty() || IncludeRunningTask(mCopyTaskQueue) )
+		if ( mCopyTaskQueue.empty() || mCopyTaskQueue.HasRunningTask() )
 		{
 			return;
 		}
 
 		bool canceled = false;
 		// Start one Copy task
-		CopyTaskList::iterator copyItr = mCopyTaskQueue.begin();
-		CopyTaskList::iterator copyEnd = mCopyTaskQueue.end();
 		CopyTaskPtr task;
-		for (; copyItr != copyEnd; ++copyItr)
+		while ( (task = mCopyTaskQueue.PopReady()) != NULL )
 		{
-			task = *copyItr;
-			DVA_ASSERT(task != NULL);
-			if ( task->mTaskState == kTaskState_Init && !task->mCopySetting.mCopyUnits.empty() )
+			if ( !task->mCopySetting.mCopyUnits.empty() )
 			{
 				task->mTaskState = kTaskState_Running;
+				mCopyTaskQueue.MarkRunning(task);
 
 				// Push this task to thread queue for execution
 
@@ -1716,7 +1669,7 @@ namespace IngestTask
 				// Need use com-like interface to start the request (refer to MBC and MediaBrowser)
 				mCopyOperation = CopyOperationPtr(new CopyOperation(
 									mStationID, 
-									*copyItr,
+									task,
 									mCopyRunnerSetting,
 									this));
 				CreateOrGetCopyExecutor()->CallAsynchronously(
@@ -1740,24 +1693,29 @@ namespace IngestTask
 			return;
 		}
 
-		// Start one update metadata task
-		BOOST_FOREACH (UpdateMetadataTaskPtr task, mUpdateMetadataTaskQueue)
+		// Start update metadata tasks until every worker is busy
+		UpdateMetadataTaskPtr task;
+		while ( mUpdateMetadataOperations.size() < kMaxUpdateMetadataWorkers &&
+				(task = mUpdateMetadataTaskQueue.PopReady()) != NULL )
 		{
-			DVA_ASSERT(task != NULL);
 			// allow UpdateMetadataTask execute with nothing to do if no necessary rename or custom metadata.
 			// [TODO] we can optimize to avoid such execution and refine performance a little in future.
-			if ( task->mTaskState == kTaskState_Init )
-			{
-				task->mTaskState = kTaskState_Running;
+			task->mTaskState = kTaskState_Running;
 
-				// Push this task to thread queue for execution
-				mUpdateMetadataOperation = UpdateMetadataOperationPtr(new UpdateMetadataOperation(
-					mStationID, 
-					task,
-					this));
-				CreateOrGetUpdateMetadataExecutor()->CallAsynchronously(
-					boost::bind(&DoUpdateMetadataOperation, mUpdateMetadataOperation));
-			}
+			// Push this task to thread queue for execution
+			UpdateMetadataOperationPtr operation(new UpdateMetadataOperation(
+				mStationID, 
+				task,
+				this));
+			mUpdateMetadataOperations[task->GetTaskID()] = operation;
+
+			UpdateMetadataFollowUp followUp;
+			followUp.mTask = task;
+			followUp.mFinished = false;
+			followUp.mResult = ASL::kSuccess;
+			mUpdateMetadataFollowUps.push_back(followUp);
+			CreateOrGetUpdateMetadataExecutor()->CallAsynchronously(
+				boost::bind(&DoUpdateMetadataOperation, operation));
 		}
 	}
 
@@ -1776,28 +1734,24 @@ namespace IngestTask
 		mImportOperation->Process();
 
 		// Start one Import task
-		ImportTaskList::iterator importItr = mImportTaskQueue.begin();
-		ImportTaskList::iterator importEnd = mImportTaskQueue.end();
-		for (; importItr != importEnd; ++importItr)
+		ImportTaskPtr task;
+		while ( (task = mImportTaskQueue.PopReady()) != NULL )
 		{
-			if ( (*importItr)->mTaskState == kTaskState_Init )
-			{
-				(*importItr)->mTaskState = kTaskState_Running;
+			task->mTaskState = kTaskState_Running;
 
-				PL::IngestItemList ingestItems;
-				const ImportPathInfoMap& srcFiles = (*importItr)->GetImportSetting().mSrcFiles;
-				BOOST_FOREACH (const ImportPathInfoMap::value_type& pairValue, srcFiles)
-				{
-					pairValue.second->mItemFormat = PL::Utilities::ConvertProviderIDToFormat(pairValue.second->mItemFormat);
-					ingestItems.push_back(pairValue.second);
-				}
-				SRProject::GetInstance()->GetAssetLibraryNotifier()->ImportItemsAreReady(
-															sJobID, 
-															(*importItr)->GetBatchID(),
-															(*importItr)->GetTaskID(), 
-															ingestItems,
-															(*importItr)->GetCustomData());
+			PL::IngestItemList ingestItems;
+			const ImportPathInfoMap& srcFiles = task->GetImportSetting().mSrcFiles;
+			BOOST_FOREACH (const ImportPathInfoMap::value_type& pairValue, srcFiles)
+			{
+				pairValue.second->mItemFormat = PL::Utilities::ConvertProviderIDToFormat(pairValue.second->mItemFormat);
+				ingestItems.push_back(pairValue.second);
 			}
+			SRProject::GetInstance()->GetAssetLibraryNotifier()->ImportItemsAreReady(
+														sJobID, 
+														task->GetBatchID(),
+														task->GetTaskID(), 
+														ingestItems,
+														task->GetCustomData());
 		}
 	}
 
@@ -1811,9 +1765,9 @@ namespace IngestTask
 		{
 			mCopyOperation->Resume();
 		}
-		if (NULL != mUpdateMetadataOperation)
+		BOOST_FOREACH(UpdateMetadataOperationMap::value_type& operation, mUpdateMetadataOperations)
 		{
-			mUpdateMetadataOperation->Resume();
+			operation.second->Resume();
 		}
 	}
 
@@ -1829,9 +1783,9 @@ namespace IngestTask
 			mCopyOperation->Pause();
 		}
 
-		if (NULL != mUpdateMetadataOperation)
+		BOOST_FOREACH(UpdateMetadataOperationMap::value_type& operation, mUpdateMetadataOperations)
 		{
-			mUpdateMetadataOperation->Pause();
+			operation.second->Pause();
 		}
 	}
 
@@ -1845,9 +1799,9 @@ namespace IngestTask
 		{
 			mCopyOperation->Cancel();
 		}
-		if (NULL != mUpdateMetadataOperation)
+		BOOST_FOREACH(UpdateMetadataOperationMap::value_type& operation, mUpdateMetadataOperations)
 		{
-			mUpdateMetadataOperation->Cancel();
+			operation.second->Cancel();
 		}
 	}
 
@@ -1861,16 +1815,16 @@ namespace IngestTask
 		{
 			mCopyOperation->Done();
 		}
-		if (NULL != mUpdateMetadataOperation)
+		BOOST_FOREACH(UpdateMetadataOperationMap::value_type& operation, mUpdateMetadataOperations)
 		{
-			mUpdateMetadataOperation->Done();
+			operation.second->Done();
 		}
 	}
 
 	void TaskScheduler::StartTranscodeTask()
 	{
 		// Add all transcode tasks to AME queue without any blocking in Prelude side.
-		if ( mTranscodeTaskQueue.empty() /* || IncludeRunningTask(mTranscodeTaskQueue)*/ )
+		if ( mTranscodeTaskQueue.empty() /* || mTranscodeTaskQueue.HasRunningTask()*/ )
 		{
 			return;
 		}
@@ -1878,100 +1832,144 @@ namespace IngestTask
 		// Don't need test if any transcode task is running because they can managed by AME queue.
 
 		// Start all Transcode Task because AME has a queue in another process
-		TranscodeTaskList::iterator transcodeItr = mTranscodeTaskQueue.begin();
-		TranscodeTaskList::iterator transcodeEnd = mTranscodeTaskQueue.end();
 		TranscodeTaskList errorTasks;
 
 		TranscodeTaskPtr task;
-		for (; transcodeItr != transcodeEnd; ++transcodeItr)
+		while ( (task = mTranscodeTaskQueue.PopReady()) != NULL )
 		{
-			task = *transcodeItr;
-			if ( task != NULL && task->mTaskState == kTaskState_Init )
+			task->mTaskState = kTaskState_Running;
+
+			// It should be only one file here
+			ClipSetting srcClipSetting(task->mTranscodeSetting.mSrcFileSettings.front()); 
+			const ASL::String& srcFile = srcClipSetting.mFileName;
+			dvacore::UTF16String errorInfo;
+
+			if ( ASL::Directory::IsDirectory(srcFile) )
 			{
-				task->mTaskState = kTaskState_Running;
+				// Cannot transcode an folder
+				errorInfo = dvacore::ZString(
+					"$$$/Prelude/Mezzanine/IngestScheduler/TranscodeTaskFolderFail=Cannot transcode a folder!");
+				errorTasks.push_back(task);
+				HandleTranscodeTaskError(task, errorInfo);
+				continue;
+			}
 
-				// It should be only one file here
-				ClipSetting srcClipSetting(task->mTranscodeSetting.mSrcFileSettings.front()); 
-				const ASL::String& srcFile = srcClipSetting.mFileName;
-				dvacore::UTF16String errorInfo;
+			ASL::String relativePath(RemoveRootFromPath(srcFile, task->mTranscodeSetting.mSrcRootPath));
+			relativePath = MZ::Utilities::StripHeadingSlash(relativePath);
+			DVA_ASSERT(!relativePath.empty());
+			if ( relativePath.empty() )
+			{
+				// Cannot get a relative path
+				errorInfo = dvacore::ZString(
+					"$$$/Prelude/Mezzanine/IngestScheduler/TranscodeTaskRelativePathFail=Cannot get the right source path!");
+				errorTasks.push_back(task);
+				HandleTranscodeTaskError(task, errorInfo);
+				continue;
+			}
 
-				if ( ASL::Directory::IsDirectory(srcFile) )
-				{
-					// Cannot transcode an folder
-					errorInfo = dvacore::ZString(
-						"$$$/Prelude/Mezzanine/IngestScheduler/TranscodeTaskFolderFail=Cannot transcode a folder!");
-					errorTasks.push_back(task);
-					HandleTranscodeTaskError(task, errorInfo);
-					continue;
-				}
+			ASL::String destPath(ASL::PathUtils::CombinePaths(MZ::Utilities::NormalizePathWithoutUNC(
+				task->mTranscodeSetting.mDestFolder), 
+				relativePath));
+
+			destPath = ASL::PathUtils::GetFullDirectoryPart(destPath);
 
-				ASL::String relativePath(RemoveRootFromPath(srcFile, task->mTranscodeSetting.mSrcRootPath));
-				relativePath = MZ::Utilities::StripHeadingSlash(relativePath);
-				DVA_ASSERT(!relativePath.empty());
-				if ( relativePath.empty() )
+			ASL::String presetFile(GetTranscodePresetFile(task, srcFile));
+			
+			if ( !PL::IngestUtils::TranscodeMediaFile(
+				BE::kCompileSettingsType_Movie,
+				srcFile, 
+				destPath,
+				ASL::String(),
+				presetFile,
+				srcClipSetting.mInPoint,
+				srcClipSetting.mOutPoint,
+				task->mTaskID.AsString(),
+				task->mTranscodeJobID,
+				errorInfo) )
+			{
+				errorTasks.push_back(task);
+				HandleTranscodeTaskError(task, errorInfo);
+			}
+			else
+			{
+				if (task->mTranscodeSetting.mShouldAutoDeleteAfterIngested)
 				{
-					// Cannot get a relative path
-					errorInfo = dvacore::ZString(
-						"$$$/Prelude/Mezzanine/IngestScheduler/TranscodeTaskRelativePathFail=Cannot get the right source path!");
-					errorTasks.push_back(task);
-					HandleTranscodeTaskError(task, errorInfo);
-					continue;
+					// In EA mode, should add the destination file into mTranscodeTempFiles so that these temp files can be deleted in time.
+					mTranscodeTempFiles.push_back(destPath);
 				}
 
-				ASL::String destPath(ASL::PathUtils::CombinePaths(MZ::Utilities::NormalizePathWithoutUNC(
-					task->mTranscodeSetting.mDestFolder), 
-					relativePath));
+				//break;
+			}
+		}
 
-				destPath = ASL::PathUtils::GetFullDirectoryPart(destPath);
+		bool needRestartTasks = (errorTasks.size() == mTranscodeTaskQueue.size());
+		BOOST_FOREACH(TranscodeTaskPtr errorTask, errorTasks)
+		{
+			Remove(errorTask);
+		}
 
-				if (task->mTranscodeSetting.GetPreset() == NULL)
-				{
-					task->mTranscodeSetting.SetPreset(PL::Utilities::CreateCustomPresetForMedia(srcFile, task->mTranscodeSetting.GetExportModule()));
-				}
-				ASL::String presetFile(PL::Utilities::SavePresetToFile(task->mTranscodeSetting.GetPreset()));
-				
-				if ( !PL::IngestUtils::TranscodeMediaFile(
-					BE::kCompileSettingsType_Movie,
-					srcFile, 
-					destPath,
-					ASL::String(),
-					presetFile,
-					srcClipSetting.mInPoint,
-					srcClipSetting.mOutPoint,
-					task->mTaskID.AsString(),
-					task->mTranscodeJobID,
-					errorInfo) )
+		// RunTasks should be triggered by AME message. However, if all tasks fail to be started, 
+		// We should trigger this ourselves. 
+		if ( needRestartTasks )
+		{
+			RunTasks();
+		}
+	}
+
+	ASL::String TaskScheduler::GetTranscodePresetFile(TranscodeTaskPtr inTask, ASL::String const& inSrcFile)
+	{
+		TranscodeSetting& setting = inTask->mTranscodeSetting;
+		if (setting.GetPreset() == NULL)
+		{
+			PL::Utilities::MediaFormatSignature signature;
+			BE::ISequenceRef sequence;
+			if (PL::Utilities::GetMediaFormatSignature(inSrcFile, signature, sequence))
+			{
+				BOOST_FOREACH(const TranscodePresetCache::CustomPresetRecord& record, mTranscodePresetCache->mCustomPresets)
 				{
-					errorTasks.push_back(task);
-					HandleTranscodeTaskError(task, errorInfo);
+					if (record.mExportModule == setting.GetExportModule() && record.mSignature == signature)
+					{
+						setting.SetPreset(record.mPreset);
+						break;
+					}
 				}
-				else
+
+				if (setting.GetPreset() == NULL)
 				{
-					if (task->mTranscodeSetting.mShouldAutoDeleteAfterIngested)
+					TranscodePresetCache::CustomPresetRecord record;
+					record.mExportModule = setting.GetExportModule();
+					record.mSignature = signature;
+					record.mPreset = PL::Utilities::CreateCustomPresetForSequence(sequence, setting.GetExportModule());
+					setting.SetPreset(record.mPreset);
+					if (record.mPreset != NULL)
 					{
-						// In EA mode, should add the destination file into mTranscodeTempFiles so that these temp files can be deleted in time.
-						mTranscodeTempFiles.push_back(destPath);
+						mTranscodePresetCache->mCustomPresets.push_back(record);
 					}
-
-					//break;
 				}
 			}
+			else
+			{
+				setting.SetPreset(PL::Utilities::CreateCustomPresetForSequence(sequence, setting.GetExportModule()));
+			}
 		}
 
-		bool needRestartTasks = (errorTasks.size() == mTranscodeTaskQueue.size());
-		transcodeItr = errorTasks.begin();
-		transcodeEnd = errorTasks.end();
-		for (; transcodeItr != transcodeEnd; ++ transcodeItr)
+		EncoderHost::IPresetRef preset = setting.GetPreset();
+		BOOST_FOREACH(const TranscodePresetCache::PresetFileRecord& record, mTranscodePresetCache->mPresetFiles)
 		{
-			Remove(*transcodeItr);
+			if (record.mPreset == preset)
+			{
+				return record.mPresetFile;
+			}
 		}
 
-		// RunTasks should be triggered by AME message. However, if all tasks fail to be started, 
-		// We should trigger this ourselves. 
-		if ( needRestartTasks )
+		TranscodePresetCache::PresetFileRecord record;
+		record.mPreset = preset;
+		record.mPresetFile = PL::Utilities::SavePresetToFile(preset);
+		if (!record.mPresetFile.empty())
 		{
-			RunTasks();
+			mTranscodePresetCache->mPresetFiles.push_back(record);
 		}
+		return record.mPresetFile;
 	}
 
 	void TaskScheduler::StartConcatenateTask()
@@ -1985,87 +1983,79 @@ namespace IngestTask
 		// Don't need test if any concatenate task is running because they can managed by AME queue.
 
 		// Start all Concatenate Task because AME has a queue in another process
-		ConcatenateTaskList::iterator concatenateItr = mConcatenateTaskQueue.begin();
-		ConcatenateTaskList::iterator concatenateEnd = mConcatenateTaskQueue.end();
 		ConcatenateTaskList errorTasks;
 
 		ConcatenateTaskPtr task;
-		for (; concatenateItr != concatenateEnd; ++concatenateItr)
+		while ( (task = mConcatenateTaskQueue.PopReady()) != NULL )
 		{
-			task = *concatenateItr;
-			if ( task != NULL && task->mTaskState == kTaskState_Init )
-			{
-				task->mTaskState = kTaskState_Running;
+			task->mTaskState = kTaskState_Running;
 
-				// It's OK to only get front here:
-				//   For concatenation, the dest path will be decided based on source file path and source root path,
-				//   and the source root path was gotten from the 1st clip, so we should also get source file path of the 1st file.
-				ClipSetting srcClipSetting(task->mTranscodeSetting.mSrcFileSettings.front()); 
-				const ASL::String& srcFile = srcClipSetting.mFileName;
+			// It's OK to only get front here:
+			//   For concatenation, the dest path will be decided based on source file path and source root path,
+			//   and the source root path was gotten from the 1st clip, so we should also get source file path of the 1st file.
+			ClipSetting srcClipSetting(task->mTranscodeSetting.mSrcFileSettings.front()); 
+			const ASL::String& srcFile = srcClipSetting.mFileName;
 
-				ASL::String relativePath(RemoveRootFromPath(srcFile, task->mTranscodeSetting.mSrcRootPath));
-				relativePath = MZ::Utilities::StripHeadingSlash(relativePath);
-				DVA_ASSERT(!relativePath.empty());
-				if ( relativePath.empty() )
-				{
-					// Cannot get a relative path
-					ASL::String const& errorInfo = dvacore::ZString(
-						"$$$/Prelude/Mezzanine/IngestScheduler/ConcatenateTaskRelativePathFail=Cannot get the right source path!");
-					errorTasks.push_back(task);
-					HandleConcatenateTaskError(task, errorInfo);
-					continue;
-				}
+			ASL::String relativePath(RemoveRootFromPath(srcFile, task->mTranscodeSetting.mSrcRootPath));
+			relativePath = MZ::Utilities::StripHeadingSlash(relativePath);
+			DVA_ASSERT(!relativePath.empty());
+			if ( relativePath.empty() )
+			{
+				// Cannot get a relative path
+				ASL::String const& errorInfo = dvacore::ZString(
+					"$$$/Prelude/Mezzanine/IngestScheduler/ConcatenateTaskRelativePathFail=Cannot get the right source path!");
+				errorTasks.push_back(task);
+				HandleConcatenateTaskError(task, errorInfo);
+				continue;
+			}
 
-				ASL::String destPath(ASL::PathUtils::CombinePaths(MZ::Utilities::NormalizePathWithoutUNC(
-					task->mTranscodeSetting.mDestFolder), 
-					relativePath));
+			ASL::String destPath(ASL::PathUtils::CombinePaths(MZ::Utilities::NormalizePathWithoutUNC(
+				task->mTranscodeSetting.mDestFolder), 
+				relativePath));
 
-				destPath = ASL::PathUtils::GetFullDirectoryPart(destPath);
+			destPath = ASL::PathUtils::GetFullDirectoryPart(destPath);
 
-				PathToErrorInfoVec errorInfos;
-				BE::IProjectRef theProject;
-				BE::ISequenceRef theSequence;
-				if (!IngestUtils::CreateSequenceForConcatenateMedia(task->mTranscodeSetting.mSrcFileSettings, theProject, theSequence, task->mTranscodeSetting.GetConcatenationName(), errorInfos))
-				{
-					errorTasks.push_back(task);
-					HandleConcatenateTaskError(task, errorInfos);
-					continue;
-				}
-				if (task->mTranscodeSetting.GetPreset() == NULL)
-				{
-					task->mTranscodeSetting.SetPreset(PL::Utilities::CreateCustomPresetForSequence(theSequence, task->mTranscodeSetting.GetExportModule()));
-				}
+			PathToErrorInfoVec errorInfos;
+			BE::IProjectRef theProject;
+			BE::ISequenceRef theSequence;
+			if (!IngestUtils::CreateSequenceForConcatenateMedia(task->mTranscodeSetting.mSrcFileSettings, theProject, theSequence, task->mTranscodeSetting.GetConcatenationName(), errorInfos))
+			{
+				errorTasks.push_back(task);
+				HandleConcatenateTaskError(task, errorInfos);
+				continue;
+			}
+			if (task->mTranscodeSetting.GetPreset() == NULL)
+			{
+				task->mTranscodeSetting.SetPreset(PL::Utilities::CreateCustomPresetForSequence(theSequence, task->mTranscodeSetting.GetExportModule()));
+			}
 
-				task->SetProject(theProject);
-
-				if ( !PL::IngestUtils::TranscodeConcatenateFile(
-					task->mTaskID.AsString(),
-					task->mTranscodeJobID,
-					task->mTranscodeSetting.GetPreset(),
-					theProject,
-					theSequence,
-					destPath,
-					task->mTranscodeSetting.GetConcatenationName(),
-					errorInfos) )
-				{
-					errorTasks.push_back(task);
-					HandleConcatenateTaskError(task, errorInfos);
-				}
+			task->SetProject(theProject);
 
-				if (task->mTranscodeSetting.mShouldAutoDeleteAfterIngested)
-				{
-					// In EA mode, should add the destination file into mTranscodeTempFiles so that these temp files can be deleted in time.
-					mTranscodeTempFiles.push_back(destPath);
-				}
+			if ( !PL::IngestUtils::TranscodeConcatenateFile(
+				task->mTaskID.AsString(),
+				task->mTranscodeJobID,
+				task->mTranscodeSetting.GetPreset(),
+				theProject,
+				theSequence,
+				destPath,
+				task->mTranscodeSetting.GetConcatenationName(),
+				errorInfos) )
+			{
+				errorTasks.push_back(task);
+				HandleConcatenateTaskError(task, errorInfos);
+			}
+
+			if (task->mTranscodeSetting.mShouldAutoDeleteAfterIngested)
+			{
+				// In EA mode, should add the destination file into mTranscodeTempFiles so that these temp files can be deleted in time.
+				mTranscodeTempFiles.push_back(destPath);
 			}
 		}
 
 		bool needRestartTasks = errorTasks.size() == mConcatenateTaskQueue.size();
-		concatenateItr = errorTasks.begin();
-		concatenateEnd = errorTasks.end();
-		for (; concatenateItr != concatenateEnd; ++ concatenateItr)
+		BOOST_FOREACH(ConcatenateTaskPtr errorTask, errorTasks)
 		{
-			Remove(*concatenateItr);
+			Remove(errorTask);
 		}
 
 		// RunTasks should be triggered by AME message. However, if all tasks fail to be started, 
@@ -2092,7 +2082,7 @@ namespace IngestTask
 				std::size_t inSucessCount,
 				std::size_t inFailedCount)
 	{
-		CopyTaskPtr task = FindTask<CopyTaskList, CopyTaskPtr>(mCopyTaskQueue, inTaskID);
+		CopyTaskPtr task = mCopyTaskQueue.Find(inTaskID);
 		if (task != NULL)
 		{
 			++mDoneTaskCount;
@@ -2133,7 +2123,9 @@ namespace IngestTask
 		ASL::Result inResult, 
 		const ResultReportVector& inResults)
 	{
-		UpdateMetadataTaskPtr task = FindTask<UpdateMetadataTaskList, UpdateMetadataTaskPtr>(mUpdateMetadataTaskQueue, inTaskID);
+		mUpdateMetadataOperations.erase(inTaskID);
+
+		UpdateMetadataTaskPtr task = mUpdateMetadataTaskQueue.Find(inTaskID);
 		if (task != NULL)
 		{
 			++mDoneTaskCount;
@@ -2167,6 +2159,17 @@ namespace IngestTask
 
 		Remove(task);
 
+		BOOST_FOREACH(UpdateMetadataFollowUp& followUp, mUpdateMetadataFollowUps)
+		{
+			if (followUp.mTask->GetTaskID() == inTaskID)
+			{
+				followUp.mFinished = true;
+				followUp.mResult = inResult;
+				break;
+			}
+		}
+		CreateFinishedUpdateMetadataFollowUps();
+
 		if (mUpdateMetadataTaskQueue.empty())
 		{
 			ReleaseUpdateMetadataExecutor();
@@ -2175,9 +2178,27 @@ namespace IngestTask
 		RunTasks();
 	}
 
+	void TaskScheduler::OnUpdateMetadataTaskCanceled(const ASL::Guid& inTaskID)
+	{
+		mUpdateMetadataOperations.erase(inTaskID);
+
+		// A canceled update gets no follow-up task, and must not hold back the ones after it.
+		for (UpdateMetadataFollowUpQueue::iterator followUp = mUpdateMetadataFollowUps.begin();
+			followUp != mUpdateMetadataFollowUps.end();
+			++followUp)
+		{
+			if (followUp->mTask->GetTaskID() == inTaskID)
+			{
+				mUpdateMetadataFollowUps.erase(followUp);
+				break;
+			}
+		}
+		CreateFinishedUpdateMetadataFollowUps();
+	}
+
 	void TaskScheduler::OnImportTaskFinished(const ASL::Guid& inTaskID)
 	{
-		ImportTaskPtr task = FindTask<ImportTaskList, ImportTaskPtr>(mImportTaskQueue, inTaskID);
+		ImportTaskPtr task = mImportTaskQueue.Find(inTaskID);
 		if (task != NULL)
 		{
 			++mDoneTaskCount;
@@ -2305,11 +2326,11 @@ namespace IngestTask
 		DVA_TRACE( "TaskScheduler::OnTranscodeError", 5, 
 			" TaskID: " << inJobID );
 
-		TranscodeTaskPtr transcodeTask = FindTask<TranscodeTaskList, TranscodeTaskPtr>(mTranscodeTaskQueue, ASL::Guid(inRequestID));
+		TranscodeTaskPtr transcodeTask = mTranscodeTaskQueue.Find(ASL::Guid(inRequestID));
 		HandleTranscodeTaskError(transcodeTask, inErrorInfo);
 		Remove(transcodeTask);
 
-		ConcatenateTaskPtr concatenateTask = FindTask<ConcatenateTaskList, ConcatenateTaskPtr>(mConcatenateTaskQueue, ASL::Guid(inRequestID));
+		ConcatenateTaskPtr concatenateTask = mConcatenateTaskQueue.Find(ASL::Guid(inRequestID));
 		HandleConcatenateTaskError(concatenateTask, inErrorInfo);
 		Remove(concatenateTask);
 
@@ -2341,7 +2362,7 @@ namespace IngestTask
 
 		ASL::Guid taskID(inRequestID);
 		{
-			TranscodeTaskPtr task = FindTask<TranscodeTaskList, TranscodeTaskPtr>(mTranscodeTaskQueue, taskID);
+			TranscodeTaskPtr task = mTranscodeTaskQueue.Find(taskID);
 			if (task != NULL)
 			{
 				mTranscodeProgress = inPercent;
@@ -2349,7 +2370,7 @@ namespace IngestTask
 		}
 
 		{
-			ConcatenateTaskPtr task = FindTask<ConcatenateTaskList, ConcatenateTaskPtr>(mConcatenateTaskQueue, taskID);
+			ConcatenateTaskPtr task = mConcatenateTaskQueue.Find(taskID);
 			if (task != NULL)
 			{
 				mConcatenateProgress = inPercent;
@@ -2595,14 +2616,14 @@ namespace IngestTask
 
 		ASL::Guid taskID(inRequestID);
 
-		TranscodeTaskPtr task = FindTask<TranscodeTaskList, TranscodeTaskPtr>(mTranscodeTaskQueue, taskID);
+		TranscodeTaskPtr task = mTranscodeTaskQueue.Find(taskID);
 		if (task != NULL)
 		{
 			TranscodeTaskFinishedImpl(task, inJobID, inOutputFilePath, inEncoderID);
 		}
 		else
 		{
-			ConcatenateTaskPtr task = FindTask<ConcatenateTaskList, ConcatenateTaskPtr>(mConcatenateTaskQueue, taskID);
+			ConcatenateTaskPtr task = mConcatenateTaskQueue.Find(taskID);
 			if (task != NULL)
 			{
 				ConcatenateTaskFinishedImpl(task, inJobID, inOutputFilePath, inEncoderID);
@@ -2668,6 +2689,9 @@ namespace IngestTask
 		mSucceededTranscodeFileCount = 0;
 		mSucceededConcatenateFileCount = 0;
 
+		mTranscodePresetCache->mCustomPresets.clear();
+		mTranscodePresetCache->mPresetFiles.clear();
+
 		mSchedulerState = kSchedulerState_Init;
 	}
 
@@ -2763,6 +2787,16 @@ namespace IngestTask
 		}
 	}
 
+	void TaskScheduler::CreateFinishedUpdateMetadataFollowUps()
+	{
+		while (!mUpdateMetadataFollowUps.empty() && mUpdateMetadataFollowUps.front().mFinished)
+		{
+			UpdateMetadataFollowUp followUp = mUpdateMetadataFollowUps.front();
+			mUpdateMetadataFollowUps.pop_front();
+			CreateSubsequentTaskAfterUpdateMetadata(followUp.mResult, followUp.mTask);
+		}
+	}
+
 	void TaskScheduler::CreateSubsequentTaskAfterUpdateMetadata(
 		ASL::Result inResult,
 		UpdateMetadataTaskPtr inTask)
@@ -2819,7 +2853,7 @@ namespace IngestTask
 		{
 			inTask->SetTaskState(IngestTask::kTaskState_Paused);
 		}
-		AddTask<CopyTaskList, CopyTaskPtr>(mCopyTaskQueue, inTask);
+		mCopyTaskQueue.Add(inTask);
 		mTotalTaskCount += inTask->GetTaskUnitCount();
 
 		AddBatchID(inTask->GetBatchID());
@@ -2839,7 +2873,7 @@ namespace IngestTask
 		{
 			inTask->SetTaskState(IngestTask::kTaskState_Paused);
 		}
-		AddTask<TranscodeTaskList, TranscodeTaskPtr>(mTranscodeTaskQueue, inTask);
+		mTranscodeTaskQueue.Add(inTask);
 		mTotalTaskCount += inTask->GetTaskUnitCount();
 
 		AddBatchID(inTask->GetBatchID());
@@ -2859,7 +2893,7 @@ namespace IngestTask
 		{
 			inTask->SetTaskState(IngestTask::kTaskState_Paused);
 		}
-		AddTask<ConcatenateTaskList, ConcatenateTaskPtr>(mConcatenateTaskQueue, inTask);
+		mConcatenateTaskQueue.Add(inTask);
 		mTotalTaskCount += inTask->GetTaskUnitCount();
 
 		AddBatchID(inTask->GetBatchID());
@@ -2879,7 +2913,7 @@ namespace IngestTask
 		{
 			inTask->SetTaskState(IngestTask::kTaskState_Paused);
 		}
-		AddTask<ImportTaskList, ImportTaskPtr>(mImportTaskQueue, inTask);
+		mImportTaskQueue.Add(inTask);
 		mTotalTaskCount += inTask->GetTaskUnitCount();
 
 		AddBatchID(inTask->GetBatchID());
@@ -2899,7 +2933,7 @@ namespace IngestTask
 		{
 			inTask->SetTaskState(IngestTask::kTaskState_Paused);
 		}
-		AddTask<UpdateMetadataTaskList, UpdateMetadataTaskPtr>(mUpdateMetadataTaskQueue, inTask);
+		mUpdateMetadataTaskQueue.Add(inTask);
 		mTotalTaskCount += inTask->GetTaskUnitCount();
 
 		AddBatchID(inTask->GetBatchID());
@@ -2913,27 +2947,27 @@ namespace IngestTask
 
 	void TaskScheduler::Remove(CopyTaskPtr inTask)
 	{
-		RemoveTask<CopyTaskList>(mCopyTaskQueue, inTask.get());
+		mCopyTaskQueue.Remove(inTask.get());
 	}
 
 	void TaskScheduler::Remove(UpdateMetadataTaskPtr inTask)
 	{
-		RemoveTask<UpdateMetadataTaskList>(mUpdateMetadataTaskQueue, inTask.get());
+		mUpdateMetadataTaskQueue.Remove(inTask.get());
 	}
 
 	void TaskScheduler::Remove(TranscodeTaskPtr inTask)
 	{
-		RemoveTask<TranscodeTaskList>(mTranscodeTaskQueue, inTask.get());
+		mTranscodeTaskQueue.Remove(inTask.get());
 	}
 
 	void TaskScheduler::Remove(ConcatenateTaskPtr inTask)
 	{
-		RemoveTask<ConcatenateTaskList>(mConcatenateTaskQueue, inTask.get());
+		mConcatenateTaskQueue.Remove(inTask.get());
 	}
 
 	void TaskScheduler::Remove(ImportTaskPtr inTask)
 	{
-		RemoveTask<ImportTaskList>(mImportTaskQueue, inTask.get());
+		mImportTaskQueue.Remove(inTask.get());
 	}
 
 	void TaskScheduler::OnStartIngest(ASL::Guid const& inBatchID, ASL::String const& inBinID)
@@ -3003,7 +3037,7 @@ namespace IngestTask
 							ASL::Result const& inResult,
 							ASL::String const& inErrorInfo)
 	{
-		ImportTaskPtr task = FindTask<ImportTaskList, ImportTaskPtr>(mImportTaskQueue, inHostTaskID);
+		ImportTaskPtr task = mImportTaskQueue.Find(inHostTaskID);
 		// It's possible that all tasks have been canceled and then asynchronous message arrive.
 		if (task == NULL)
 			return;
@@ -3071,16 +3105,11 @@ namespace IngestTask
 			// Only taskItemID is finished, then to check batchID finish
 			if (mBatchGuidSet.find(batchID) != mBatchGuidSet.end())
 			{
-				ImportTaskPtr importTask = FindBatch<ImportTaskList, ImportTaskPtr>(mImportTaskQueue, batchID);
-				CopyTaskPtr copyTask = FindBatch<CopyTaskList, CopyTaskPtr>(mCopyTaskQueue, batchID);
-				UpdateMetadataTaskPtr updateMetadataTask = FindBatch<UpdateMetadataTaskList, UpdateMetadataTaskPtr>(mUpdateMetadataTaskQueue, batchID);
-				TranscodeTaskPtr transcodeTask = FindBatch<TranscodeTaskList, TranscodeTaskPtr>(mTranscodeTaskQueue, batchID);
-				ConcatenateTaskPtr concatenateTask = FindBatch<ConcatenateTaskList, ConcatenateTaskPtr>(mConcatenateTaskQueue, batchID);
-				if (importTask == NULL
-					&& updateMetadataTask == NULL
-					&& transcodeTask == NULL
-					&& concatenateTask == NULL
-					&& copyTask == NULL)
+				if (!mImportTaskQueue.HasBatch(batchID)
+					&& !mUpdateMetadataTaskQueue.HasBatch(batchID)
+					&& !mTranscodeTaskQueue.HasBatch(batchID)
+					&& !mConcatenateTaskQueue.HasBatch(batchID)
+					&& !mCopyTaskQueue.HasBatch(batchID))
 				{
 					RemoveBatchID(batchID);
 					SRProject::GetInstance()->GetAssetLibraryNotifier()->IngestBatchFinished(sJobID, batchID);
@@ -3128,7 +3157,7 @@ namespace IngestTask
 	bool TaskScheduler::IsPathInCopyList(const ASL::String& inPath)
 	{
 		TaskSchedulerPtr scheduler = GetInstance();
-		BOOST_FOREACH (CopyTaskList::value_type& copyTaskPtr, scheduler->mCopyTaskQueue)
+		BOOST_FOREACH (CopyTaskQueue::value_type& copyTaskPtr, scheduler->mCopyTaskQueue)
 		{
 			const CopySetting& copySetting = copyTaskPtr->GetCopySetting();
 			BOOST_FOREACH (const CopyUnit::SharedPtr& filesSet, copySetting.mCopyUnits)
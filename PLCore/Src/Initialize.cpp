@@ -28,6 +28,7 @@
 
 #include "IngestMedia/PLIngestJob.h"
 #include "PLMarkerTemplate.h"
+#include "PLMarkerGuidIndex.h"
 #include "PLModulePicker.h"
 #include "PLWriteXMPToDiskCache.h"
 #include "IPLMarkerSelection.h"
@@ -59,6 +60,7 @@ namespace PL
 		MarkerType::Initialize();
 		//Register pre-defined handlers
 		MarkerType::RegisterMarkerTypes();
+		MarkerGuidIndex::Initialize();
 
 		SRMediaMonitor::Initialize();
 		SRProject::Initialize();
@@ -88,6 +90,7 @@ namespace PL
 		ModulePicker::Terminate();
 		SRProject::Terminate();
 		SRMediaMonitor::Terminate();
+		MarkerGuidIndex::Terminate();
 		MarkerType::Shutdown();
 		WriteXMPToDiskCache::Terminate();
 
@@ -69,6 +69,9 @@ namespace {
 
 bool progress_callback(ASL::Float32 inPercentDone, void* inProgressData);
 
+// Files are copied by at most this many IO threads at once.
+static const size_t kMaxCopyWorkers = 4;
+
 ASL_DECLARE_MESSAGE_WITH_0_PARAM(ConvertToFinalProjectMessage);
 
 // This class implements the operation of doing export media to new location on local disk.
@@ -486,13 +489,23 @@ private:
 		return ASL::kSuccess;
 	}
 
-	ASL::Result ExportMediaFiles()
+	/*
+	**	Walk every media item once and turn it into a flat list of file copies. Warnings, directory
+	**	creation and project path pairs are all settled here on the export thread, so the copy
+	**	workers below only ever move bytes.
+	*/
+	void PlanCopyJobs(PL::ExportUtils::PathPairVector& outPathPairs)
 	{
-		PL::ExportUtils::PathPairVector pathPairs;
-
 		mDestinationFolder = ASL::PathUtils::AddTrailingSlash(mDestinationFolder);
 		ASL::String destRoot = mDestinationFolder + ASL_STR("media");
 
+		// Items can share files (sidecars, spanned clips), so several plans may land on one
+		// destination. Only one job per destination is kept, otherwise two workers could write
+		// the same file at once. Destinations are compared exactly, since the volume's case
+		// rules are unknown here and folding would merge distinct files on case-sensitive volumes.
+		typedef std::map<ASL::String, size_t> DestinationJobMap;
+		DestinationJobMap destinationJobs;
+
 		for (PL::ExportUtils::MeidaPathToExportItemMap::iterator iter = mMediaPathToExportItems.begin();
 			iter != mMediaPathToExportItems.end();
 			++iter)
@@ -519,7 +532,7 @@ private:
 				continue;
 			}
 
-			StartProgress(1, exportFilePaths.size());
+			mPlannedMediaPaths.push_back(normalizedMediaPath);
 
 			for (ASL::PathnameList::const_iterator bf = exportFilePaths.begin(), bl = exportFilePaths.end(); bf != bl; ++bf)
 			{
@@ -528,90 +541,137 @@ private:
 				if (normalizedItemPath.empty())
 					continue;
 
-				// For every jobItem, assume the progress has 100 steps to do.
-				PL::ExportUtils::ExportProgressData progressData;
-				progressData.UpdateProgress = boost::bind(&LocalExportLibraryItemsOperation::UpdateProgress, this, _1);
-				progressData.totalProgress = 100;
-				progressData.currentProgress = 0;
-				StartProgress(1, progressData.totalProgress);
-				
 				ASL::String destPath = PL::ExportUtils::BuildUnqiueDestinationPath(normalizedItemPath, destRoot, exportItem);
 
-				ASL::Result copyResult = ASL::kSuccess;
 				if (ASL::PathUtils::IsDirectory(normalizedItemPath))
 				{
 					if (!ASL::PathUtils::ExistsOnDisk(destPath))
 					{
 						dvacore::utility::FileUtils::EnsureDirectoryExists(ASL::PathUtils::GetFullDirectoryPart(destPath));
-						copyResult = ASL::Directory::CreateOnDisk(destPath, true);
-						if (copyResult != ASL::kSuccess)
+						if (ASL::Directory::CreateOnDisk(destPath, true) != ASL::kSuccess)
 						{
 							ASL::String message = dvacore::ZString("$$$/Prelude/Mezzanine/ExportLocal/Failure/CanNotMakeDir=Cannot make directory \"@0\".");
 							message = dvacore::utility::ReplaceInString(message, destPath);
 							mExportErrors.push_back(message);
 						}
 					}
+					continue;
 				}
-				else
+
+				// To fix bug #3068226, some providers don't provide normalized media path, but the dest media path should be put into pathPairs,
+				// in this case, we should compare the media path with the normalized item path from provider
+				if (normalizedItemPath == normalizedMediaPath)
 				{
-					// To fix bug #3068226, some providers don't provide normalized media path, but the dest media path should be put into pathPairs,
-					// in this case, we should compare the media path with the normalized item path from provider
-					//if (itemPath == *bf)
-					//{
-					//	pathPairs.push_back(PL::ExportUtils::PathPair(*bf, destPath));
-					//}
-					if (normalizedItemPath == normalizedMediaPath)
-					{
-						pathPairs.push_back(PL::ExportUtils::PathPair(normalizedItemPath, destPath));
-					}
+					outPathPairs.push_back(PL::ExportUtils::PathPair(normalizedItemPath, destPath));
+				}
 
-					if (ASL::PathUtils::ExistsOnDisk(destPath))
-					{
-						// Add warning for overriding
-						ASL::String message = dvacore::ZString("$$$/Prelude/Mezzanine/ExportLocal/Warning/CopyOverwrite=Overwrite \"@0\" from \"@1\".");
-						message = dvacore::utility::ReplaceInString(message, destPath, normalizedItemPath);
-						mExportWarnings.push_back(message);
-					}
-					else
+				DestinationJobMap::const_iterator plannedJob = destinationJobs.find(destPath);
+				if (plannedJob != destinationJobs.end())
+				{
+					// The sequential copy let the later source win, keep doing that.
+					CopyJob& job = mCopyJobs[plannedJob->second];
+					if (job.mSourcePath != normalizedItemPath)
 					{
-						dvacore::utility::FileUtils::EnsureDirectoryExists(ASL::PathUtils::GetFullDirectoryPart(destPath));
+						job.mSourcePath = normalizedItemPath;
+						ASL::File::SizeOnDisk(normalizedItemPath, job.mSize);
 					}
-					
-#if ASL_TARGET_OS_MAC
-					copyResult = PL::ExportUtils::CopyWithProgress(normalizedItemPath, destPath, progress_callback, &progressData);
-#else
-					copyResult = ASL::File::CopyWithProgress(normalizedItemPath, destPath, progress_callback, &progressData);
-#endif
-					
-					if (copyResult != ASL::kSuccess)
-					{
-						ASL::String message = dvacore::ZString("$$$/Prelude/Mezzanine/ExportLocal/Failure/CanNotCopyFile=Cannot copy file \"@0\" to \"@1\".");
-						message = dvacore::utility::ReplaceInString(message, normalizedItemPath, destPath);
-						mExportErrors.push_back(message);
-					} 
-				} 
-
-				// This job item finished.
-				EndProgress();
+					continue;
+				}
 
-				// Check the copy Result for one clip.
-				if (ASL::ResultFailed(copyResult))
+				if (ASL::PathUtils::ExistsOnDisk(destPath))
 				{
-					return copyResult;
+					// Add warning for overriding
+					ASL::String message = dvacore::ZString("$$$/Prelude/Mezzanine/ExportLocal/Warning/CopyOverwrite=Overwrite \"@0\" from \"@1\".");
+					message = dvacore::utility::ReplaceInString(message, destPath, normalizedItemPath);
+					mExportWarnings.push_back(message);
 				}
-				if (UpdateProgress(0))
+				else
 				{
-					return ASL::eUserCanceled;
+					dvacore::utility::FileUtils::EnsureDirectoryExists(ASL::PathUtils::GetFullDirectoryPart(destPath));
 				}
+
+				CopyJob job;
+				job.mSourcePath = normalizedItemPath;
+				job.mDestinationPath = destPath;
+				ASL::File::SizeOnDisk(normalizedItemPath, job.mSize);
+				destinationJobs.insert(DestinationJobMap::value_type(destPath, mCopyJobs.size()));
+				mCopyJobs.push_back(job);
 			}
+		}
+	}
+
+	/*
+	**	Copy one planned file, called on a copy worker thread.
+	*/
+	ASL::Result CopyPlannedFile(size_t inJobIndex, PL::ExportUtils::ExportProgressData& ioProgressData)
+	{
+		CopyJob const& job = mCopyJobs[inJobIndex];
+#if ASL_TARGET_OS_MAC
+		return PL::ExportUtils::CopyWithProgress(job.mSourcePath, job.mDestinationPath, progress_callback, &ioProgressData);
+#else
+		return ASL::File::CopyWithProgress(job.mSourcePath, job.mDestinationPath, progress_callback, &ioProgressData);
+#endif
+	}
+
+	/*
+	**	Run the planned copy jobs through a small pool of IO threads. The first failed copy stops
+	**	the rest of the export, same as the sequential copy used to.
+	*/
+	ASL::Result ExecuteCopyJobs(size_t& outFailedJob)
+	{
+		outFailedJob = mCopyJobs.size();
+		if (mPlannedMediaPaths.empty())
+		{
+			return ASL::kSuccess;
+		}
+
+		StartProgress(mPlannedMediaPaths.size(), PL::ExportUtils::kTransferProgressSteps);
+
+		std::vector<ASL::UInt64> jobSizes;
+		jobSizes.reserve(mCopyJobs.size());
+		for (CopyJobList::const_iterator job = mCopyJobs.begin(); job != mCopyJobs.end(); ++job)
+		{
+			jobSizes.push_back(job->mSize);
+		}
+
+		ASL::Result result = PL::ExportUtils::ExecuteTransferJobs(
+			"Local Export Copy",
+			kMaxCopyWorkers,
+			jobSizes,
+			boost::bind(&LocalExportLibraryItemsOperation::CopyPlannedFile, this, _2, _3),
+			boost::bind(&LocalExportLibraryItemsOperation::UpdateProgress, this, _1),
+			outFailedJob);
+
+		EndProgress();
+		return result;
+	}
+
+	ASL::Result ExportMediaFiles()
+	{
+		PL::ExportUtils::PathPairVector pathPairs;
+
+		PlanCopyJobs(pathPairs);
 
-			// The clip is exported.
-			EndProgress();
+		size_t failedJob = 0;
+		ASL::Result copyResult = ExecuteCopyJobs(failedJob);
+		if (ASL::ResultFailed(copyResult))
+		{
+			if (failedJob < mCopyJobs.size())
+			{
+				CopyJob const& job = mCopyJobs[failedJob];
+				ASL::String message = dvacore::ZString("$$$/Prelude/Mezzanine/ExportLocal/Failure/CanNotCopyFile=Cannot copy file \"@0\" to \"@1\".");
+				message = dvacore::utility::ReplaceInString(message, job.mSourcePath, job.mDestinationPath);
+				mExportErrors.push_back(message);
+			}
+			return copyResult;
+		}
 
-			// Todo: not affect to Roughcut for mediaPath of Roughcut is changed to its media path.
+		// Todo: not affect to Roughcut for mediaPath of Roughcut is changed to its media path.
+		for (std::vector<ASL::String>::const_iterator mediaPath = mPlannedMediaPaths.begin(); mediaPath != mPlannedMediaPaths.end(); ++mediaPath)
+		{
 			for (ActionResultList::iterator resultit=mActionResultList.begin(); resultit!=mActionResultList.end(); ++resultit)
 			{
-				if ((*resultit)->mFilePath == normalizedMediaPath)
+				if ((*resultit)->mFilePath == *mediaPath)
 					(*resultit)->mResult = ASL::kSuccess;
 			}
 		}
@@ -619,7 +679,14 @@ private:
 		//Modify the paths of media in project file
 		if (!mProjectFile.empty() && pathPairs.size() > 0)
 		{
-			PL::ExportUtils::ReplaceMeidaPath(mSeedPremiereProjectFile, mDestinationFolder, pathPairs);
+			ASL::Result result = PL::ExportUtils::ReplaceMeidaPath(mSeedPremiereProjectFile, mDestinationFolder, pathPairs);
+			if (ASL::ResultFailed(result))
+			{
+				ASL::String message = dvacore::ZString("$$$/Prelude/Mezzanine/ExportLocal/Failure/CanNotUpdateProject=Cannot update media paths in project file \"@0\".");
+				message = dvacore::utility::ReplaceInString(message, mProjectFile);
+				mExportErrors.push_back(message);
+				return result;
+			}
 		}
 		// Todo: now just change to success.
 		for (ActionResultList::iterator resultit=mActionResultList.begin(); resultit!=mActionResultList.end(); ++resultit)
@@ -630,6 +697,19 @@ private:
 	}
 
 private:
+	/*
+	**	One planned file copy.
+	*/
+	struct CopyJob
+	{
+		CopyJob() : mSize(0) {}
+
+		ASL::String		mSourcePath;
+		ASL::String		mDestinationPath;
+		ASL::UInt64		mSize;
+	};
+	typedef std::vector<CopyJob> CopyJobList;
+
 	ASL::String							mTitleString;
 	ASL::Result							mResult;
 	ASL::StationID						mStationID;
@@ -649,6 +729,9 @@ private:
 
 	ActionResultList					mActionResultList;
 	PL::ExportUtils::MeidaPathToExportItemMap mMediaPathToExportItems;
+
+	CopyJobList							mCopyJobs;
+	std::vector<ASL::String>			mPlannedMediaPaths;
 };
 
 // callback for CopyWithProgress: return true to continue copy, false to stop
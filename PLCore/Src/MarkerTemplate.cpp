@@ -521,13 +521,11 @@ namespace
 	{	
 		TemplateSet::iterator templateIter = templateSet.begin();
 		dvacore::UTF16String markerType;
-		PL::MarkerTypeRegistry markerTypes;
 
 		for ( ; templateIter != templateSet.end(); templateIter++)
 		{
-			markerTypes = MarkerType::GetAllMarkerTypes();
 			markerType = (templateIter->mMarker).GetType();
-			if (markerTypes.find(markerType) == markerTypes.end())
+			if (!MarkerType::IsRegisteredMarkerType(markerType))
 			{
 				MarkerType::AddMarkerToRegistry(markerType, markerType, markerType, dvacore::UTF16String());
 			}
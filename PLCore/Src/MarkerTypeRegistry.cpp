@@ -101,16 +101,80 @@ namespace
 		return outColor;
 	}
 	
-	MarkerTypeRegistry sMarkerTypeRegistry;
-	MarkerTypeNameList sMarkerTypeList;
 	ASL::StationID	   sStationID;
 	ASL::CriticalSection sCriticalSection;
-	typedef std::map<dvacore::UTF16String, dvacore::UTF16String> MarkerTypeDisplayNameMap;
-	MarkerTypeDisplayNameMap sMarkerTypeDisplayNameMap;
 
 	typedef	std::map<dvacore::UTF16String, ASL::Color> MarkerTypeDefaultNameColorMap;
 	MarkerTypeDefaultNameColorMap sMarkerTypeDefaultNameColorMap;
 
+	//	The published registry. Only replaced (never modified) while holding sCriticalSection,
+	//	read with atomic loads and no lock.
+	MarkerTypeSnapshotPtr sMarkerTypeSnapshot;
+
+	const MarkerTypeID kEmptyMarkerTypeID = 0;
+
+	MarkerTypeSnapshotPtr LoadSnapshot()
+	{
+		return boost::atomic_load(&sMarkerTypeSnapshot);
+	}
+
+	/*
+	** Copy of the published snapshot for a writer to modify. Call with sCriticalSection held.
+	*/
+	boost::shared_ptr<MarkerTypeSnapshot> CopySnapshot()
+	{
+		MarkerTypeSnapshotPtr current = LoadSnapshot();
+		boost::shared_ptr<MarkerTypeSnapshot> snapshot(
+			current ? new MarkerTypeSnapshot(*current) : new MarkerTypeSnapshot);
+		if (snapshot->mEntries.empty())
+		{
+			MarkerTypeEntry emptyEntry = MarkerTypeEntry();
+			snapshot->mEntries.push_back(emptyEntry);
+			snapshot->mTypeIDs[dvacore::UTF16String()] = kEmptyMarkerTypeID;
+		}
+		return snapshot;
+	}
+
+	void PublishSnapshot(const boost::shared_ptr<MarkerTypeSnapshot>& inSnapshot)
+	{
+		boost::atomic_store(&sMarkerTypeSnapshot, MarkerTypeSnapshotPtr(inSnapshot));
+	}
+
+	/*
+	** Get the entry for a type in a writer's copy, adding it if needed.
+	*/
+	MarkerTypeEntry& InternMarkerType(
+		MarkerTypeSnapshot& ioSnapshot,
+		const dvacore::UTF16String& inType)
+	{
+		MarkerTypeID typeID;
+		if (!ioSnapshot.FindTypeID(inType, typeID))
+		{
+			typeID = static_cast<MarkerTypeID>(ioSnapshot.mEntries.size());
+			MarkerTypeEntry entry = MarkerTypeEntry();
+			entry.mType = inType;
+			ioSnapshot.mEntries.push_back(entry);
+			ioSnapshot.mTypeIDs[inType] = typeID;
+		}
+		return ioSnapshot.mEntries[typeID];
+	}
+
+	const MarkerTypeEntry* FindRegisteredEntry(
+		const MarkerTypeSnapshot& inSnapshot,
+		const dvacore::UTF16String& inType)
+	{
+		MarkerTypeID typeID;
+		if (inSnapshot.FindTypeID(inType, typeID))
+		{
+			const MarkerTypeEntry* entry = inSnapshot.GetEntry(typeID);
+			if (entry != NULL && entry->mRegistered)
+			{
+				return entry;
+			}
+		}
+		return NULL;
+	}
+
 } // private namespace
 
 namespace MarkerType
@@ -203,14 +267,10 @@ void AddMarkerToRegistry(
 	}
 	ASL::Color aslColor(COLORREFToASLColor(storedColor));
 	
-	if (!inMarkerDisplayName.empty())
-	{
-		sMarkerTypeDisplayNameMap[inMarkerName] = inMarkerDisplayName;
-	}
-	else
-	{
-		sMarkerTypeDisplayNameMap[inMarkerName] = inMarkerName;
-	}
+	boost::shared_ptr<MarkerTypeSnapshot> snapshot = CopySnapshot();
+	InternMarkerType(*snapshot, inMarkerName).mDisplayName = 
+		!inMarkerDisplayName.empty() ? inMarkerDisplayName : inMarkerName;
+	PublishSnapshot(snapshot);
 
 	MarkerTypeHandlerInfo info = {inMarkerHandlerName, swfPath, 0, aslColor, true};
 	RegisterMarkerType(inMarkerName, info);
@@ -305,13 +365,19 @@ void RegisterMarkerType(dvacore::UTF16String markerType, MarkerTypeHandlerInfo&
 {
 	ASL::CriticalSectionLock lock(sCriticalSection);
 
-	bool isNewMarker = (sMarkerTypeRegistry.find(markerType) == sMarkerTypeRegistry.end());
-	ASL::AddOrUpdateValue(sMarkerTypeRegistry, markerType, inInfo);
-
+	boost::shared_ptr<MarkerTypeSnapshot> snapshot = CopySnapshot();
+	MarkerTypeEntry& entry = InternMarkerType(*snapshot, markerType);
+	bool isNewMarker = !entry.mRegistered;
+	entry.mInfo = inInfo;
+	entry.mRegistered = true;
 	if (isNewMarker)
 	{
-		sMarkerTypeList.push_back(markerType);
+		snapshot->mSortedTypes.push_back(markerType);
+	}
+	PublishSnapshot(snapshot);
 
+	if (isNewMarker)
+	{
 		// Refresh default template set
 		PL::MarkerTemplate::RefreshDefaultMarkerTemplateSet();
 	}
@@ -322,23 +388,33 @@ void UnregisterMarkerType(dvacore::UTF16String markerType)
 {
 	ASL::CriticalSectionLock lock(sCriticalSection);
 
-	MarkerTypeRegistry::iterator it = sMarkerTypeRegistry.find(markerType);
-	if (it == sMarkerTypeRegistry.end())
+	if (FindRegisteredEntry(*GetMarkerTypeSnapshot(), markerType) == NULL)
 		return;
 
-	sMarkerTypeRegistry.erase(it);
+	// The type keeps its ID and display name, only the registration goes away.
+	boost::shared_ptr<MarkerTypeSnapshot> snapshot = CopySnapshot();
+	MarkerTypeEntry& entry = InternMarkerType(*snapshot, markerType);
+	entry.mInfo = MarkerTypeHandlerInfo();
+	entry.mRegistered = false;
 
-	MarkerTypeNameList::iterator iter = sMarkerTypeList.begin();
-	for (; iter != sMarkerTypeList.end(); ++iter)
+	bool removedFromList = false;
+	MarkerTypeNameList::iterator iter = snapshot->mSortedTypes.begin();
+	for (; iter != snapshot->mSortedTypes.end(); ++iter)
 	{
 		if (*iter == markerType)
 		{
-			sMarkerTypeList.erase(iter);
-			// Refresh default template set
-			PL::MarkerTemplate::RefreshDefaultMarkerTemplateSet();
+			snapshot->mSortedTypes.erase(iter);
+			removedFromList = true;
 			break;
 		}
 	}
+	PublishSnapshot(snapshot);
+
+	if (removedFromList)
+	{
+		// Refresh default template set
+		PL::MarkerTemplate::RefreshDefaultMarkerTemplateSet();
+	}
 
 	ASL::StationUtils::PostMessageToUIThread(sStationID, MarkerTypeRegistryChanged());
 }
@@ -414,28 +490,105 @@ void RegisterCustomMarkerType(const dvacore::UTF16String& inLibraryFullPath)
 
 const MarkerTypeRegistry GetAllMarkerTypes()
 {
+	MarkerTypeRegistry registry;
+	MarkerTypeSnapshotPtr snapshot = GetMarkerTypeSnapshot();
+	for (MarkerTypeSnapshot::Entries::const_iterator iter = snapshot->mEntries.begin();
+		iter != snapshot->mEntries.end();
+		++iter)
+	{
+		if (iter->mRegistered)
+		{
+			registry.insert(MarkerTypeRegistry::value_type(iter->mType, iter->mInfo));
+		}
+	}
+	return registry;
+}
+
+bool IsRegisteredMarkerType(
+	const dvacore::UTF16String& inType)
+{
+	return FindRegisteredEntry(*GetMarkerTypeSnapshot(), inType) != NULL;
+}
+
+MarkerTypeSnapshotPtr GetMarkerTypeSnapshot()
+{
+	MarkerTypeSnapshotPtr snapshot = LoadSnapshot();
+	if (!snapshot)
+	{
+		// Nothing has been published yet.
+		ASL::CriticalSectionLock lock(sCriticalSection);
+		snapshot = LoadSnapshot();
+		if (!snapshot)
+		{
+			boost::shared_ptr<MarkerTypeSnapshot> emptySnapshot = CopySnapshot();
+			PublishSnapshot(emptySnapshot);
+			snapshot = emptySnapshot;
+		}
+	}
+	return snapshot;
+}
+
+MarkerTypeID GetMarkerTypeID(
+	const dvacore::UTF16String& inType)
+{
+	if (inType.empty())
+	{
+		return kEmptyMarkerTypeID;
+	}
+
+	MarkerTypeID typeID;
+	if (GetMarkerTypeSnapshot()->FindTypeID(inType, typeID))
+	{
+		return typeID;
+	}
+
+	// First time we see this type, publish a snapshot which knows it.
 	ASL::CriticalSectionLock lock(sCriticalSection);
-	return sMarkerTypeRegistry;
+	if (!GetMarkerTypeSnapshot()->FindTypeID(inType, typeID))
+	{
+		boost::shared_ptr<MarkerTypeSnapshot> snapshot = CopySnapshot();
+		InternMarkerType(*snapshot, inType);
+		snapshot->FindTypeID(inType, typeID);
+		PublishSnapshot(snapshot);
+	}
+	return typeID;
+}
+
+dvacore::UTF16String GetMarkerTypeName(
+	MarkerTypeID inTypeID)
+{
+	const MarkerTypeEntry* entry = GetMarkerTypeSnapshot()->GetEntry(inTypeID);
+	return entry != NULL ? entry->mType : dvacore::UTF16String();
 }
 
 const MarkerTypeNameList GetSortedMarkerTypes()
 {
-	ASL::CriticalSectionLock lock(sCriticalSection);
-	return sMarkerTypeList;
+	return GetMarkerTypeSnapshot()->mSortedTypes;
 }
 
 ASL::Color GetColorForType(
 	const dvacore::UTF16String& inType)
 {
-	ASL::CriticalSectionLock lock(sCriticalSection);
+	const MarkerTypeEntry* entry = FindRegisteredEntry(*GetMarkerTypeSnapshot(), inType);
+	ASL_ASSERT(entry != NULL);
+	if (entry == NULL)
+	{
+		return kDefaultMarkerColors[kNumDefaultColors-1];
+	}
+	return entry->mInfo.mColor;
+}
 
-	MarkerTypeRegistry::iterator iter = sMarkerTypeRegistry.find(inType);
-	ASL_ASSERT(iter != sMarkerTypeRegistry.end());
-	if (iter == sMarkerTypeRegistry.end())
+ASL::Color GetColorForType(
+	MarkerTypeID inTypeID)
+{
+	MarkerTypeSnapshotPtr snapshot = GetMarkerTypeSnapshot();
+	const MarkerTypeEntry* entry = snapshot->GetEntry(inTypeID);
+	ASL_ASSERT(entry != NULL && entry->mRegistered);
+	if (entry == NULL || !entry->mRegistered)
 	{
 		return kDefaultMarkerColors[kNumDefaultColors-1];
 	}
-	return iter->second.mColor;
+	return entry->mInfo.mColor;
 }
 
 bool SetColorForType(
@@ -445,12 +598,14 @@ bool SetColorForType(
 	ASL::CriticalSectionLock lock(sCriticalSection);
 
 	bool changed = false;
-	MarkerTypeRegistry::iterator iter = sMarkerTypeRegistry.find(inType);
-	ASL_ASSERT(iter != sMarkerTypeRegistry.end());
-	if (iter->second.mColor != inColor)
+	const MarkerTypeEntry* currentEntry = FindRegisteredEntry(*GetMarkerTypeSnapshot(), inType);
+	ASL_ASSERT(currentEntry != NULL);
+	if (currentEntry != NULL && currentEntry->mInfo.mColor != inColor)
 	{
 		changed = true;
-		iter->second.mColor = inColor;
+		boost::shared_ptr<MarkerTypeSnapshot> snapshot = CopySnapshot();
+		InternMarkerType(*snapshot, inType).mInfo.mColor = inColor;
+		PublishSnapshot(snapshot);
 
 		BE::IBackendRef backend = BE::GetBackend();
 		BE::IPropertiesRef bProp(backend);
@@ -464,8 +619,21 @@ bool SetColorForType(
 dvacore::UTF16String GetDisplayNameForType( 
 	const dvacore::UTF16String& inType)
 {
-	ASL::CriticalSectionLock lock(sCriticalSection);
-	return sMarkerTypeDisplayNameMap[inType];
+	MarkerTypeSnapshotPtr snapshot = GetMarkerTypeSnapshot();
+	MarkerTypeID typeID;
+	if (snapshot->FindTypeID(inType, typeID))
+	{
+		return snapshot->GetEntry(typeID)->mDisplayName;
+	}
+	return dvacore::UTF16String();
+}
+
+dvacore::UTF16String GetDisplayNameForType( 
+	MarkerTypeID inTypeID)
+{
+	MarkerTypeSnapshotPtr snapshot = GetMarkerTypeSnapshot();
+	const MarkerTypeEntry* entry = snapshot->GetEntry(inTypeID);
+	return entry != NULL ? entry->mDisplayName : dvacore::UTF16String();
 }
 
 }
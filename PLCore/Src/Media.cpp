@@ -57,6 +57,7 @@
 #include "ASLThreadManager.h"
 #include "ASLAsyncCallFromMainThread.h"
 #include "ASLStationUtils.h"
+#include "ASLCriticalSection.h"
 
 //	BE
 #include "BE/Core/INotification.h"
@@ -73,6 +74,94 @@
 namespace PL
 {
 
+namespace
+{
+
+typedef std::map<ASL::String, ASL::String> PendingMediaInfoMap;
+
+//	Custom metadata changes waiting for the next main thread turn, keyed by media path so that
+//	repeated changes to one clip collapse into its latest state. The rest of the info is read
+//	from the project at flush time so that an XMP save in between is not overwritten.
+ASL::CriticalSection sPendingMediaInfoCriticalSection;
+PendingMediaInfoMap sPendingMediaInfoChanges;
+
+/*
+**	Broadcasts everything queued since the last flush as a single MediaInfoChanged.
+*/
+void FlushPendingMediaInfoChanges()
+{
+	PendingMediaInfoMap pendingChanges;
+	{
+		ASL::CriticalSectionLock lock(sPendingMediaInfoCriticalSection);
+		pendingChanges.swap(sPendingMediaInfoChanges);
+	}
+
+	SRProject::SharedPtr project = SRProject::GetInstance();
+	if (pendingChanges.empty() || project == NULL)
+	{
+		return;
+	}
+
+	PL::AssetMediaInfoList assetMediaInfoList;
+	for (PendingMediaInfoMap::const_iterator it = pendingChanges.begin(); it != pendingChanges.end(); ++it)
+	{
+		AssetMediaInfoPtr currentAssetMediaInfo = project->GetAssetMediaInfo(it->first);
+		if (currentAssetMediaInfo == NULL || currentAssetMediaInfo->GetCustomMetadata() == it->second)
+		{
+			continue;
+		}
+
+		//	The XMP payload is shared with the current info rather than copied; only the
+		//	custom metadata differs.
+		assetMediaInfoList.push_back(PL::AssetMediaInfo::CreateMasterClipMediaInfo(
+			currentAssetMediaInfo->GetAssetMediaInfoGUID(),
+			currentAssetMediaInfo->GetMediaPath(),
+			currentAssetMediaInfo->GetAliasName(),
+			currentAssetMediaInfo->GetXMPString(),
+			it->second));
+	}
+
+	if (assetMediaInfoList.empty())
+	{
+		return;
+	}
+
+	project->GetAssetLibraryNotifier()->MediaInfoChanged(
+		ASL::Guid::CreateUnique(),
+		ASL::Guid::CreateUnique(),
+		assetMediaInfoList);
+}
+
+/*
+**	Relinking or conforming a large selection fires one change per clip; the first change of a
+**	burst schedules the flush and the rest ride along with it.
+*/
+void QueueMediaInfoChange(ASL::String const& inMediaPath, ASL::String const& inCustomMetadata)
+{
+	bool needSchedule(false);
+	{
+		ASL::CriticalSectionLock lock(sPendingMediaInfoCriticalSection);
+		needSchedule = sPendingMediaInfoChanges.empty();
+		sPendingMediaInfoChanges[inMediaPath] = inCustomMetadata;
+	}
+
+	if (needSchedule)
+	{
+		ASL::AsyncCallFromMainThread(boost::bind(&FlushPendingMediaInfoChanges));
+	}
+}
+
+/*
+**	The registry already holds this metadata, so anything still queued for the path is stale.
+*/
+void DropPendingMediaInfoChange(ASL::String const& inMediaPath)
+{
+	ASL::CriticalSectionLock lock(sPendingMediaInfoCriticalSection);
+	sPendingMediaInfoChanges.erase(inMediaPath);
+}
+
+} // namespace
+
 ASL_MESSAGE_MAP_DEFINE(SRMedia)
 	ASL_MESSAGE_HANDLER(PL::MediaMetaDataMarkerNotInSync, OnMediaMetaDataMarkerNotInSync)
 	ASL_MESSAGE_HANDLER(BE::MediaInfoChangedMessage, OnMediaInfoChanged)
@@ -81,6 +170,15 @@ ASL_MESSAGE_MAP_DEFINE(SRMedia)
 ASL_MESSAGE_MAP_END
 
 BE::IOrphanItemRef SRMedia::sOrphanItems;
+
+/*
+**
+*/
+void SRMedia::DiscardPendingMediaInfoChanges()
+{
+	ASL::CriticalSectionLock lock(sPendingMediaInfoCriticalSection);
+	sPendingMediaInfoChanges.clear();
+}
     
 /*
 **
@@ -447,8 +545,6 @@ void SRMedia::OnMediaInfoChanged()
 			AssetMediaInfoPtr oldAssetMediaInfo = 
 				SRProject::GetInstance()->GetAssetMediaInfo(mClipFilePath);
 
-			PL::AssetMediaInfoList assetMediaInfoList;
-
 			CustomMetadata customMetadata = Utilities::GetCustomMedadata(masterClip);
 
 			//	We should get duration directly from MediaInfo instead of MasterClip cause 
@@ -473,19 +569,15 @@ void SRMedia::OnMediaInfoChanged()
 			}
 
 			ASL::String customMetadataStr = Utilities::CreateCustomMetadataStr(customMetadata);
+			if (customMetadataStr == oldAssetMediaInfo->GetCustomMetadata())
+			{
+				//	Nothing a listener could observe has changed, but an earlier change may
+				//	still be queued and would broadcast the metadata we have just reverted.
+				DropPendingMediaInfoChange(oldAssetMediaInfo->GetMediaPath());
+				return;
+			}
 
-			PL::AssetMediaInfoPtr assetMediaInfo = PL::AssetMediaInfo::CreateMasterClipMediaInfo(
-				oldAssetMediaInfo->GetAssetMediaInfoGUID(),
-				oldAssetMediaInfo->GetMediaPath(),
-				oldAssetMediaInfo->GetAliasName(),
-				oldAssetMediaInfo->GetXMPString(),
-				customMetadataStr);
-			assetMediaInfoList.push_back(assetMediaInfo);
-
-			SRProject::GetInstance()->GetAssetLibraryNotifier()->MediaInfoChanged(
-				ASL::Guid::CreateUnique(),
-				ASL::Guid::CreateUnique(),
-				assetMediaInfoList);
+			QueueMediaInfoChange(oldAssetMediaInfo->GetMediaPath(), customMetadataStr);
 		}
 	}
 }
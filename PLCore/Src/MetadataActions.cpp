@@ -61,6 +61,158 @@
 namespace PL
 {
 
+namespace
+{
+
+/*
+**	Fields of a marker that an update can change, one bit each.
+*/
+enum MarkerUpdateField
+{
+	kMarkerField_StartTime		= 1 << 0,
+	kMarkerField_Duration		= 1 << 1,
+	kMarkerField_Type			= 1 << 2,
+	kMarkerField_Name			= 1 << 3,
+	kMarkerField_Comment		= 1 << 4,
+	kMarkerField_Location		= 1 << 5,
+	kMarkerField_Target			= 1 << 6,
+	kMarkerField_CuePointType	= 1 << 7,
+	kMarkerField_CuePointList	= 1 << 8,
+	kMarkerField_Speaker		= 1 << 9,
+	kMarkerField_Probability	= 1 << 10,
+	kMarkerField_Tags			= 1 << 11
+};
+
+/*
+**	Values of the changed fields of one side of a marker update. Unchanged fields stay empty.
+*/
+struct MarkerFieldValues
+{
+	dvamediatypes::TickTime						mStartTime;
+	dvamediatypes::TickTime						mDuration;
+	dvacore::UTF16String						mType;
+	dvacore::UTF16String						mName;
+	dvacore::UTF16String						mComment;
+	dvacore::UTF16String						mLocation;
+	dvacore::UTF16String						mTarget;
+	dvacore::UTF16String						mCuePointType;
+	dvatemporalxmp::CustomMarkerParamList		mCuePointList;
+	dvacore::UTF16String						mSpeaker;
+	dvacore::UTF16String						mProbability;
+	TagParamMap									mTagParams;
+};
+
+/*
+**	What an update does to one marker: the changed fields, with their new and old values.
+*/
+struct MarkerUpdateDelta
+{
+	ASL::Guid				mGUID;
+	ASL::UInt32				mChangedFields;
+	MarkerFieldValues		mNewValues;
+	MarkerFieldValues		mOldValues;
+};
+typedef std::vector<MarkerUpdateDelta> MarkerUpdateDeltaList;
+
+/*
+**	Record only the fields that differ between inNewMarker and inOldMarker.
+*/
+void BuildMarkerUpdateDelta(
+	const CottonwoodMarker& inNewMarker,
+	const CottonwoodMarker& inOldMarker,
+	MarkerUpdateDelta& outDelta)
+{
+	outDelta.mGUID = inNewMarker.GetGUID();
+	outDelta.mChangedFields = 0;
+
+#define PL_RECORD_MARKER_FIELD(inField, inGetter, inMember)			\
+	if (inNewMarker.inGetter() != inOldMarker.inGetter())			\
+	{																\
+		outDelta.mChangedFields |= inField;							\
+		outDelta.mNewValues.inMember = inNewMarker.inGetter();		\
+		outDelta.mOldValues.inMember = inOldMarker.inGetter();		\
+	}
+
+	PL_RECORD_MARKER_FIELD(kMarkerField_StartTime, GetStartTime, mStartTime)
+	PL_RECORD_MARKER_FIELD(kMarkerField_Duration, GetDuration, mDuration)
+	PL_RECORD_MARKER_FIELD(kMarkerField_Type, GetType, mType)
+	PL_RECORD_MARKER_FIELD(kMarkerField_Name, GetName, mName)
+	PL_RECORD_MARKER_FIELD(kMarkerField_Comment, GetComment, mComment)
+	PL_RECORD_MARKER_FIELD(kMarkerField_Location, GetLocation, mLocation)
+	PL_RECORD_MARKER_FIELD(kMarkerField_Target, GetTarget, mTarget)
+	PL_RECORD_MARKER_FIELD(kMarkerField_CuePointType, GetCuePointType, mCuePointType)
+	PL_RECORD_MARKER_FIELD(kMarkerField_CuePointList, GetCuePointList, mCuePointList)
+	PL_RECORD_MARKER_FIELD(kMarkerField_Speaker, GetSpeaker, mSpeaker)
+	PL_RECORD_MARKER_FIELD(kMarkerField_Probability, GetProbability, mProbability)
+
+#undef PL_RECORD_MARKER_FIELD
+
+	if (!inNewMarker.TagsEqual(inOldMarker))
+	{
+		outDelta.mChangedFields |= kMarkerField_Tags;
+		outDelta.mNewValues.mTagParams = inNewMarker.GetTagParams();
+		outDelta.mOldValues.mTagParams = inOldMarker.GetTagParams();
+	}
+}
+
+/*
+**	Write the recorded fields of inValues into ioMarker.
+*/
+void ApplyMarkerFieldValues(
+	ASL::UInt32 inChangedFields,
+	const MarkerFieldValues& inValues,
+	CottonwoodMarker& ioMarker)
+{
+#define PL_APPLY_MARKER_FIELD(inField, inSetter, inMember)			\
+	if (inChangedFields & inField)									\
+	{																\
+		ioMarker.inSetter(inValues.inMember);						\
+	}
+
+	PL_APPLY_MARKER_FIELD(kMarkerField_StartTime, SetStartTime, mStartTime)
+	PL_APPLY_MARKER_FIELD(kMarkerField_Duration, SetDuration, mDuration)
+	PL_APPLY_MARKER_FIELD(kMarkerField_Type, SetType, mType)
+	PL_APPLY_MARKER_FIELD(kMarkerField_Name, SetName, mName)
+	PL_APPLY_MARKER_FIELD(kMarkerField_Comment, SetComment, mComment)
+	PL_APPLY_MARKER_FIELD(kMarkerField_Location, SetLocation, mLocation)
+	PL_APPLY_MARKER_FIELD(kMarkerField_Target, SetTarget, mTarget)
+	PL_APPLY_MARKER_FIELD(kMarkerField_CuePointType, SetCuePointType, mCuePointType)
+	PL_APPLY_MARKER_FIELD(kMarkerField_CuePointList, SetCuePointList, mCuePointList)
+	PL_APPLY_MARKER_FIELD(kMarkerField_Speaker, SetSpeaker, mSpeaker)
+	PL_APPLY_MARKER_FIELD(kMarkerField_Probability, SetProbability, mProbability)
+	PL_APPLY_MARKER_FIELD(kMarkerField_Tags, SetTagParams, mTagParams)
+
+#undef PL_APPLY_MARKER_FIELD
+}
+
+/*
+**	Rebuild the markers of an update from the stored markers and one side of the deltas.
+**	Unchanged markers are passed on as well, so UpdateMarkers notifies the same markers as
+**	it did when the undo record held full copies.
+*/
+void BuildMarkersFromDeltas(
+	PL::ISRMarkersRef inMarkers,
+	const MarkerUpdateDeltaList& inDeltas,
+	bool inUseNewValues,
+	CottonwoodMarkerList& outMarkerList)
+{
+	outMarkerList.reserve(inDeltas.size());
+	BOOST_FOREACH(const MarkerUpdateDelta& delta, inDeltas)
+	{
+		CottonwoodMarker marker;
+		if (inMarkers->GetMarker(delta.mGUID, marker))
+		{
+			ApplyMarkerFieldValues(
+				delta.mChangedFields,
+				inUseNewValues ? delta.mNewValues : delta.mOldValues,
+				marker);
+			outMarkerList.push_back(marker);
+		}
+	}
+}
+
+}
+
 const char* kRemoveTemporalMarkersActionName = "$$$/Prelude/PL/SetMetadataAction/RemoveTemporalMarker=Remove Temporal Marker(s)";
 const ASL::String kRemoveTemporalMarkersActionID = ASL_STR("PL.MetadataActions.RemoveCottonwoodMarkers");
 
@@ -202,10 +354,17 @@ public:
 		const CottonwoodMarkerList& inOldMarkerList)
 	{
 		ASL_ASSERT(inMarkers != NULL);
+		ASL_ASSERT(inNewMarkerList.size() == inOldMarkerList.size());
 		UpdateMarkersRef updateMarkers(CreateClassRef());
 		updateMarkers->mMarkers = inMarkers;
-		updateMarkers->mNewMarkerList = inNewMarkerList;
-		updateMarkers->mOldMarkerList = inOldMarkerList;
+		updateMarkers->mDeltas.reserve(inNewMarkerList.size());
+		CottonwoodMarkerList::const_iterator newIter = inNewMarkerList.begin();
+		CottonwoodMarkerList::const_iterator oldIter = inOldMarkerList.begin();
+		for (; newIter != inNewMarkerList.end() && oldIter != inOldMarkerList.end(); ++newIter, ++oldIter)
+		{
+			updateMarkers->mDeltas.push_back(MarkerUpdateDelta());
+			BuildMarkerUpdateDelta(*newIter, *oldIter, updateMarkers->mDeltas.back());
+		}
 		return BE::IUndoableRef(updateMarkers);
 	}
 
@@ -228,7 +387,9 @@ public:
 	*/
 	virtual void Do()
 	{
-		mMarkers->UpdateMarkers(mNewMarkerList);
+		CottonwoodMarkerList newMarkerList;
+		BuildMarkersFromDeltas(mMarkers, mDeltas, true, newMarkerList);
+		mMarkers->UpdateMarkers(newMarkerList);
 	}
 
 	/*
@@ -236,7 +397,9 @@ public:
 	*/
 	virtual void Undo()
 	{
-		mMarkers->UpdateMarkers(mOldMarkerList);
+		CottonwoodMarkerList oldMarkerList;
+		BuildMarkersFromDeltas(mMarkers, mDeltas, false, oldMarkerList);
+		mMarkers->UpdateMarkers(oldMarkerList);
 	}
 
 	/*
@@ -249,8 +412,7 @@ public:
 
 private:
 	PL::ISRMarkersRef mMarkers;
-	CottonwoodMarkerList mNewMarkerList;
-	CottonwoodMarkerList mOldMarkerList;
+	MarkerUpdateDeltaList mDeltas;
 };
 
 class AssociateMarkersAction
@@ -287,19 +449,7 @@ public:
 	void Commit(BE::ITransactionRef inTransaction)
 	{
 		CottonwoodMarkerList toAddMarkers, newUpdateMarkers, oldUpdateMarkers;
-		BOOST_FOREACH(const CottonwoodMarker& newMarker, mMarkerList)
-		{
-			CottonwoodMarker oldMarker;
-			if (mMarkers->GetMarker(newMarker.GetGUID(), oldMarker))
-			{
-				newUpdateMarkers.push_back(newMarker);
-				oldUpdateMarkers.push_back(oldMarker);
-			}
-			else
-			{
-				toAddMarkers.push_back(newMarker);
-			}
-		}
+		mMarkers->PartitionMarkers(mMarkerList, toAddMarkers, newUpdateMarkers, oldUpdateMarkers);
 
 		if (!toAddMarkers.empty())
 		{
@@ -394,13 +544,14 @@ class RemoveCottonwoodMarkersAction
 
 		void InitWithMarkerSelection(const MarkerSet& inMarkerSelection)
 		{
-			mMarkerSelection = inMarkerSelection;
+			// Only the markers as stored by their owners are kept; the selection itself is
+			// not needed after this and would double the size of the undo record.
 			if (mMarkerMap.size() == 0)
 			{
 				ISRPrimaryClipPlaybackRef primaryClipPlayback = 
 					PL::ModulePicker::GetInstance()->GetLoggingClip();
 				ASL_ASSERT(primaryClipPlayback != NULL);
-				for (MarkerSet::const_iterator selectionIter = mMarkerSelection.begin(); selectionIter != mMarkerSelection.end(); ++selectionIter)
+				for (MarkerSet::const_iterator selectionIter = inMarkerSelection.begin(); selectionIter != inMarkerSelection.end(); ++selectionIter)
 				{
 					CottonwoodMarker marker;
 					PL::ISRMarkersRef markers = selectionIter->GetMarkerOwner()->GetMarkers();
@@ -414,7 +565,6 @@ class RemoveCottonwoodMarkersAction
 		}
 
 	private:
-		MarkerSet	mMarkerSelection;
 		std::map<PL::ISRMarkersRef, CottonwoodMarkerList> mMarkerMap;
 	};
 
@@ -475,6 +625,7 @@ class UpdateCottonwoodMarkerAction
 			addMarker->mMarkers = inMarkers;
 			addMarker->mOldMarker = inOldMarker;
 			addMarker->mNewMarker = inNewMarker;
+			addMarker->mNewMarker.ShareBodyIfEqual(inOldMarker);
 			return BE::IUndoableRef(addMarker);
 		}
 
@@ -656,19 +807,20 @@ void AddCottonwoodMarkers(
 
 	dvamediatypes::TickTime masterClipDuration = inMasterClip->GetMaxTrimmedDuration(BE::kMediaType_Any);
 	CottonwoodMarkerList addedMarkerList;
+	addedMarkerList.reserve(inMarkerList.size());
 	CottonwoodMarkerList::const_iterator iter = inMarkerList.begin();
 	for ( ; iter != inMarkerList.end(); ++iter)
 	{
 		//	Only paste the marker if it is not after the end of the clip
 		if (iter->GetStartTime() < masterClipDuration)
 		{
-			CottonwoodMarker marker(*iter);
+			addedMarkerList.push_back(*iter);
 			//	If the marker is too long, truncate it
+			CottonwoodMarker& marker = addedMarkerList.back();
 			if (marker.GetStartTime() + marker.GetDuration() > masterClipDuration)
 			{
 				marker.SetDuration(masterClipDuration - marker.GetStartTime());
 			}
-			addedMarkerList.push_back(marker);
 		}
 	}
 	BE::IActionRef action = BE::CreateAction(AddMarkersAction(inMasterClip, addedMarkerList, inIsSilent), true);
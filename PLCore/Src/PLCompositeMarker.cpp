@@ -30,6 +30,10 @@
 // dvacore
 #include "dvacore/config/Localizer.h"
 
+// STL
+#include <algorithm>
+#include <iterator>
+
 
 namespace PL
 {
@@ -39,8 +43,107 @@ const dvacore::UTF16String GetMultipleValuesString()
 	return dvacore::ZString("$$$/Prelude/MZ/CottonwoodCompositeMarker/MultipleValuesMessage=<Multiple Values>");
 }
 
+namespace
+{
+	/*
+	** The value shared by all markers for one field, or a flag that they differ.
+	*/
+	struct FieldSummary
+	{
+		FieldSummary()
+			:
+			mHasMultipleValues(false)
+		{
+		}
+
+		void Merge(const dvacore::UTF16String& inValue, bool inIsFirst)
+		{
+			if (inIsFirst)
+			{
+				mValue = inValue;
+			}
+			else if (!mHasMultipleValues && mValue != inValue)
+			{
+				mHasMultipleValues = true;
+			}
+		}
+
+		dvacore::UTF16String Get() const
+		{
+			return mHasMultipleValues ? GetMultipleValuesString() : mValue;
+		}
+
+		dvacore::UTF16String	mValue;
+		bool					mHasMultipleValues;
+	};
+}
+
+struct CottonwoodCompositeMarker::CompositeSummary
+{
+	CompositeSummary()
+		:
+		mMarkerCount(0),
+		mMinInPoint(dvamediatypes::kTime_Max),
+		mMaxOutPoint(dvamediatypes::kTime_Min)
+	{
+	}
+
+	void Merge(const CottonwoodMarker& inMarker)
+	{
+		bool isFirst = (mMarkerCount == 0);
+		++mMarkerCount;
+
+		mType.Merge(inMarker.GetType(), isFirst);
+		mName.Merge(inMarker.GetNameOrTheFirstKeyword(), isFirst);
+		mComment.Merge(inMarker.GetComment(), isFirst);
+		mLocation.Merge(inMarker.GetLocation(), isFirst);
+		mTarget.Merge(inMarker.GetTarget(), isFirst);
+		mCuePointType.Merge(inMarker.GetCuePointType(), isFirst);
+		mSpeaker.Merge(inMarker.GetSpeaker(), isFirst);
+		mProbability.Merge(inMarker.GetProbability(), isFirst);
+
+		mMinInPoint = std::min(mMinInPoint, inMarker.GetStartTime());
+		mMaxOutPoint = std::max(mMaxOutPoint, inMarker.GetStartTime() + inMarker.GetDuration());
+
+		// For each cue point param keep the first value seen and how many markers share it.
+		const dvatemporalxmp::CustomMarkerParamList& paramList = inMarker.GetCuePointList();
+		dvatemporalxmp::CustomMarkerParamList::const_iterator paramIter = paramList.begin();
+		for (; paramIter != paramList.end(); ++paramIter)
+		{
+			CuePointValues::iterator valueIter = mCuePointValues.find(paramIter->mKey);
+			if (valueIter == mCuePointValues.end())
+			{
+				mCuePointValues.insert(CuePointValues::value_type(paramIter->mKey, CuePointValue(paramIter->mValue, 1)));
+			}
+			else if (valueIter->second.first == paramIter->mValue)
+			{
+				valueIter->second.second++;
+			}
+		}
+	}
+
+	// first: value of the first marker having the param, second: count of markers with that value
+	typedef std::pair<dvacore::UTF16String, size_t> CuePointValue;
+	typedef std::map<dvacore::UTF16String, CuePointValue> CuePointValues;
+
+	size_t					mMarkerCount;
+	FieldSummary			mType;
+	FieldSummary			mName;
+	FieldSummary			mComment;
+	FieldSummary			mLocation;
+	FieldSummary			mTarget;
+	FieldSummary			mCuePointType;
+	FieldSummary			mSpeaker;
+	FieldSummary			mProbability;
+	dvamediatypes::TickTime	mMinInPoint;
+	dvamediatypes::TickTime	mMaxOutPoint;
+	CuePointValues			mCuePointValues;
+};
+
 CottonwoodCompositeMarker::CottonwoodCompositeMarker(
 	const PL::MarkerSet & inMarkerSelection) 
+	:
+	mHasPlaceholderMarker(false)
 {
 	mMarkerList = PL::BuildMarkersFromSelection(inMarkerSelection);
 
@@ -48,6 +151,7 @@ CottonwoodCompositeMarker::CottonwoodCompositeMarker(
 	if (mMarkerList.empty())
 	{
 		mMarkerList.push_back(CottonwoodMarker());
+		mHasPlaceholderMarker = true;
 	}
 }
 
@@ -55,6 +159,141 @@ CottonwoodCompositeMarker::~CottonwoodCompositeMarker()
 {
 }
 
+CottonwoodCompositeMarker::CottonwoodCompositeMarker(
+	const CottonwoodCompositeMarker& inOther)
+	:
+	mMarkerList(inOther.mMarkerList),
+	mHasPlaceholderMarker(inOther.mHasPlaceholderMarker)
+{
+	if (inOther.mSummary)
+	{
+		mSummary.reset(new CompositeSummary(*inOther.mSummary));
+	}
+}
+
+CottonwoodCompositeMarker& CottonwoodCompositeMarker::operator=(
+	const CottonwoodCompositeMarker& inOther)
+{
+	if (this != &inOther)
+	{
+		mMarkerList = inOther.mMarkerList;
+		mHasPlaceholderMarker = inOther.mHasPlaceholderMarker;
+		mSummary.reset(inOther.mSummary ? new CompositeSummary(*inOther.mSummary) : NULL);
+	}
+	return *this;
+}
+
+const CottonwoodCompositeMarker::CompositeSummary& CottonwoodCompositeMarker::GetSummary() const
+{
+	if (!mSummary)
+	{
+		mSummary.reset(new CompositeSummary);
+		BOOST_FOREACH(CottonwoodMarker const& eachMarker, mMarkerList)
+		{
+			mSummary->Merge(eachMarker);
+		}
+	}
+	return *mSummary;
+}
+
+void CottonwoodCompositeMarker::InvalidateSummary()
+{
+	mSummary.reset();
+}
+
+void CottonwoodCompositeMarker::AddMarkers(
+	const PL::MarkerSet& inAddedMarkers)
+{
+	PL::CottonwoodMarkerList addedMarkers = PL::BuildMarkersFromSelection(inAddedMarkers);
+	if (addedMarkers.empty())
+	{
+		return;
+	}
+
+	// Drop the placeholder marker pushed when the selection was empty.
+	if (mHasPlaceholderMarker)
+	{
+		mMarkerList.clear();
+		mHasPlaceholderMarker = false;
+		InvalidateSummary();
+	}
+
+	std::set<ASL::Guid> markerIDs;
+	BOOST_FOREACH(CottonwoodMarker const& eachMarker, mMarkerList)
+	{
+		markerIDs.insert(eachMarker.GetGUID());
+	}
+
+	BOOST_FOREACH(CottonwoodMarker const& eachMarker, addedMarkers)
+	{
+		if (!markerIDs.insert(eachMarker.GetGUID()).second)
+		{
+			continue;
+		}
+		mMarkerList.push_back(eachMarker);
+		if (mSummary)
+		{
+			mSummary->Merge(eachMarker);
+		}
+	}
+}
+
+void CottonwoodCompositeMarker::RemoveMarkers(
+	const PL::MarkerSet& inRemovedMarkers)
+{
+	if (inRemovedMarkers.empty())
+	{
+		return;
+	}
+
+	PL::CottonwoodMarkerList remainingMarkers;
+	BOOST_FOREACH(CottonwoodMarker const& eachMarker, mMarkerList)
+	{
+		if (inRemovedMarkers.find(eachMarker) == inRemovedMarkers.end())
+		{
+			remainingMarkers.push_back(eachMarker);
+		}
+	}
+
+	if (remainingMarkers.size() != mMarkerList.size())
+	{
+		mMarkerList.swap(remainingMarkers);
+		if (mMarkerList.empty())
+		{
+			mMarkerList.push_back(CottonwoodMarker());
+			mHasPlaceholderMarker = true;
+		}
+		InvalidateSummary();
+	}
+}
+
+void CottonwoodCompositeMarker::SyncWithSelection(
+	const PL::MarkerSet& inMarkerSelection)
+{
+	PL::MarkerSet currentMarkers;
+	if (!mHasPlaceholderMarker)
+	{
+		currentMarkers.insert(mMarkerList.begin(), mMarkerList.end());
+	}
+
+	PL::MarkerSet removedMarkers;
+	std::set_difference(
+		currentMarkers.begin(), currentMarkers.end(),
+		inMarkerSelection.begin(), inMarkerSelection.end(),
+		std::inserter(removedMarkers, removedMarkers.end()),
+		PL::CottonwoodMarkerSort());
+
+	PL::MarkerSet addedMarkers;
+	std::set_difference(
+		inMarkerSelection.begin(), inMarkerSelection.end(),
+		currentMarkers.begin(), currentMarkers.end(),
+		std::inserter(addedMarkers, addedMarkers.end()),
+		PL::CottonwoodMarkerSort());
+
+	RemoveMarkers(removedMarkers);
+	AddMarkers(addedMarkers);
+}
+
 
 dvamediatypes::TickTime CottonwoodCompositeMarker::GetStartTime() const
 {
@@ -76,13 +315,7 @@ dvamediatypes::TickTime CottonwoodCompositeMarker::GetMinInPoint() const
 		return dvamediatypes::kTime_Zero;
 	}
 
-	dvamediatypes::TickTime minInPoint = dvamediatypes::kTime_Max;
-	BOOST_FOREACH(CottonwoodMarker const& eachMarker, mMarkerList)
-	{
-		minInPoint = std::min(minInPoint, eachMarker.GetStartTime());
-	}
-
-	return minInPoint;
+	return GetSummary().mMinInPoint;
 }
 
 dvamediatypes::TickTime CottonwoodCompositeMarker::GetMaxOutPoint() const
@@ -93,13 +326,7 @@ dvamediatypes::TickTime CottonwoodCompositeMarker::GetMaxOutPoint() const
 		return dvamediatypes::kTime_Invalid;
 	}
 
-	dvamediatypes::TickTime maxOutPoint = dvamediatypes::kTime_Min;
-	BOOST_FOREACH(CottonwoodMarker const& eachMarker, mMarkerList)
-	{
-		maxOutPoint = std::max(maxOutPoint, (eachMarker.GetStartTime() + eachMarker.GetDuration()));
-	}
-
-	return maxOutPoint;
+	return GetSummary().mMaxOutPoint;
 }
 
 ASL::Guid CottonwoodCompositeMarker::GetGUID() const
@@ -130,40 +357,18 @@ dvacore::UTF16String CottonwoodCompositeMarker::GetGUIDList() const
 dvacore::UTF16String CottonwoodCompositeMarker::GetType() const
 {
 	DVA_ASSERT(mMarkerList.size() > 0);
-	PL::CottonwoodMarkerList::const_iterator currentIter = mMarkerList.begin();
-	bool allMatch = true;
-	dvacore::UTF16String typeString = currentIter->GetType();
-
-	// should hit end at the same time, only check one
-	for (; allMatch && (currentIter != mMarkerList.end()); ++currentIter)	
-	{
-		if (typeString != currentIter->GetType())
-		{
-			typeString = dvacore::ZString("$$$/Prelude/MZ/CottonwoodCompositeMarker/MultipleValuesMessage=<Multiple Values>");
-			allMatch = false;
-		}
-	}
-	return typeString;
+	return GetSummary().mType.Get();
 }
 
 dvacore::UTF16String CottonwoodCompositeMarker::GetName() const
 {
 	DVA_ASSERT(mMarkerList.size() > 0);
-	PL::CottonwoodMarkerList::const_iterator currentIter = mMarkerList.begin();
-	bool allMatch = true;
-	dvacore::UTF16String nameString = currentIter->GetNameOrTheFirstKeyword();
-
-	// should hit end at the same time, only check one
-	for (; allMatch && (currentIter != mMarkerList.end()); ++currentIter)	
+	const CompositeSummary& summary = GetSummary();
+	if (summary.mName.mHasMultipleValues)
 	{
-		if (nameString != currentIter->GetNameOrTheFirstKeyword())
-		{
-			nameString = dvacore::ZString("$$$/Prelude/PLCore/CottonwoodCompositeMarker/MultipleValuesMessage=<Multiple Values>");
-			allMatch = false;
-		}
+		return dvacore::ZString("$$$/Prelude/PLCore/CottonwoodCompositeMarker/MultipleValuesMessage=<Multiple Values>");
 	}
-
-	return nameString;
+	return summary.mName.mValue;
 }
 
 
@@ -175,21 +380,7 @@ bool CottonwoodCompositeMarker::HasMultipleMarkers() const
 
 bool CottonwoodCompositeMarker::HasMultipleMarkerTypes() const
 {
-	bool hasMultipleMarkerTypes = false;
-
-	if (!mMarkerList.empty())
-	{
-		PL::CottonwoodMarkerList::const_iterator currentIter = mMarkerList.begin();
-		dvacore::UTF16String	markerType = currentIter->GetType();
-		// should hit end at the same time, only check one
-		for (; !hasMultipleMarkerTypes && (currentIter != mMarkerList.end()); ++currentIter)
-		{
-				// if guid changes they are different markers, if type changes we need to rebuild list item
-			hasMultipleMarkerTypes = (markerType!= currentIter->GetType());
-		}
-	}
-
-	return hasMultipleMarkerTypes;
+	return !mMarkerList.empty() && GetSummary().mType.mHasMultipleValues;
 }
 
 void CottonwoodCompositeMarker::SetStartTime(
@@ -201,6 +392,7 @@ void CottonwoodCompositeMarker::SetStartTime(
 	{
 		currentIter->SetStartTime(inTime);
 	}
+	InvalidateSummary();
 }
 
 void CottonwoodCompositeMarker::SetDuration(
@@ -212,6 +404,7 @@ void CottonwoodCompositeMarker::SetDuration(
 	{
 		currentIter->SetDuration(inTime);
 	}
+	InvalidateSummary();
 }
 
 void CottonwoodCompositeMarker::SetType(
@@ -223,6 +416,7 @@ void CottonwoodCompositeMarker::SetType(
 	{
 		currentIter->SetType(inType);
 	}
+	InvalidateSummary();
 }
 
 void CottonwoodCompositeMarker::SetName(
@@ -234,6 +428,7 @@ void CottonwoodCompositeMarker::SetName(
 	{
 		currentIter->SetName(inName);
 	}
+	InvalidateSummary();
 }
 
 void CottonwoodCompositeMarker::SetComment(
@@ -245,6 +440,7 @@ void CottonwoodCompositeMarker::SetComment(
 	{
 		currentIter->SetComment(inComment);
 	}
+	InvalidateSummary();
 }
 
 void CottonwoodCompositeMarker::SetLocation(
@@ -256,6 +452,7 @@ void CottonwoodCompositeMarker::SetLocation(
 	{
 		currentIter->SetLocation(inLocation);
 	}
+	InvalidateSummary();
 }
 
 void CottonwoodCompositeMarker::SetTarget(
@@ -267,6 +464,7 @@ void CottonwoodCompositeMarker::SetTarget(
 	{
 		currentIter->SetTarget(inTarget);
 	}
+	InvalidateSummary();
 }
 
 void CottonwoodCompositeMarker::SetCuePointType(
@@ -278,6 +476,7 @@ void CottonwoodCompositeMarker::SetCuePointType(
 	{
 		currentIter->SetCuePointType(inCuePointType);
 	}
+	InvalidateSummary();
 }
 
 void CottonwoodCompositeMarker::SetCuePointList(
@@ -285,6 +484,7 @@ void CottonwoodCompositeMarker::SetCuePointList(
 {
 	DVA_ASSERT(mMarkerList.size() > 0);
 	mMarkerList[0].SetCuePointList(inCuePointList);
+	InvalidateSummary();
 }
 
 void CottonwoodCompositeMarker::SetSpeaker(
@@ -296,6 +496,7 @@ void CottonwoodCompositeMarker::SetSpeaker(
 	{
 		currentIter->SetSpeaker(inSpeaker);
 	}
+	InvalidateSummary();
 }
 
 void CottonwoodCompositeMarker::SetProbability(
@@ -307,86 +508,31 @@ void CottonwoodCompositeMarker::SetProbability(
 	{
 		currentIter->SetProbability(inProbability);
 	}
+	InvalidateSummary();
 }
 
 dvacore::UTF16String CottonwoodCompositeMarker::GetComment() const
 {
 	DVA_ASSERT(mMarkerList.size() > 0);
-	bool allMatch = true;
-	PL::CottonwoodMarkerList::const_iterator currentIter = mMarkerList.begin();
-	dvacore::UTF16String returnString = currentIter->GetComment();
-
-	// should hit end at the same time, only check one
-	for (; allMatch && (currentIter != mMarkerList.end()); ++currentIter)	
-	{
-		if (returnString != currentIter->GetComment())
-		{
-			returnString = dvacore::ZString("$$$/Prelude/MZ/CottonwoodCompositeMarker/MultipleValuesMessage=<Multiple Values>");
-			allMatch = false;
-		}
-	}
-
-	return returnString;
+	return GetSummary().mComment.Get();
 }
 
 dvacore::UTF16String CottonwoodCompositeMarker::GetLocation() const
 {
 	DVA_ASSERT(mMarkerList.size() > 0);
-	bool allMatch = true;
-	PL::CottonwoodMarkerList::const_iterator currentIter = mMarkerList.begin();
-	dvacore::UTF16String returnString = currentIter->GetLocation();
-
-	// should hit end at the same time, only check one
-	for (; allMatch && (currentIter != mMarkerList.end()); ++currentIter)	
-	{
-		if (returnString != currentIter->GetLocation())
-		{
-			returnString = dvacore::ZString("$$$/Prelude/MZ/CottonwoodCompositeMarker/MultipleValuesMessage=<Multiple Values>");
-			allMatch = false;
-		}
-	}
-
-	return returnString;
+	return GetSummary().mLocation.Get();
 }
 
 dvacore::UTF16String CottonwoodCompositeMarker::GetTarget() const
 {
 	DVA_ASSERT(mMarkerList.size() > 0);
-	bool allMatch = true;
-	PL::CottonwoodMarkerList::const_iterator currentIter = mMarkerList.begin();
-	dvacore::UTF16String returnString = currentIter->GetTarget();
-
-	// should hit end at the same time, only check one
-	for (; allMatch && (currentIter != mMarkerList.end()); ++currentIter)	
-	{
-		if (returnString != currentIter->GetTarget())
-		{
-			returnString = dvacore::ZString("$$$/Prelude/MZ/CottonwoodCompositeMarker/MultipleValuesMessage=<Multiple Values>");
-			allMatch = false;
-		}
-	}
-
-	return returnString;
+	return GetSummary().mTarget.Get();
 }
 
 dvacore::UTF16String CottonwoodCompositeMarker::GetCuePointType() const
 {
 	DVA_ASSERT(mMarkerList.size() > 0);
-	bool allMatch = true;
-	PL::CottonwoodMarkerList::const_iterator currentIter = mMarkerList.begin();
-	dvacore::UTF16String returnString = currentIter->GetCuePointType();
-
-	// should hit end at the same time, only check one
-	for (; allMatch && (currentIter != mMarkerList.end()); ++currentIter)	
-	{
-		if (returnString != currentIter->GetCuePointType())
-		{
-			returnString = dvacore::ZString("$$$/Prelude/MZ/CottonwoodCompositeMarker/MultipleValuesMessage=<Multiple Values>");
-			allMatch = false;
-		}
-	}
-
-	return returnString;
+	return GetSummary().mCuePointType.Get();
 }
 
 const dvatemporalxmp::CustomMarkerParamList CottonwoodCompositeMarker::GetCuePointList() const
@@ -405,93 +551,34 @@ const dvatemporalxmp::CustomMarkerParamList CottonwoodCompositeMarker::GetCuePoi
 		return mMarkerList[0].GetCuePointList();
 	}
 
-	// Loop through all the cuepoint params for each marker in the marker list.
-	// For each unique param found, keep track of the count of how many times the same value
-	// is encountered. At the end of the loop, construct the return param list
-	// by looping through the param values map and setting the corresponding value in the param list to the
-	// actual value only if the counts for the param equals the number of markers (all markers
-	// have the same value for the param). Otherwise, set the param value to the
-	// multiple value string.
-
-	PL::CottonwoodMarkerList::const_iterator currentIter = mMarkerList.begin();
-	std::map<dvacore::UTF16String, dvacore::UTF16String> currentFieldValues;
-	std::map<dvacore::UTF16String, int> equalValuesCount;
-
-	dvatemporalxmp::CustomMarkerParamList currentParamList;
-	dvatemporalxmp::CustomMarkerParamList::iterator currentParamIter;
-	for (; currentIter != mMarkerList.end(); ++currentIter)	
+	// The summary keeps, for each unique param, the first value found and how many markers
+	// have that same value. A param gets its actual value only if all markers share it,
+	// otherwise the multiple value string.
+	const CompositeSummary& summary = GetSummary();
+	CompositeSummary::CuePointValues::const_iterator fieldValuesIter = summary.mCuePointValues.begin();
+	for (; fieldValuesIter != summary.mCuePointValues.end(); fieldValuesIter++)
 	{
-		currentParamList = currentIter->GetCuePointList();
-		for (currentParamIter = currentParamList.begin(); currentParamIter != currentParamList.end(); currentParamIter++)
-		{
-			if (currentFieldValues.find(currentParamIter->mKey) == currentFieldValues.end())
-			{
-				currentFieldValues[currentParamIter->mKey] = currentParamIter->mValue;
-				equalValuesCount[currentParamIter->mKey] = 1;
-			}		
-			else if (currentFieldValues[currentParamIter->mKey] == currentParamIter->mValue)
-			{
-				equalValuesCount[currentParamIter->mKey] ++;
-			}
-		}
-	}
-
-	// Construct return param list
-	dvatemporalxmp::CustomMarkerParamList returnParamList;
-	std::map<dvacore::UTF16String, dvacore::UTF16String>::iterator fieldValuesIter = currentFieldValues.begin();
-
-	for (; fieldValuesIter != currentFieldValues.end(); fieldValuesIter++)
-	{
-		// Replace values with the actual string here if the count is 
-		// equal to the number of markers.
 		dvatemporalxmp::CustomMarkerParam newParam(fieldValuesIter->first, GetMultipleValuesString());
-		if (equalValuesCount[fieldValuesIter->first] == mMarkerList.size())
+		if (fieldValuesIter->second.second == summary.mMarkerCount)
 		{
-			newParam.mValue = fieldValuesIter->second;
+			newParam.mValue = fieldValuesIter->second.first;
 		}
-		returnParamList.push_back(newParam);
+		paramList.push_back(newParam);
 	}
 
-	return returnParamList;
+	return paramList;
 }
 
 dvacore::UTF16String CottonwoodCompositeMarker::GetSpeaker() const
 {
 	DVA_ASSERT(mMarkerList.size() > 0);
-	bool allMatch = true;
-	PL::CottonwoodMarkerList::const_iterator currentIter = mMarkerList.begin();
-	dvacore::UTF16String returnString = currentIter->GetSpeaker();
-
-	// should hit end at the same time, only check one
-	for (; allMatch && (currentIter != mMarkerList.end()); ++currentIter)	
-	{
-		if (returnString != currentIter->GetSpeaker())
-		{
-			returnString = dvacore::ZString("$$$/Prelude/MZ/CottonwoodCompositeMarker/MultipleValuesMessage=<Multiple Values>");
-			allMatch = false;
-		}
-	}
-	return returnString;
+	return GetSummary().mSpeaker.Get();
 }
 
 dvacore::UTF16String CottonwoodCompositeMarker::GetProbability() const
 {
 	DVA_ASSERT(mMarkerList.size() > 0);
-	bool allMatch = true;
-	PL::CottonwoodMarkerList::const_iterator currentIter = mMarkerList.begin();
-	dvacore::UTF16String returnString = currentIter->GetProbability();
-
-	// should hit end at the same time, only check one
-	for (; allMatch && (currentIter != mMarkerList.end()); ++currentIter)	
-	{
-		if (returnString != currentIter->GetProbability())
-		{
-			returnString = dvacore::ZString("$$$/Prelude/MZ/CottonwoodCompositeMarker/MultipleValuesMessage=<Multiple Values>");
-			allMatch = false;
-		}
-	}
-
-	return returnString;
+	return GetSummary().mProbability.Get();
 }
 
 dvacore::UTF8String CottonwoodCompositeMarker::ToPropertyXML() const
@@ -246,10 +246,58 @@ void TagParam::FromProperty(ASL::Guid const& inGuid, dvacore::proplist::PropList
 }
 
 ////// cottonwoodMarker
-    
+
+struct CottonwoodMarker::MarkerBody
+{
+	MarkerBody()
+		:
+		mTypeID(0)
+	{
+	}
+
+	/*
+	** Tags are mutable through their shared pointers, so a cloned body always gets its own tag instances.
+	*/
+	MarkerBody(const MarkerBody& inBody, bool inMakeUniqueTags)
+		:
+		mTypeID(inBody.mTypeID),
+		mName(inBody.mName),
+		mComment(inBody.mComment),
+		mLocation(inBody.mLocation),
+		mTarget(inBody.mTarget),
+		mCuePointType(inBody.mCuePointType),
+		mCuePointList(inBody.mCuePointList),
+		mSpeaker(inBody.mSpeaker),
+		mProbability(inBody.mProbability)
+	{
+		for (TagParamMap::const_iterator it = inBody.mTagParams.begin();
+			it != inBody.mTagParams.end();
+			it++)
+		{
+			mTagParams.insert(TagParamMap::value_type(it->first, TagParamPtr(new TagParam(*(it->second), inMakeUniqueTags))));
+		}
+	}
+
+	MarkerTypeID					mTypeID;
+	dvacore::UTF16String			mName;
+	dvacore::UTF16String			mComment;
+	dvacore::UTF16String			mLocation;
+	dvacore::UTF16String			mTarget;
+	dvacore::UTF16String			mCuePointType;
+	dvatemporalxmp::CustomMarkerParamList	mCuePointList;
+	dvacore::UTF16String			mSpeaker;
+	dvacore::UTF16String			mProbability;
+	TagParamMap						mTagParams;
+
+private:
+	MarkerBody(const MarkerBody&);
+	MarkerBody& operator =(const MarkerBody&);
+};
+
 CottonwoodMarker::CottonwoodMarker()
     :
-	mGUID(ASL::Guid::CreateUnique())
+	mGUID(ASL::Guid::CreateUnique()),
+	mBody(new MarkerBody)
 {
     
 }
@@ -257,6 +305,7 @@ CottonwoodMarker::CottonwoodMarker()
 CottonwoodMarker::CottonwoodMarker(PL::SRMarkerOwnerWeakRef inMarkerOwner)
 	:
 	mGUID(ASL::Guid::CreateUnique()),
+	mBody(new MarkerBody),
     mMarkerOwner(inMarkerOwner)
 {
 }
@@ -264,27 +313,21 @@ CottonwoodMarker::CottonwoodMarker(PL::SRMarkerOwnerWeakRef inMarkerOwner)
 CottonwoodMarker::CottonwoodMarker(
 	const CottonwoodMarker& inMarker,
 	bool inMakeUnique)
+	:
+	mStartTime(inMarker.mStartTime),
+	mDuration(inMarker.mDuration),
+	mMarkerOwner(inMarker.mMarkerOwner)
 {
 	mGUID = inMakeUnique ? ASL::Guid::CreateUnique() : inMarker.mGUID;
-	mStartTime = inMarker.mStartTime;
-	mDuration = inMarker.mDuration;
-	mType = inMarker.mType;
-	mName = inMarker.mName;
-	mComment = inMarker.mComment;
-	mLocation = inMarker.mLocation;
-	mTarget = inMarker.mTarget;
-	mCuePointType = inMarker.mCuePointType;
-	mCuePointList = inMarker.mCuePointList;
-	mSpeaker = inMarker.mSpeaker;
-	mProbability = inMarker.mProbability;
-	mMarkerOwner = inMarker.mMarkerOwner;
-
-	for (TagParamMap::const_iterator it = inMarker.GetTagParams().begin();
-		it != inMarker.GetTagParams().end();
-		it++)
+
+	// Unique tag instances need a body of their own, otherwise the body can be shared.
+	if (inMakeUnique)
 	{
-		TagParamPtr newInstanceTag(new TagParam(*((*it).second), inMakeUnique));
-		AddTagParam(newInstanceTag);
+		mBody.reset(new MarkerBody(inMarker.GetBody(), true));
+	}
+	else
+	{
+		mBody = inMarker.mBody;
 	}
 }
 
@@ -301,30 +344,28 @@ CottonwoodMarker& CottonwoodMarker::operator =(const CottonwoodMarker& inRHS)
 	mGUID = inRHS.mGUID;
 	mStartTime = inRHS.mStartTime;
 	mDuration = inRHS.mDuration;
-	mType = inRHS.mType;
-	mName = inRHS.mName;
-	mComment = inRHS.mComment;
-	mLocation = inRHS.mLocation;
-	mTarget = inRHS.mTarget;
-	mCuePointType = inRHS.mCuePointType;
-	mCuePointList = inRHS.mCuePointList;
-	mSpeaker = inRHS.mSpeaker;
-	mProbability = inRHS.mProbability;
-
-	mTagParams.clear();
-	for (TagParamMap::const_iterator it = inRHS.GetTagParams().begin();
-		it != inRHS.GetTagParams().end();
-		it++)
-	{
-		TagParamPtr newInstanceTag(new TagParam(*(it->second), false));
-		AddTagParam(newInstanceTag);
-	}
-
+	mBody = inRHS.mBody;
 	mMarkerOwner = inRHS.mMarkerOwner;
 
 	return *this;
 }
 
+const CottonwoodMarker::MarkerBody& CottonwoodMarker::GetBody() const
+{
+	DVA_ASSERT(mBody);
+	return *mBody;
+}
+
+CottonwoodMarker::MarkerBody& CottonwoodMarker::GetMutableBody()
+{
+	DVA_ASSERT(mBody);
+	if (!mBody.unique())
+	{
+		mBody.reset(new MarkerBody(*mBody, false));
+	}
+	return *mBody;
+}
+
 void CottonwoodMarker::SerializeToString(
 	const CottonwoodMarkerList& inMarkerList,
 	dvacore::UTF16String& outString)
@@ -348,29 +389,31 @@ void CottonwoodMarker::SerializeToString(
 		iter = inMarkerList.begin();
 		for ( ; iter != inMarkerList.end(); ++iter)
 		{
+			const MarkerBody& body = iter->GetBody();
 			ASL::String guid = iter->mGUID.AsString();
 			buffer << guid.size() << ASL::ENDL << guid;
 			buffer << iter->mStartTime.GetTicks() << ASL::ENDL;
 			buffer << iter->mDuration.GetTicks() << ASL::ENDL;
-			buffer << iter->mComment.size() << ASL::ENDL << iter->mComment;
-			buffer << iter->mLocation.size() << ASL::ENDL << iter->mLocation;
-			buffer << iter->mName.size() << ASL::ENDL << iter->mName;
-			buffer << iter->mProbability.size() << ASL::ENDL << iter->mProbability;
-			buffer << iter->mSpeaker.size() << ASL::ENDL << iter->mSpeaker;
-			buffer << iter->mTarget.size() << ASL::ENDL << iter->mTarget;
-			buffer << iter->mType.size() << ASL::ENDL << iter->mType;
-			buffer << iter->mCuePointType.size() << ASL::ENDL << iter->mCuePointType;
-			buffer << iter->mCuePointList.size() << ASL::ENDL;
-			for (size_t i = 0; i < iter->mCuePointList.size(); ++i)
+			buffer << body.mComment.size() << ASL::ENDL << body.mComment;
+			buffer << body.mLocation.size() << ASL::ENDL << body.mLocation;
+			buffer << body.mName.size() << ASL::ENDL << body.mName;
+			buffer << body.mProbability.size() << ASL::ENDL << body.mProbability;
+			buffer << body.mSpeaker.size() << ASL::ENDL << body.mSpeaker;
+			buffer << body.mTarget.size() << ASL::ENDL << body.mTarget;
+			dvacore::UTF16String type = MarkerType::GetMarkerTypeName(body.mTypeID);
+			buffer << type.size() << ASL::ENDL << type;
+			buffer << body.mCuePointType.size() << ASL::ENDL << body.mCuePointType;
+			buffer << body.mCuePointList.size() << ASL::ENDL;
+			for (size_t i = 0; i < body.mCuePointList.size(); ++i)
 			{
-				buffer << iter->mCuePointList[i].mKey.size() << ASL::ENDL << iter->mCuePointList[i].mKey;
-				buffer << iter->mCuePointList[i].mValue.size() << ASL::ENDL << iter->mCuePointList[i].mValue;
+				buffer << body.mCuePointList[i].mKey.size() << ASL::ENDL << body.mCuePointList[i].mKey;
+				buffer << body.mCuePointList[i].mValue.size() << ASL::ENDL << body.mCuePointList[i].mValue;
 			}
 
 			// serialize out tag params
-			buffer << iter->mTagParams.size() << ASL::ENDL;
-			for (TagParamMap::const_iterator it = iter->mTagParams.begin();
-				it != iter->mTagParams.end();
+			buffer << body.mTagParams.size() << ASL::ENDL;
+			for (TagParamMap::const_iterator it = body.mTagParams.begin();
+				it != body.mTagParams.end();
 				it++)
 			{
 				(*it).second->SerializeOut(buffer);
@@ -402,6 +445,7 @@ void CottonwoodMarker::SerializeFromString(
 	for (size_t i = 0; i < count; ++i)
 	{
 		CottonwoodMarker marker;
+		MarkerBody& body = marker.GetMutableBody();
 		size_t stringLength;
 		
 		std::getline(buffer, line);
@@ -428,49 +472,49 @@ void CottonwoodMarker::SerializeFromString(
 		stringLength = std::min(ASL::Coercion<size_t>::Result(line), static_cast<size_t>(kMaxBufferLength - 1));
 		buffer.read(buf, stringLength);
 		buf[stringLength] = 0;
-		marker.mComment = ASL::String(buf);
+		body.mComment = ASL::String(buf);
 
 		std::getline(buffer, line);
 		stringLength = std::min(ASL::Coercion<size_t>::Result(line), static_cast<size_t>(kMaxBufferLength - 1));
 		buffer.read(buf, stringLength);
 		buf[stringLength] = 0;
-		marker.mLocation = ASL::String(buf);
+		body.mLocation = ASL::String(buf);
 
 		std::getline(buffer, line);
 		stringLength = std::min(ASL::Coercion<size_t>::Result(line), static_cast<size_t>(kMaxBufferLength - 1));
 		buffer.read(buf, stringLength);
 		buf[stringLength] = 0;
-		marker.mName = ASL::String(buf);
+		body.mName = ASL::String(buf);
 
 		std::getline(buffer, line);
 		stringLength = std::min(ASL::Coercion<size_t>::Result(line), static_cast<size_t>(kMaxBufferLength - 1));
 		buffer.read(buf, stringLength);
 		buf[stringLength] = 0;
-		marker.mProbability = ASL::String(buf);
+		body.mProbability = ASL::String(buf);
 
 		std::getline(buffer, line);
 		stringLength = std::min(ASL::Coercion<size_t>::Result(line), static_cast<size_t>(kMaxBufferLength - 1));
 		buffer.read(buf, stringLength);
 		buf[stringLength] = 0;
-		marker.mSpeaker = ASL::String(buf);
+		body.mSpeaker = ASL::String(buf);
 
 		std::getline(buffer, line);
 		stringLength = std::min(ASL::Coercion<size_t>::Result(line), static_cast<size_t>(kMaxBufferLength - 1));
 		buffer.read(buf, stringLength);
 		buf[stringLength] = 0;
-		marker.mTarget = ASL::String(buf);
+		body.mTarget = ASL::String(buf);
 
 		std::getline(buffer, line);
 		stringLength = std::min(ASL::Coercion<size_t>::Result(line), static_cast<size_t>(kMaxBufferLength - 1));
 		buffer.read(buf, stringLength);
 		buf[stringLength] = 0;
-		marker.mType = ASL::String(buf);
+		body.mTypeID = MarkerType::GetMarkerTypeID(ASL::String(buf));
 
 		std::getline(buffer, line);
 		stringLength = std::min(ASL::Coercion<size_t>::Result(line), static_cast<size_t>(kMaxBufferLength - 1));
 		buffer.read(buf, stringLength);
 		buf[stringLength] = 0;
-		marker.mCuePointType = ASL::String(buf);
+		body.mCuePointType = ASL::String(buf);
 		
 		std::getline(buffer, line);
 		size_t cuePointCount = ASL::Coercion<size_t>::Result(line);
@@ -489,7 +533,7 @@ void CottonwoodMarker::SerializeFromString(
 			buf[stringLength] = 0;
 			dvacore::UTF16String value = ASL::String(buf);
         
-			marker.mCuePointList.push_back(dvatemporalxmp::CustomMarkerParam(key, value));
+			body.mCuePointList.push_back(dvatemporalxmp::CustomMarkerParam(key, value));
 		}
 
 		std::getline(buffer, line);
@@ -518,12 +562,17 @@ dvamediatypes::TickTime CottonwoodMarker::GetDuration() const
 
 dvacore::UTF16String CottonwoodMarker::GetType() const
 {
-	return mType;
+	return MarkerType::GetMarkerTypeName(GetBody().mTypeID);
+}
+
+MarkerTypeID CottonwoodMarker::GetTypeID() const
+{
+	return GetBody().mTypeID;
 }
 
 dvacore::UTF16String CottonwoodMarker::GetName() const
 {
-	return mName;
+	return GetBody().mName;
 }
 
 /**
@@ -531,14 +580,15 @@ dvacore::UTF16String CottonwoodMarker::GetName() const
 */
 dvacore::UTF16String CottonwoodMarker::GetNameOrTheFirstKeyword() const
 {
-	if (!mName.empty())
+	const MarkerBody& body = GetBody();
+	if (!body.mName.empty())
 	{
-		return mName;
+		return body.mName;
 	}
 
-	if (!mTagParams.empty())
+	if (!body.mTagParams.empty())
 	{
-		return (*(mTagParams.begin())).second->GetName();
+		return (*(body.mTagParams.begin())).second->GetName();
 	}
 
 	return dvacore::UTF16String();
@@ -549,11 +599,12 @@ dvacore::UTF16String CottonwoodMarker::GetSummary() const
 {
 	dvacore::UTF16String summary;
 
-	dvacore::UTF16String commentStr = mComment;
-	dvacore::UTF16String nameStr = GetName();
-	dvacore::UTF16String theFirstTagName = mTagParams.empty() ? 
+	const MarkerBody& body = GetBody();
+	dvacore::UTF16String commentStr = body.mComment;
+	dvacore::UTF16String nameStr = body.mName;
+	dvacore::UTF16String theFirstTagName = body.mTagParams.empty() ? 
 										dvacore::UTF16String() : 
-										(*(mTagParams.begin())).second->GetName();
+										(*(body.mTagParams.begin())).second->GetName();
 
 	// Remove spaces, tabs, and newlines from the beginning of the strings
 	commentStr.erase(0, commentStr.find_first_not_of(DVA_STR(" \t\n\r")));
@@ -585,13 +636,13 @@ dvacore::UTF16String CottonwoodMarker::GetSummary() const
 		}
 		else
 		{
-			summary = !commentStr.empty() ? commentStr : MarkerType::GetDisplayNameForType(mType);
+			summary = !commentStr.empty() ? commentStr : MarkerType::GetDisplayNameForType(body.mTypeID);
 		}
 	}
 	else
 	{
-		if (mType == MarkerType::kInOutMarkerType ||
-			mType == MarkerType::kSpeechMarkerType)
+		if (body.mTypeID == MarkerType::GetMarkerTypeID(MarkerType::kInOutMarkerType) ||
+			body.mTypeID == MarkerType::GetMarkerTypeID(MarkerType::kSpeechMarkerType))
 		{
 			summary = nameStr;
 		}
@@ -632,90 +683,90 @@ void CottonwoodMarker::SetDuration(
 void CottonwoodMarker::SetType(
 	const dvacore::UTF16String& inType)
 {
-	mType = inType;
+	GetMutableBody().mTypeID = MarkerType::GetMarkerTypeID(inType);
 }
 
 void CottonwoodMarker::SetName(
 	const dvacore::UTF16String& inName)
 {
-	mName = inName;
+	GetMutableBody().mName = inName;
 }
 
 void CottonwoodMarker::SetComment(
 	const dvacore::UTF16String& inComment)
 {
-	mComment = inComment;
+	GetMutableBody().mComment = inComment;
 }
 
 void CottonwoodMarker::SetLocation(
 	const dvacore::UTF16String& inLocation)
 {
-	mLocation = inLocation;
+	GetMutableBody().mLocation = inLocation;
 }
 
 void CottonwoodMarker::SetTarget(
 	const dvacore::UTF16String& inTarget)
 {
-	mTarget = inTarget;
+	GetMutableBody().mTarget = inTarget;
 }
 
 void CottonwoodMarker::SetCuePointType(
 	const dvacore::UTF16String& inCuePointType)
 {
-	mCuePointType = inCuePointType;
+	GetMutableBody().mCuePointType = inCuePointType;
 }
 
 void CottonwoodMarker::SetCuePointList(
 	const dvatemporalxmp::CustomMarkerParamList& inCuePointList)
 {
-	mCuePointList = inCuePointList;
+	GetMutableBody().mCuePointList = inCuePointList;
 }
 
 void CottonwoodMarker::SetSpeaker(
 	const dvacore::UTF16String& inSpeaker)
 {
-	mSpeaker = inSpeaker;
+	GetMutableBody().mSpeaker = inSpeaker;
 }
 
 void CottonwoodMarker::SetProbability(
 	const dvacore::UTF16String& inProbability)
 {
-	mProbability = inProbability;
+	GetMutableBody().mProbability = inProbability;
 }
 
 dvacore::UTF16String CottonwoodMarker::GetComment() const
 {
-	return mComment;
+	return GetBody().mComment;
 }
 
 dvacore::UTF16String CottonwoodMarker::GetLocation() const
 {
-	return mLocation;
+	return GetBody().mLocation;
 }
 
 dvacore::UTF16String CottonwoodMarker::GetTarget() const
 {
-	return mTarget;
+	return GetBody().mTarget;
 }
 
 dvacore::UTF16String CottonwoodMarker::GetCuePointType() const
 {
-	return mCuePointType;
+	return GetBody().mCuePointType;
 }
 
 const dvatemporalxmp::CustomMarkerParamList& CottonwoodMarker::GetCuePointList() const
 {
-	return mCuePointList;
+	return GetBody().mCuePointList;
 }
 
 dvacore::UTF16String CottonwoodMarker::GetSpeaker() const
 {
-	return mSpeaker;
+	return GetBody().mSpeaker;
 }
 
 dvacore::UTF16String CottonwoodMarker::GetProbability() const
 {
-	return mProbability;
+	return GetBody().mProbability;
 }
 
 bool CottonwoodMarker::operator ==(const CottonwoodMarker& inRHS) const
@@ -724,35 +775,63 @@ bool CottonwoodMarker::operator ==(const CottonwoodMarker& inRHS) const
 
 	if (mGUID != inRHS.mGUID ||
 		mStartTime != inRHS.mStartTime ||
-		mDuration != inRHS.mDuration ||
-		mType != inRHS.mType ||
-		mName != inRHS.mName ||
-		mComment != inRHS.mComment ||
-		mLocation != inRHS.mLocation ||
-		mTarget != inRHS.mTarget ||
-		mCuePointType != inRHS.mCuePointType ||
-		mCuePointList.size() != inRHS.mCuePointList.size() ||
-		// This will return false if the two cuePointLists have the same data, but in different orders
-		mCuePointList != inRHS.mCuePointList ||
-		mSpeaker != inRHS.mSpeaker ||
-		mProbability != inRHS.mProbability ||
-		!TagsEqual(inRHS))
+		mDuration != inRHS.mDuration)
+	{
+		result = false;
+	}
+	else if (!BodyEquals(inRHS))
 	{
 		result = false;
 	}
 	return result;
 }
 
+bool CottonwoodMarker::BodyEquals(const CottonwoodMarker& inMarker) const
+{
+	// Markers sharing a body are equal by construction, so only compare fields otherwise.
+	if (mBody == inMarker.mBody)
+	{
+		return true;
+	}
+
+	const MarkerBody& lhs = GetBody();
+	const MarkerBody& rhs = inMarker.GetBody();
+	return !(lhs.mTypeID != rhs.mTypeID ||
+		lhs.mName != rhs.mName ||
+		lhs.mComment != rhs.mComment ||
+		lhs.mLocation != rhs.mLocation ||
+		lhs.mTarget != rhs.mTarget ||
+		lhs.mCuePointType != rhs.mCuePointType ||
+		lhs.mCuePointList.size() != rhs.mCuePointList.size() ||
+		// This will return false if the two cuePointLists have the same data, but in different orders
+		lhs.mCuePointList != rhs.mCuePointList ||
+		lhs.mSpeaker != rhs.mSpeaker ||
+		lhs.mProbability != rhs.mProbability ||
+		!TagsEqual(inMarker));
+}
+
+bool CottonwoodMarker::ShareBodyIfEqual(const CottonwoodMarker& inMarker)
+{
+	if (!BodyEquals(inMarker))
+	{
+		return false;
+	}
+	mBody = inMarker.mBody;
+	return true;
+}
+
 bool CottonwoodMarker::TagsEqual(const CottonwoodMarker& inMarker) const
 {
-	if (mTagParams.size() != inMarker.mTagParams.size())
+	const TagParamMap& lhsTags = GetBody().mTagParams;
+	const TagParamMap& rhsTags = inMarker.GetBody().mTagParams;
+	if (lhsTags.size() != rhsTags.size())
 	{
 		return false;
 	}
 
-	TagParamMap::const_iterator itL = mTagParams.begin();
-	TagParamMap::const_iterator itR = inMarker.mTagParams.begin();
-	for (; itL != mTagParams.end(); itL++, itR++)
+	TagParamMap::const_iterator itL = lhsTags.begin();
+	TagParamMap::const_iterator itR = rhsTags.begin();
+	for (; itL != lhsTags.end(); itL++, itR++)
 	{
 		if (!(*((*itL).second) == *((*itR).second)))
 		{
@@ -770,22 +849,24 @@ bool CottonwoodMarker::operator <(const CottonwoodMarker& inRHS) const
 
 void CottonwoodMarker::AddTagParam(const TagParamPtr& inTagParam)
 {
-	if (mTagParams.empty())
+	TagParamMap& tagParams = GetMutableBody().mTagParams;
+	if (tagParams.empty())
 	{
-		mTagParams.insert(TagParamMap::value_type(0, inTagParam));
+		tagParams.insert(TagParamMap::value_type(0, inTagParam));
 	}
 	else
 	{
 		// User may do some delete operations, so the index of every item is not guaranteed to be sequential,
 		//	so the new item's index should be incremental from the last item's index
-		mTagParams.insert(TagParamMap::value_type((*mTagParams.rbegin()).first + 1, inTagParam));
+		tagParams.insert(TagParamMap::value_type((*tagParams.rbegin()).first + 1, inTagParam));
 	}
 }
 
 void CottonwoodMarker::RemoveTagParamByInstanceGuid(const ASL::Guid& inInstanceGuid)
 {
-	TagParamMap::iterator it = mTagParams.begin();
-	for (; it != mTagParams.end(); it++)
+	const TagParamMap& sharedTagParams = GetBody().mTagParams;
+	TagParamMap::const_iterator it = sharedTagParams.begin();
+	for (; it != sharedTagParams.end(); it++)
 	{
 		if ((*it).second->GetInstanceGuid() == inInstanceGuid)
 		{
@@ -793,15 +874,22 @@ void CottonwoodMarker::RemoveTagParamByInstanceGuid(const ASL::Guid& inInstanceG
 		}
 	}
 
-	if (it != mTagParams.end())
+	// Only detach the body when there is something to remove.
+	if (it != sharedTagParams.end())
 	{
-		mTagParams.erase(it);
+		std::uint64_t tagIndex = (*it).first;
+		GetMutableBody().mTagParams.erase(tagIndex);
 	}
 }
 
+void CottonwoodMarker::SetTagParams(const TagParamMap& inTagParams)
+{
+	GetMutableBody().mTagParams = inTagParams;
+}
+
 const TagParamMap& CottonwoodMarker::GetTagParams() const
 {
-	return mTagParams;
+	return GetBody().mTagParams;
 }
 
 dvacore::UTF8String CottonwoodMarker::ToPropertyXML() const
@@ -823,7 +911,7 @@ dvacore::UTF8String CottonwoodMarker::ToPropertyXML() const
 	// Loop through cue point params list and add key/value 
 	// pairs to the property sub list
 	dvacore::proplist::PropList* paramsSubList = propertyList.NewSubList(kMarker_CuePointParams);
-	dvatemporalxmp::CustomMarkerParamList paramsList = GetCuePointList();
+	const dvatemporalxmp::CustomMarkerParamList& paramsList = GetCuePointList();
 	dvatemporalxmp::CustomMarkerParamList::size_type i;
 	dvacore::UTF16String key;
 	dvacore::UTF16String value;
@@ -871,17 +959,19 @@ dvacore::UTF16String CottonwoodMarker::ToPropertyXML(dvamediatypes::FrameRate co
 	// Loop through cue point params list and add key/value 
 	// pairs to the property sub list
 	dvacore::proplist::PropList* paramsSubList = propertyList.NewSubList(kMarker_CuePointParams);
-	for (dvatemporalxmp::CustomMarkerParamList::size_type i=0; i < mCuePointList.size(); ++i)
+	const dvatemporalxmp::CustomMarkerParamList& cuePointList = GetBody().mCuePointList;
+	for (dvatemporalxmp::CustomMarkerParamList::size_type i=0; i < cuePointList.size(); ++i)
 	{
-		dvacore::UTF16String key = mCuePointList[i].mKey;
-		dvacore::UTF16String value = mCuePointList[i].mValue;
+		const dvacore::UTF16String& key = cuePointList[i].mKey;
+		const dvacore::UTF16String& value = cuePointList[i].mValue;
 		paramsSubList->SetValue(dvacore::utility::UTF16to8(key), dvacore::utility::UTF16to8(value));
 	}
 
 	// serialize tag params
 	dvacore::proplist::PropList* tagListSubList = propertyList.NewSubList(kMarker_TagList);
-	for (TagParamMap::const_iterator it = mTagParams.begin();
-		it != mTagParams.end();
+	const TagParamMap& tagParams = GetBody().mTagParams;
+	for (TagParamMap::const_iterator it = tagParams.begin();
+		it != tagParams.end();
 		it++)
 	{
 		it->second->ToProperty(tagListSubList);
@@ -940,8 +1030,7 @@ bool CottonwoodMarker::FromPropertyXML(dvacore::UTF16String const& inPropertyXML
 				SetType(value);
 				// Check if the type is in the Marker Type Registry.
 				// If not, register the type
-				MarkerTypeRegistry types = MarkerType::GetAllMarkerTypes();
-				if (types.find(value) == types.end())
+				if (!MarkerType::IsRegisteredMarkerType(value))
 				{
 					MarkerType::AddMarkerToRegistry(value, value, value, dvacore::UTF16String());
 				}
@@ -1010,9 +1099,10 @@ bool CottonwoodMarker::FromPropertyXML(dvacore::UTF16String const& inPropertyXML
 					continue;
 				}
 
+				dvatemporalxmp::CustomMarkerParamList& cuePointList = GetMutableBody().mCuePointList;
 				bool found = false;
-				dvatemporalxmp::CustomMarkerParamList::iterator cuePointIter = mCuePointList.begin();
-				for (; cuePointIter != mCuePointList.end(); cuePointIter++)
+				dvatemporalxmp::CustomMarkerParamList::iterator cuePointIter = cuePointList.begin();
+				for (; cuePointIter != cuePointList.end(); cuePointIter++)
 				{
 					if ((*cuePointIter).mKey == param)
 					{
@@ -1024,7 +1114,7 @@ bool CottonwoodMarker::FromPropertyXML(dvacore::UTF16String const& inPropertyXML
 				if (!found)
 				{
                     dvatemporalxmp::CustomMarkerParam newParam(param, paramValue);
-					mCuePointList.push_back(newParam);
+					cuePointList.push_back(newParam);
 				}
 				else
 				{
@@ -1034,7 +1124,7 @@ bool CottonwoodMarker::FromPropertyXML(dvacore::UTF16String const& inPropertyXML
 					}
 					else
 					{
-						mCuePointList.erase(cuePointIter);
+						cuePointList.erase(cuePointIter);
 					}
 				}
 			}
@@ -1051,9 +1141,11 @@ bool CottonwoodMarker::FromPropertyXML(dvacore::UTF16String const& inPropertyXML
 			for (; tagIDsIter != tagIDsIterEnd; ++tagIDsIter)
 			{
 				ASL::Guid tagID(dvacore::utility::UTF8to16(*tagIDsIter));
+				// The tag is modified in place below, so it must belong to our own body.
+				PL::TagParamMap& tagParams = GetMutableBody().mTagParams;
 				TagParamPtr changedTag;
-				PL::TagParamMap::iterator tagMapIter = mTagParams.begin();
-				for (; tagMapIter != mTagParams.end(); ++tagMapIter)
+				PL::TagParamMap::iterator tagMapIter = tagParams.begin();
+				for (; tagMapIter != tagParams.end(); ++tagMapIter)
 				{
 					if (tagMapIter->second->GetInstanceGuid() == tagID)
 					{
@@ -1106,11 +1198,11 @@ ASL::Color CottonwoodMarker::GetColor() const
 
 	if (isTagColorForMarker)
 	{
-		PL::TagParamMap paramMap = GetTagParams();
+		const PL::TagParamMap& paramMap = GetTagParams();
 		TagParamPtr tag;
 
 		// Get first valid tags
-		for (TagParamMap::iterator it = paramMap.begin(); it != paramMap.end(); it++)
+		for (TagParamMap::const_iterator it = paramMap.begin(); it != paramMap.end(); it++)
 		{
 			if(it->second)
 			{
@@ -1125,7 +1217,7 @@ ASL::Color CottonwoodMarker::GetColor() const
 		}
 	}
 	
-	return PL::MarkerType::GetColorForType(GetType());
+	return PL::MarkerType::GetColorForType(GetTypeID());
 }
 
 }
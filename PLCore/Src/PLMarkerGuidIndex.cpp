@@ -0,0 +1,221 @@
+/*******************************************************************/
+/*                                                                 */
+/*                      ADOBE CONFIDENTIAL                         */
+/*                   _ _ _ _ _ _ _ _ _ _ _ _ _                     */
+/*                                                                 */
+/* Copyright 2014 Adobe Systems Incorporated                       */
+/* All Rights Reserved.                                            */
+/*                                                                 */
+/* NOTICE:  All information contained herein is, and remains the   */
+/* property of Adobe Systems Incorporated and its suppliers, if    */
+/* any.  The intellectual and technical concepts contained         */
+/* herein are proprietary to Adobe Systems Incorporated and its    */
+/* suppliers and may be covered by U.S. and Foreign Patents,       */
+/* patents in process, and are protected by trade secret or        */
+/* copyright law.  Dissemination of this information or            */
+/* reproduction of this material is strictly forbidden unless      */
+/* prior written permission is obtained from Adobe Systems         */
+/* Incorporated.                                                   */
+/*                                                                 */
+/*******************************************************************/
+
+#include "Prefix.h"
+
+//	Local
+#include "PLMarkerGuidIndex.h"
+
+//	STL
+#include <algorithm>
+
+namespace PL
+{
+
+MarkerGuidIndex::SharedPtr MarkerGuidIndex::sMarkerGuidIndex;
+
+/*
+**
+*/
+void MarkerGuidIndex::Initialize()
+{
+	if (sMarkerGuidIndex == NULL)
+	{
+		sMarkerGuidIndex.reset(new MarkerGuidIndex());
+	}
+}
+
+/*
+**
+*/
+void MarkerGuidIndex::Terminate()
+{
+	sMarkerGuidIndex.reset();
+}
+
+/*
+**
+*/
+MarkerGuidIndex::SharedPtr MarkerGuidIndex::GetInstance()
+{
+	return sMarkerGuidIndex;
+}
+
+/*
+**
+*/
+MarkerGuidIndex::MarkerGuidIndex()
+{
+}
+
+/*
+**
+*/
+void MarkerGuidIndex::AddMarker(
+	const ASL::Guid& inMarkerID,
+	const MarkerSet& inOwnerMarkers,
+	const ASL::String& inMediaPath,
+	bool inIsUnassociated)
+{
+	ASL::CriticalSectionLock lock(mCriticalSection);
+	AddMarkerNoLock(inMarkerID, inOwnerMarkers, inMediaPath, inIsUnassociated);
+}
+
+/*
+**
+*/
+void MarkerGuidIndex::AddMarkers(
+	const CottonwoodMarkerList& inMarkers,
+	const MarkerSet& inOwnerMarkers,
+	const ASL::String& inMediaPath,
+	bool inIsUnassociated)
+{
+	ASL::CriticalSectionLock lock(mCriticalSection);
+	for (CottonwoodMarkerList::const_iterator it = inMarkers.begin(); it != inMarkers.end(); ++it)
+	{
+		AddMarkerNoLock(it->GetGUID(), inOwnerMarkers, inMediaPath, inIsUnassociated);
+	}
+}
+
+/*
+**
+*/
+void MarkerGuidIndex::AddMarkerNoLock(
+	const ASL::Guid& inMarkerID,
+	const MarkerSet& inOwnerMarkers,
+	const ASL::String& inMediaPath,
+	bool inIsUnassociated)
+{
+	OwnerList& owners = mOwners[inMarkerID];
+	if (std::find(owners.begin(), owners.end(), &inOwnerMarkers) != owners.end())
+	{
+		return;
+	}
+	owners.push_back(&inOwnerMarkers);
+
+	OwnerInfos::iterator infoIter = mOwnerInfos.find(&inOwnerMarkers);
+	if (infoIter == mOwnerInfos.end())
+	{
+		OwnerInfo info;
+		info.mMediaPath = inMediaPath;
+		info.mIsUnassociated = inIsUnassociated;
+		info.mMarkerCount = 0;
+		infoIter = mOwnerInfos.insert(OwnerInfos::value_type(&inOwnerMarkers, info)).first;
+	}
+	else if (infoIter->second.mMediaPath != inMediaPath)
+	{
+		infoIter->second.mMediaPath = inMediaPath;
+	}
+	++infoIter->second.mMarkerCount;
+}
+
+/*
+**
+*/
+void MarkerGuidIndex::RemoveMarker(
+	const ASL::Guid& inMarkerID,
+	const MarkerSet& inOwnerMarkers)
+{
+	ASL::CriticalSectionLock lock(mCriticalSection);
+	RemoveMarkerNoLock(inMarkerID, inOwnerMarkers);
+}
+
+/*
+**
+*/
+void MarkerGuidIndex::RemoveMarkers(const MarkerSet& inOwnerMarkers)
+{
+	ASL::CriticalSectionLock lock(mCriticalSection);
+	for (MarkerSet::const_iterator it = inOwnerMarkers.begin(); it != inOwnerMarkers.end(); ++it)
+	{
+		RemoveMarkerNoLock(it->GetGUID(), inOwnerMarkers);
+	}
+}
+
+/*
+**
+*/
+void MarkerGuidIndex::RemoveMarkerNoLock(
+	const ASL::Guid& inMarkerID,
+	const MarkerSet& inOwnerMarkers)
+{
+	MarkerOwners::iterator ownerIter = mOwners.find(inMarkerID);
+	if (ownerIter == mOwners.end())
+	{
+		return;
+	}
+
+	OwnerList& owners = ownerIter->second;
+	OwnerList::iterator it = std::find(owners.begin(), owners.end(), &inOwnerMarkers);
+	if (it == owners.end())
+	{
+		return;
+	}
+
+	owners.erase(it);
+	if (owners.empty())
+	{
+		mOwners.erase(ownerIter);
+	}
+
+	OwnerInfos::iterator infoIter = mOwnerInfos.find(&inOwnerMarkers);
+	if (infoIter != mOwnerInfos.end() && --infoIter->second.mMarkerCount == 0)
+	{
+		mOwnerInfos.erase(infoIter);
+	}
+}
+
+/*
+**
+*/
+bool MarkerGuidIndex::HasMarker(const ASL::Guid& inMarkerID) const
+{
+	ASL::CriticalSectionLock lock(mCriticalSection);
+	return mOwners.find(inMarkerID) != mOwners.end();
+}
+
+/*
+**
+*/
+void MarkerGuidIndex::GetMediaPaths(
+	const ASL::Guid& inMarkerID,
+	MarkerMediaPathSet& outMediaPaths) const
+{
+	ASL::CriticalSectionLock lock(mCriticalSection);
+
+	MarkerOwners::const_iterator ownerIter = mOwners.find(inMarkerID);
+	if (ownerIter == mOwners.end())
+	{
+		return;
+	}
+
+	const OwnerList& owners = ownerIter->second;
+	for (OwnerList::const_iterator it = owners.begin(); it != owners.end(); ++it)
+	{
+		OwnerInfos::const_iterator infoIter = mOwnerInfos.find(*it);
+		if (infoIter != mOwnerInfos.end() && !infoIter->second.mIsUnassociated)
+		{
+			outMediaPaths.insert(infoIter->second.mMediaPath);
+		}
+	}
+}
+
+}
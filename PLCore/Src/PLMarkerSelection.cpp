@@ -23,6 +23,7 @@
 #include "PLMarkerSelection.h"
 #include "PLMessage.h"
 #include "PLConstants.h"
+#include "PLMarkerGuidIndex.h"
 
 //  ASL
 #include "ASLStationUtils.h"
@@ -71,7 +72,7 @@ namespace PL
 		{
 			if (!IsMarkerSelected(marker))
 			{
-				mMarkerSelection.insert(marker.GetGUID().AsString());
+				mMarkerSelection.insert(marker.GetGUID());
 				mMRUMarkerGUID = marker.GetGUID();
 				selectionChanged = true;
 			}
@@ -117,7 +118,7 @@ namespace PL
 		{
 			if (IsMarkerSelected(marker))
 			{
-				mMarkerSelection.erase(marker.GetGUID().AsString());
+				mMarkerSelection.erase(marker.GetGUID());
 				mMRUMarkerGUID = ASL::Guid();
 				selectionChanged = true;
 			}
@@ -146,7 +147,7 @@ namespace PL
     bool SRMarkerSelection::IsMarkerSelected(
                                   const PL::CottonwoodMarker& inMarker)
     {
-        return mMarkerSelection.find(inMarker.GetGUID().AsString()) != mMarkerSelection.end();
+        return mMarkerSelection.find(inMarker.GetGUID()) != mMarkerSelection.end();
     }
     
     /*
@@ -155,23 +156,60 @@ namespace PL
     PL::MarkerSet SRMarkerSelection::GetMarkerSelection() const
     {
         PL::MarkerSet MarkerSet;
-        if (mPrimaryClipPlayback)
+        if (mPrimaryClipPlayback && !mMarkerSelection.empty())
         {
+            // Key the playback's markers by media path once, then let the project-wide
+            // GUID index name the owners of each selected marker, so resolving a
+            // selection does not probe every clip for every GUID.
+            typedef std::map<ASL::String, ISRMarkersRef> MediaPathMarkersMap;
+            MediaPathMarkersMap markersByMediaPath;
+
             const PL::SRMarkersList& srMarkerList = mPrimaryClipPlayback->GetMarkersList();
-            
-            BOOST_FOREACH (ASL::String markerGuid, mMarkerSelection)
+            BOOST_FOREACH (ISRMarkersRef const& srMarkers, srMarkerList)
             {
-                SRMarkersList::const_iterator markerEnd = srMarkerList.end();
-                SRMarkersList::const_iterator markerItr = srMarkerList.begin();
-                for (; markerItr != markerEnd; ++markerItr)
+                if (srMarkers)
+                {
+                    markersByMediaPath.insert(std::make_pair(srMarkers->GetMediaPath(), srMarkers));
+                }
+            }
+
+            MarkerMediaPathSet mediaPaths;
+            MarkerGuidIndex::SharedPtr markerGuidIndex = MarkerGuidIndex::GetInstance();
+            BOOST_FOREACH (ASL::Guid const& markerGuid, mMarkerSelection)
+            {
+                mediaPaths.clear();
+                if (markerGuidIndex)
+                {
+                    markerGuidIndex->GetMediaPaths(markerGuid, mediaPaths);
+                }
+
+                bool found = false;
+                BOOST_FOREACH (ASL::String const& mediaPath, mediaPaths)
                 {
+                    MediaPathMarkersMap::const_iterator markersItr = markersByMediaPath.find(mediaPath);
                     CottonwoodMarker marker;
-                    if ( (*markerItr)->GetMarker(ASL::Guid(markerGuid), marker) )
+                    if (markersItr != markersByMediaPath.end() && markersItr->second->GetMarker(markerGuid, marker))
                     {
                         MarkerSet.insert(marker);
+                        found = true;
                         break;
                     }
                 }
+
+                // The index can miss markers it has not been told about yet; fall back
+                // to asking every clip of the playback.
+                if (!found)
+                {
+                    BOOST_FOREACH (ISRMarkersRef const& srMarkers, srMarkerList)
+                    {
+                        CottonwoodMarker marker;
+                        if (srMarkers && srMarkers->GetMarker(markerGuid, marker))
+                        {
+                            MarkerSet.insert(marker);
+                            break;
+                        }
+                    }
+                }
             }
         }
         
@@ -0,0 +1,281 @@
+/*******************************************************************/
+/*                                                                 */
+/*                      ADOBE CONFIDENTIAL                         */
+/*                   _ _ _ _ _ _ _ _ _ _ _ _ _                     */
+/*                                                                 */
+/* Copyright 2014 Adobe Systems Incorporated                       */
+/* All Rights Reserved.                                            */
+/*                                                                 */
+/* NOTICE:  All information contained herein is, and remains the   */
+/* property of Adobe Systems Incorporated and its suppliers, if    */
+/* any.  The intellectual and technical concepts contained         */
+/* herein are proprietary to Adobe Systems Incorporated and its    */
+/* suppliers and may be covered by U.S. and Foreign Patents,       */
+/* patents in process, and are protected by trade secret or        */
+/* copyright law.  Dissemination of this information or            */
+/* reproduction of this material is strictly forbidden unless      */
+/* prior written permission is obtained from Adobe Systems         */
+/* Incorporated.                                                   */
+/*                                                                 */
+/*******************************************************************/
+
+#include "Prefix.h"
+
+//	Local
+#include "PLMarkerTextIndex.h"
+
+//	PL
+#include "PLMarkerTypeRegistry.h"
+
+//	DVA
+#include "dvacore/utility/StringUtils.h"
+
+//	STL
+#include <algorithm>
+#include <iterator>
+
+namespace PL
+{
+
+namespace
+{
+	const size_t kTrigramLength = 3;
+
+	void AddToPostingList(std::vector<std::uint32_t>& ioPostings, std::uint32_t inSlot)
+	{
+		std::vector<std::uint32_t>::iterator it = std::lower_bound(ioPostings.begin(), ioPostings.end(), inSlot);
+		if (it == ioPostings.end() || *it != inSlot)
+		{
+			ioPostings.insert(it, inSlot);
+		}
+	}
+
+	//	Returns true when the list became empty.
+	bool RemoveFromPostingList(std::vector<std::uint32_t>& ioPostings, std::uint32_t inSlot)
+	{
+		std::vector<std::uint32_t>::iterator it = std::lower_bound(ioPostings.begin(), ioPostings.end(), inSlot);
+		if (it != ioPostings.end() && *it == inSlot)
+		{
+			ioPostings.erase(it);
+		}
+		return ioPostings.empty();
+	}
+}
+
+MarkerTextIndex::MarkerTextIndex()
+{
+}
+
+MarkerTextIndex::~MarkerTextIndex()
+{
+}
+
+void MarkerTextIndex::Clear()
+{
+	mSlots.clear();
+	mSlotGUIDs.clear();
+	mFreeSlots.clear();
+	mPostings.clear();
+	mTypes.clear();
+}
+
+void MarkerTextIndex::CollectTrigrams(
+	const dvacore::UTF16String& inFoldedText,
+	std::vector<Trigram>& outTrigrams) const
+{
+	for (size_t i = 0; i + kTrigramLength <= inFoldedText.size(); ++i)
+	{
+		outTrigrams.push_back(
+			(static_cast<Trigram>(inFoldedText[i]) << 32) |
+			(static_cast<Trigram>(inFoldedText[i + 1]) << 16) |
+			static_cast<Trigram>(inFoldedText[i + 2]));
+	}
+}
+
+/*
+**	Fields are folded one at a time, so a trigram never spans two fields and a filter can only
+**	match inside a single field like it does when fields are searched one by one.
+*/
+void MarkerTextIndex::CollectTrigrams(
+	const CottonwoodMarker& inMarker,
+	std::vector<Trigram>& outTrigrams) const
+{
+	CollectTrigrams(dvacore::utility::LowerCase(inMarker.GetComment()), outTrigrams);
+	CollectTrigrams(dvacore::utility::LowerCase(inMarker.GetName()), outTrigrams);
+	CollectTrigrams(dvacore::utility::LowerCase(inMarker.GetLocation()), outTrigrams);
+	CollectTrigrams(dvacore::utility::LowerCase(inMarker.GetProbability()), outTrigrams);
+	CollectTrigrams(dvacore::utility::LowerCase(inMarker.GetSpeaker()), outTrigrams);
+	CollectTrigrams(dvacore::utility::LowerCase(inMarker.GetTarget()), outTrigrams);
+	CollectTrigrams(dvacore::utility::LowerCase(inMarker.GetCuePointType()), outTrigrams);
+
+	const dvatemporalxmp::CustomMarkerParamList& cuePoints = inMarker.GetCuePointList();
+	for (size_t i = 0; i < cuePoints.size(); ++i)
+	{
+		CollectTrigrams(dvacore::utility::LowerCase(cuePoints[i].mValue), outTrigrams);
+	}
+
+	const TagParamMap& tagParams = inMarker.GetTagParams();
+	for (TagParamMap::const_iterator it = tagParams.begin(); it != tagParams.end(); ++it)
+	{
+		CollectTrigrams(dvacore::utility::LowerCase((*it).second->GetName()), outTrigrams);
+		CollectTrigrams(dvacore::utility::LowerCase((*it).second->GetPayload()), outTrigrams);
+	}
+
+	std::sort(outTrigrams.begin(), outTrigrams.end());
+	outTrigrams.erase(std::unique(outTrigrams.begin(), outTrigrams.end()), outTrigrams.end());
+}
+
+void MarkerTextIndex::AddMarker(const CottonwoodMarker& inMarker)
+{
+	ASL::Guid markerID = inMarker.GetGUID();
+	if (mSlots.find(markerID) != mSlots.end())
+	{
+		return;
+	}
+
+	MarkerSlot slot;
+	if (!mFreeSlots.empty())
+	{
+		slot = mFreeSlots.back();
+		mFreeSlots.pop_back();
+		mSlotGUIDs[slot] = markerID;
+	}
+	else
+	{
+		slot = static_cast<MarkerSlot>(mSlotGUIDs.size());
+		mSlotGUIDs.push_back(markerID);
+	}
+	mSlots.insert(std::make_pair(markerID, slot));
+
+	std::vector<Trigram> trigrams;
+	CollectTrigrams(inMarker, trigrams);
+	for (std::vector<Trigram>::const_iterator it = trigrams.begin(); it != trigrams.end(); ++it)
+	{
+		AddToPostingList(mPostings[*it], slot);
+	}
+	AddToPostingList(mTypes[inMarker.GetTypeID()], slot);
+}
+
+void MarkerTextIndex::RemoveMarker(const CottonwoodMarker& inMarker)
+{
+	MarkerSlots::iterator slotIter = mSlots.find(inMarker.GetGUID());
+	if (slotIter == mSlots.end())
+	{
+		return;
+	}
+	const MarkerSlot slot = slotIter->second;
+
+	std::vector<Trigram> trigrams;
+	CollectTrigrams(inMarker, trigrams);
+	for (std::vector<Trigram>::const_iterator it = trigrams.begin(); it != trigrams.end(); ++it)
+	{
+		TrigramPostings::iterator postingIter = mPostings.find(*it);
+		if (postingIter != mPostings.end() && RemoveFromPostingList(postingIter->second, slot))
+		{
+			mPostings.erase(postingIter);
+		}
+	}
+
+	MarkerTypeIndex::iterator typeIter = mTypes.find(inMarker.GetTypeID());
+	if (typeIter != mTypes.end() && RemoveFromPostingList(typeIter->second, slot))
+	{
+		mTypes.erase(typeIter);
+	}
+
+	mSlots.erase(slotIter);
+	mSlotGUIDs[slot] = ASL::Guid();
+	mFreeSlots.push_back(slot);
+}
+
+void MarkerTextIndex::ReplaceMarker(
+	const CottonwoodMarker& inOldMarker,
+	const CottonwoodMarker& inNewMarker)
+{
+	RemoveMarker(inOldMarker);
+	AddMarker(inNewMarker);
+}
+
+void MarkerTextIndex::FindCandidateMarkers(
+	const dvacore::UTF16String& inFilterText,
+	MarkerIDSet& outMarkerIDs) const
+{
+	if (inFilterText.empty())
+	{
+		return;
+	}
+
+	dvacore::UTF16String foldedFilter = dvacore::utility::LowerCase(inFilterText);
+
+	if (foldedFilter.size() < kTrigramLength)
+	{
+		//	Too short to use the postings.
+		for (MarkerSlots::const_iterator it = mSlots.begin(); it != mSlots.end(); ++it)
+		{
+			outMarkerIDs.insert(outMarkerIDs.end(), it->first);
+		}
+		return;
+	}
+
+	std::vector<Trigram> filterTrigrams;
+	CollectTrigrams(foldedFilter, filterTrigrams);
+
+	//	Every trigram of the filter must be present; start from the rarest posting list and
+	//	intersect the others into it.
+	std::vector<const PostingList*> postingLists;
+	for (std::vector<Trigram>::const_iterator it = filterTrigrams.begin(); it != filterTrigrams.end(); ++it)
+	{
+		TrigramPostings::const_iterator postingIter = mPostings.find(*it);
+		if (postingIter == mPostings.end())
+		{
+			postingLists.clear();
+			break;
+		}
+		postingLists.push_back(&postingIter->second);
+	}
+
+	PostingList candidates;
+	if (!postingLists.empty())
+	{
+		std::vector<const PostingList*>::iterator rarest = postingLists.begin();
+		for (std::vector<const PostingList*>::iterator it = postingLists.begin(); it != postingLists.end(); ++it)
+		{
+			if ((*it)->size() < (*rarest)->size())
+			{
+				rarest = it;
+			}
+		}
+		candidates = **rarest;
+
+		PostingList intersection;
+		for (std::vector<const PostingList*>::const_iterator it = postingLists.begin();
+			it != postingLists.end() && !candidates.empty();
+			++it)
+		{
+			intersection.clear();
+			std::set_intersection(
+				candidates.begin(), candidates.end(),
+				(*it)->begin(), (*it)->end(),
+				std::back_inserter(intersection));
+			candidates.swap(intersection);
+		}
+	}
+
+	//	Display names can change at runtime, so types are matched per query; there are only a few of them.
+	MarkerTypeSnapshotPtr typeSnapshot = MarkerType::GetMarkerTypeSnapshot();
+	for (MarkerTypeIndex::const_iterator it = mTypes.begin(); it != mTypes.end(); ++it)
+	{
+		const MarkerTypeEntry* typeEntry = typeSnapshot->GetEntry(it->first);
+		if (typeEntry != NULL &&
+			dvacore::utility::LowerCase(typeEntry->mDisplayName).find(foldedFilter) != dvacore::UTF16String::npos)
+		{
+			candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+		}
+	}
+
+	for (PostingList::const_iterator it = candidates.begin(); it != candidates.end(); ++it)
+	{
+		outMarkerIDs.insert(mSlotGUIDs[*it]);
+	}
+}
+
+}
@@ -33,6 +33,7 @@
 #include "PLUtilitiesPrivate.h"
 #include "PLModulePicker.h"
 #include "PLMarkerOwner.h"
+#include "PLMarkerGuidIndex.h"
 
 //	MZ
 #include "MZActivation.h"
@@ -47,46 +48,110 @@
 //	BE
 #include "BE/Clip/IClip.h"
 
+//	STL
+#include <algorithm>
+
 
 
 namespace PL
 {
-	static const dvacore::StdString kXMPPartID_Tracks("/metadata/xmpDM/Tracks");
-	static const dvacore::StdString kXMPPartID_Metadata("/metadata");
 
     bool IsMarkerFilteredByString(CottonwoodMarker const& inMarker, dvacore::UTF16String const& inFilterText)
 	{
-		std::vector<dvacore::UTF16String> searchAreas;
-		searchAreas.push_back(inMarker.GetComment());
-		searchAreas.push_back(inMarker.GetName());
-		searchAreas.push_back(MarkerType::GetDisplayNameForType(inMarker.GetType()));
-		searchAreas.push_back(inMarker.GetLocation());
-		searchAreas.push_back(inMarker.GetProbability());
-		searchAreas.push_back(inMarker.GetSpeaker());
-		searchAreas.push_back(inMarker.GetTarget());
-		searchAreas.push_back(inMarker.GetCuePointType());
-		for (size_t i = 0; i < inMarker.GetCuePointList().size(); ++i)
+		// Check fields one at a time so we can stop at the first hit. Type display name goes last
+		// since it needs the marker type registry.
+		if (ASL::CaseInsensitive::StringContains(inMarker.GetComment(), inFilterText) ||
+			ASL::CaseInsensitive::StringContains(inMarker.GetName(), inFilterText) ||
+			ASL::CaseInsensitive::StringContains(inMarker.GetLocation(), inFilterText) ||
+			ASL::CaseInsensitive::StringContains(inMarker.GetProbability(), inFilterText) ||
+			ASL::CaseInsensitive::StringContains(inMarker.GetSpeaker(), inFilterText) ||
+			ASL::CaseInsensitive::StringContains(inMarker.GetTarget(), inFilterText) ||
+			ASL::CaseInsensitive::StringContains(inMarker.GetCuePointType(), inFilterText))
 		{
-			searchAreas.push_back(inMarker.GetCuePointList()[i].mValue);
+			return true;
 		}
 
-		TagParamMap tagParams = inMarker.GetTagParams();
-		for (TagParamMap::iterator it = tagParams.begin(); it != tagParams.end(); it++)
+		const dvatemporalxmp::CustomMarkerParamList& cuePoints = inMarker.GetCuePointList();
+		for (size_t i = 0; i < cuePoints.size(); ++i)
 		{
-			searchAreas.push_back((*it).second->GetName());
-			searchAreas.push_back((*it).second->GetPayload());
+			if (ASL::CaseInsensitive::StringContains(cuePoints[i].mValue, inFilterText))
+			{
+				return true;
+			}
 		}
 
-		std::vector<dvacore::UTF16String>::const_iterator searchAreaIter = searchAreas.begin(); 
-
-		for (; searchAreaIter != searchAreas.end(); ++searchAreaIter)
+		const TagParamMap& tagParams = inMarker.GetTagParams();
+		for (TagParamMap::const_iterator it = tagParams.begin(); it != tagParams.end(); it++)
 		{
-			if (ASL::CaseInsensitive::StringContains(*searchAreaIter, inFilterText))
+			if (ASL::CaseInsensitive::StringContains((*it).second->GetName(), inFilterText) ||
+				ASL::CaseInsensitive::StringContains((*it).second->GetPayload(), inFilterText))
 			{
 				return true;
 			}
 		}
-		return false;
+
+		return ASL::CaseInsensitive::StringContains(MarkerType::GetDisplayNameForType(inMarker.GetTypeID()), inFilterText);
+	}
+
+	// How far a merge walk steps through the marker set before falling back to a tree search.
+	static const std::size_t kMaxMergeSteps = 8;
+
+	/*
+	**	Returns the first marker at or after ioPosition not ordered before inMarker. Bulk callers feed
+	**	GUID-sorted input, so the next match is usually a step or two ahead; a wide gap costs one
+	**	lower_bound instead of a walk over everything in between.
+	*/
+	static MarkerSet::iterator AdvanceMergePosition(
+		MarkerSet& inMarkers,
+		MarkerSet::iterator ioPosition,
+		const CottonwoodMarker& inMarker)
+	{
+		CottonwoodMarkerSort markerLess;
+		for (std::size_t step = 0; step < kMaxMergeSteps; ++step)
+		{
+			if (ioPosition == inMarkers.end() || !markerLess(*ioPosition, inMarker))
+			{
+				return ioPosition;
+			}
+			++ioPosition;
+		}
+		return inMarkers.lower_bound(inMarker);
+	}
+
+	typedef std::vector<std::size_t> MarkerIndexList;
+
+	class MarkerIndexSort
+	{
+	public:
+		explicit MarkerIndexSort(const CottonwoodMarkerList& inMarkers)
+			:
+			mMarkers(inMarkers)
+		{
+		}
+
+		bool operator() (std::size_t inLHS, std::size_t inRHS) const
+		{
+			return CottonwoodMarkerSort()(mMarkers[inLHS], mMarkers[inRHS]);
+		}
+
+	private:
+		const CottonwoodMarkerList& mMarkers;
+	};
+
+	/*
+	**	Returns the positions of inMarkers in GUID order. The sort is stable, so markers sharing a
+	**	GUID keep the caller's order and the last of them still wins an update. Results are reported
+	**	back by position, in the caller's order.
+	*/
+	static MarkerIndexList SortMarkerIndicesByGUID(const CottonwoodMarkerList& inMarkers)
+	{
+		MarkerIndexList sortedIndices(inMarkers.size());
+		for (std::size_t index = 0; index < sortedIndices.size(); ++index)
+		{
+			sortedIndices[index] = index;
+		}
+		std::stable_sort(sortedIndices.begin(), sortedIndices.end(), MarkerIndexSort(inMarkers));
+		return sortedIndices;
 	}
 
 	static void SelectMarkers(ISRMarkerSelectionRef ioMarkerSelection, const CottonwoodMarkerList& inMarkers)
@@ -164,6 +229,12 @@ namespace PL
 
 	SRMarkers::~SRMarkers()
 	{
+		//	Markers can outlive the index when they are released during shutdown.
+		MarkerGuidIndex::SharedPtr markerGuidIndex = MarkerGuidIndex::GetInstance();
+		if (markerGuidIndex)
+		{
+			markerGuidIndex->RemoveMarkers(mMarkers);
+		}
 	}
     
     PL::ISRMarkersRef SRMarkers::Create(ISRMediaRef inSRMedia)
@@ -188,14 +259,20 @@ namespace PL
 
 	void SRMarkers::RefineMarker(CottonwoodMarker& ioMarker)
 	{
-		dvamediatypes::FrameRate mediaFrameRate = GetMediaFrameRate();
+		RefineMarker(ioMarker, GetMediaFrameRate(), GetMediaDuration());
+	}
+
+	void SRMarkers::RefineMarker(
+		CottonwoodMarker& ioMarker,
+		const dvamediatypes::FrameRate& mediaFrameRate,
+		const dvamediatypes::TickTime& mediaDuration)
+	{
 		dvamediatypes::TickTime startTime = ioMarker.GetStartTime();
 		dvamediatypes::TickTime endTime = ioMarker.GetStartTime() + ioMarker.GetDuration();
 
 		startTime.AlignToFrame(mediaFrameRate);
 		endTime.AlignToFrame(mediaFrameRate);
 
-		dvamediatypes::TickTime mediaDuration = GetMediaDuration();
 		if (startTime < dvamediatypes::kTime_Zero)
 		{
 			startTime = dvamediatypes::kTime_Zero;
@@ -272,6 +349,7 @@ namespace PL
 		Utilities::BuildXMPStringFromMarkers(xmpContent , mMarkers, mTrackTypes, GetMediaFrameRate());
 		XMPText xmpText(new ASL::StdString(xmpContent));
 
+		//	Fingerprinting the new buffer here caches it for whoever adopts it after the save.
 		mMarkerState = GetMarkerState(xmpText);
 
 		return xmpText;
@@ -287,10 +365,26 @@ namespace PL
 		if (latestMarkerState != mMarkerState)
 		{
 			// get rid of the old ones...
+			const ASL::String mediaPath = mSRMedia->GetClipFilePath();
+			MarkerGuidIndex::SharedPtr markerGuidIndex = MarkerGuidIndex::GetInstance();
+			if (markerGuidIndex)
+			{
+				markerGuidIndex->RemoveMarkers(mMarkers);
+			}
 			mMarkers.clear();
 			Utilities::BuildMarkersFromXMPString(*inXMPString.get(), mTrackTypes, mMarkers, ISRMarkerOwnerRef(mSRMedia));
 			mMarkerState = latestMarkerState;
 
+			mTextIndex.Clear();
+			for (MarkerSet::const_iterator itr = mMarkers.begin(); itr != mMarkers.end(); ++itr)
+			{
+				mTextIndex.AddMarker(*itr);
+				if (markerGuidIndex)
+				{
+					markerGuidIndex->AddMarker(itr->GetGUID(), mMarkers, mediaPath, false);
+				}
+			}
+
 			// If this is not called by the initialization, trigger marker bar and 
 			// marker list view refresh with CottonwoodMarkerChangedEvent
 			if (inSendNotification)
@@ -314,6 +408,12 @@ namespace PL
 			ASL::CriticalSectionLock lock(mMarkerCriticalSection);
 			RefineMarker(addedMarker);
 			mMarkers.insert(addedMarker);
+			mTextIndex.AddMarker(addedMarker);
+			MarkerGuidIndex::SharedPtr markerGuidIndex = MarkerGuidIndex::GetInstance();
+			if (markerGuidIndex)
+			{
+				markerGuidIndex->AddMarker(addedMarker.GetGUID(), mMarkers, mSRMedia->GetClipFilePath(), false);
+			}
 		}
 		SetDirty(true);
 		
@@ -328,16 +428,29 @@ namespace PL
 
 	void SRMarkers::AddMarkers(const CottonwoodMarkerList& inMarkers, bool inIsSilent)
 	{
-		CottonwoodMarkerList changedMarkers;
+		// Refined in place, so the notification lists the markers in the caller's order.
+		CottonwoodMarkerList changedMarkers(inMarkers);
 		ASL::CriticalSectionLock lock(mMarkerCriticalSection);
-		for (CottonwoodMarkerList::const_iterator itr = inMarkers.begin(); itr != inMarkers.end(); ++itr)
-		{
-			CottonwoodMarker addedMarker = (*itr);
-            addedMarker.SetMarkerOwner(PL::ISRMarkerOwnerRef(mSRMedia));
-			RefineMarker(addedMarker);
-			mMarkers.insert(addedMarker);
 
-			changedMarkers.push_back(addedMarker);
+		// Media timing is the same for every marker, and GUID order lets each insert use the
+		// previous one as its hint.
+		const dvamediatypes::FrameRate mediaFrameRate = GetMediaFrameRate();
+		const dvamediatypes::TickTime mediaDuration = GetMediaDuration();
+		const PL::ISRMarkerOwnerRef markerOwner(mSRMedia);
+
+		MarkerSet::iterator hint = mMarkers.begin();
+		BOOST_FOREACH(std::size_t index, SortMarkerIndicesByGUID(inMarkers))
+		{
+			CottonwoodMarker& addedMarker = changedMarkers[index];
+			addedMarker.SetMarkerOwner(markerOwner);
+			RefineMarker(addedMarker, mediaFrameRate, mediaDuration);
+			hint = mMarkers.insert(hint, addedMarker);
+			mTextIndex.AddMarker(addedMarker);
+		}
+		MarkerGuidIndex::SharedPtr markerGuidIndex = MarkerGuidIndex::GetInstance();
+		if (markerGuidIndex)
+		{
+			markerGuidIndex->AddMarkers(changedMarkers, mMarkers, mSRMedia->GetClipFilePath(), false);
 		}
 		SetDirty(true);
 
@@ -355,25 +468,7 @@ namespace PL
 
 	dvacore::StdString SRMarkers::GetMarkerState(XMPText inXMPString)
 	{
-		ASL::Result result(-1);
-		dvacore::StdString metadataState;
-
-		dvacore::StdString partID = std::string(kXMPPartID_Tracks);
-
-		try	
-		{
-			SXMPDocOps xmpDocOps;
-			SXMPMeta meta(inXMPString->c_str(), static_cast<XMP_StringLen>(inXMPString->length()));
-			xmpDocOps.OpenXMP(reinterpret_cast<SXMPMeta*>(&meta), "");
-
-			//	We ask the doc ops if there is a part ID in this file.
-			xmpDocOps.GetPartChangeID(partID.c_str(), &metadataState);
-		}
-		catch(...)
-		{
-		}
-
-		return metadataState;
+		return Utilities::GetXMPFingerprint(inXMPString)->mTracksChangeID;
 	}
 
 	void SRMarkers::MarkerChanged(const ASL::String& inMediaLocatorID)
@@ -386,7 +481,17 @@ namespace PL
 	{
 		{
 			ASL::CriticalSectionLock lock(mMarkerCriticalSection);
-			mMarkers.erase(inMarker);
+			MarkerSet::iterator storedMarker = mMarkers.find(inMarker);
+			if (storedMarker != mMarkers.end())
+			{
+				mTextIndex.RemoveMarker(*storedMarker);
+				mMarkers.erase(storedMarker);
+			}
+			MarkerGuidIndex::SharedPtr markerGuidIndex = MarkerGuidIndex::GetInstance();
+			if (markerGuidIndex)
+			{
+				markerGuidIndex->RemoveMarker(inMarker.GetGUID(), mMarkers);
+			}
 		}
 		SetDirty(true);
 		
@@ -405,9 +510,19 @@ namespace PL
 	{
 		CottonwoodMarkerList changedMarkers;
 		ASL::CriticalSectionLock lock(mMarkerCriticalSection);
+		MarkerGuidIndex::SharedPtr markerGuidIndex = MarkerGuidIndex::GetInstance();
 		for (CottonwoodMarkerList::const_iterator itr = inMarkers.begin(); itr != inMarkers.end(); ++itr)
 		{
-			mMarkers.erase(*itr);
+			MarkerSet::iterator storedMarker = mMarkers.find(*itr);
+			if (storedMarker != mMarkers.end())
+			{
+				mTextIndex.RemoveMarker(*storedMarker);
+				mMarkers.erase(storedMarker);
+			}
+			if (markerGuidIndex)
+			{
+				markerGuidIndex->RemoveMarker(itr->GetGUID(), mMarkers);
+			}
 			
 			CottonwoodMarker changedMarker(*itr);
 			changedMarker.SetMarkerOwner(PL::ISRMarkerOwnerRef(mSRMedia));
@@ -433,9 +548,15 @@ namespace PL
 		{
 			ASL::CriticalSectionLock lock(mMarkerCriticalSection);
 			
-			mMarkers.erase(inOldMarker);
+			MarkerSet::iterator storedMarker = mMarkers.find(inOldMarker);
+			if (storedMarker != mMarkers.end())
+			{
+				mTextIndex.RemoveMarker(*storedMarker);
+				mMarkers.erase(storedMarker);
+			}
 			RefineMarker(addedMarker);
 			mMarkers.insert(addedMarker);
+			mTextIndex.AddMarker(addedMarker);
 		}
 		SetDirty(true);
 
@@ -452,21 +573,45 @@ namespace PL
 	{
 		ASL::CriticalSectionLock lock(mMarkerCriticalSection);
 
-		CottonwoodMarkerList changedMarkers;
-		BOOST_FOREACH(CottonwoodMarker newMarker, inMarkers)
+		const dvamediatypes::FrameRate mediaFrameRate = GetMediaFrameRate();
+		const dvamediatypes::TickTime mediaDuration = GetMediaDuration();
+		const PL::ISRMarkerOwnerRef markerOwner(mSRMedia);
+		CottonwoodMarkerSort markerLess;
+
+		CottonwoodMarkerList newMarkers(inMarkers);
+		std::vector<bool> updated(inMarkers.size(), false);
+		MarkerSet::iterator it = mMarkers.begin();
+		BOOST_FOREACH(std::size_t index, SortMarkerIndicesByGUID(inMarkers))
 		{
-            newMarker.SetMarkerOwner(PL::ISRMarkerOwnerRef(mSRMedia));
-			CottonwoodMarker marker;
-			marker.SetGUID(newMarker.GetGUID());
-			MarkerSet::iterator it = mMarkers.find(marker);
-			if (it != mMarkers.end())
+			CottonwoodMarker& newMarker = newMarkers[index];
+			it = AdvanceMergePosition(mMarkers, it, newMarker);
+			if (it == mMarkers.end())
+			{
+				break;
+			}
+			if (markerLess(newMarker, *it))
 			{
-				RefineMarker(newMarker);
-				mMarkers.erase(it);
-				mMarkers.insert(newMarker);
+				continue;
+			}
 
-				CottonwoodMarker changedMarker(newMarker);
-				changedMarkers.push_back(changedMarker);
+			newMarker.SetMarkerOwner(markerOwner);
+			RefineMarker(newMarker, mediaFrameRate, mediaDuration);
+			// The GUID is unchanged, so the updated marker goes back into the same slot.
+			MarkerSet::iterator next = it;
+			++next;
+			mTextIndex.ReplaceMarker(*it, newMarker);
+			mMarkers.erase(it);
+			it = mMarkers.insert(next, newMarker);
+
+			updated[index] = true;
+		}
+
+		CottonwoodMarkerList changedMarkers;
+		for (std::size_t index = 0; index < newMarkers.size(); ++index)
+		{
+			if (updated[index])
+			{
+				changedMarkers.push_back(newMarkers[index]);
 			}
 		}
 
@@ -499,6 +644,40 @@ namespace PL
 		return false;
 	}
 
+	void SRMarkers::PartitionMarkers(
+		const CottonwoodMarkerList& inMarkers,
+		CottonwoodMarkerList& outNewMarkers,
+		CottonwoodMarkerList& outUpdatedMarkers,
+		CottonwoodMarkerList& outExistingMarkers)
+	{
+		CottonwoodMarkerSort markerLess;
+
+		ASL::CriticalSectionLock lock(mMarkerCriticalSection);
+		std::vector<const CottonwoodMarker*> existingMarkers(inMarkers.size(), NULL);
+		MarkerSet::iterator it = mMarkers.begin();
+		BOOST_FOREACH(std::size_t index, SortMarkerIndicesByGUID(inMarkers))
+		{
+			it = AdvanceMergePosition(mMarkers, it, inMarkers[index]);
+			if (it != mMarkers.end() && !markerLess(inMarkers[index], *it))
+			{
+				existingMarkers[index] = &*it;
+			}
+		}
+
+		for (std::size_t index = 0; index < inMarkers.size(); ++index)
+		{
+			if (existingMarkers[index] == NULL)
+			{
+				outNewMarkers.push_back(inMarkers[index]);
+			}
+			else
+			{
+				outUpdatedMarkers.push_back(inMarkers[index]);
+				outExistingMarkers.push_back(*existingMarkers[index]);
+			}
+		}
+	}
+
 	/**
 	** Checks, if there is a marker, matching the given properties
 	*/
@@ -605,19 +784,11 @@ namespace PL
 	*/
 	bool SRMarkers::HasMarker(const ASL::Guid& inMarkerId)
 	{
-		MarkerSet::const_iterator end = mMarkers.end();
-		MarkerSet::const_iterator it = mMarkers.begin();
-
-		for (; it != end; ++it)
-		{
-			const CottonwoodMarker& marker = *it;
-			if ( marker.GetGUID() == inMarkerId )
-			{
-				return true;
-			}
-		}
+		CottonwoodMarker marker;
+		marker.SetGUID(inMarkerId);
 
-		return false;
+		ASL::CriticalSectionLock lock(mMarkerCriticalSection);
+		return mMarkers.find(marker) != mMarkers.end();
 	}
 
 
@@ -632,8 +803,7 @@ namespace PL
 		const dvamediatypes::TickTime& inDuration)
 	{
 		bool hasFilter = !inFilter.empty();
-		bool hasFilterText = !inFilterText.empty();
-		MarkerTrack markers(GetMarkers());
+		MarkerTrack markers(inFilterText.empty() ? GetMarkers() : GetMarkersMatchingText(inFilterText));
 		MarkerTrack::iterator iter(markers.begin());
 		for ( ; iter != markers.end(); ++iter)
 		{
@@ -642,10 +812,6 @@ namespace PL
 			{
 				insert = inFilter.find(iter->second.GetType()) != inFilter.end();
 			}
-			if (insert && hasFilterText)
-			{
-				insert = IsMarkerFilteredByString(iter->second, inFilterText);					
-			}
 			
 			if (insert)
 			{
@@ -660,11 +826,39 @@ namespace PL
 		}
 	}
 
+	/**
+	**	Get the markers matching the filter text sorted by start time, using the text index
+	*/
+	MarkerTrack SRMarkers::GetMarkersMatchingText(const dvacore::UTF16String& inFilterText)
+	{
+		ASL::CriticalSectionLock lock(mMarkerCriticalSection);
+		MarkerIDSet matchedIDs;
+		mTextIndex.FindCandidateMarkers(inFilterText, matchedIDs);
+
+		MarkerTrack track;
+		CottonwoodMarker marker;
+		for (MarkerIDSet::const_iterator it = matchedIDs.begin(); it != matchedIDs.end(); ++it)
+		{
+			marker.SetGUID(*it);
+			MarkerSet::iterator itr = mMarkers.find(marker);
+			if (itr != mMarkers.end() && IsMarkerFilteredByString(*itr, inFilterText))
+			{
+				track.insert(std::make_pair(itr->GetStartTime(), (*itr)));
+			}
+		}
+		return track;
+	}
+
 	BE::IMasterClipRef SRMarkers::GetMediaMasterClip() const
 	{
 		return mSRMedia != NULL ? mSRMedia->GetMasterClip() : BE::IMasterClipRef();
 	}
 
+	ASL::String SRMarkers::GetMediaPath() const
+	{
+		return mSRMedia != NULL ? mSRMedia->GetClipFilePath() : ASL::String();
+	}
+
 }
 
 
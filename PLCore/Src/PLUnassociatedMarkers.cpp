@@ -8,6 +8,7 @@
 
 #include "PLUnassociatedMarkers.h"
 #include "PLUtilities.h"
+#include "PLMarkerGuidIndex.h"
 
 namespace PL
 {
@@ -23,6 +24,11 @@ namespace PL
      */
     SRUnassociatedMarkers::~SRUnassociatedMarkers()
     {
+        MarkerGuidIndex::SharedPtr markerGuidIndex = MarkerGuidIndex::GetInstance();
+        if (markerGuidIndex)
+        {
+            markerGuidIndex->RemoveMarkers(mMarkers);
+        }
     }
     
     /*
@@ -54,9 +60,24 @@ namespace PL
         ASL::CriticalSectionLock lock(mMarkerCriticalSection);
         
         // get rid of the old ones...
+        MarkerGuidIndex::SharedPtr markerGuidIndex = MarkerGuidIndex::GetInstance();
+        if (markerGuidIndex)
+        {
+            markerGuidIndex->RemoveMarkers(mMarkers);
+        }
         mMarkers.clear();
         
         Utilities::BuildMarkersFromXMPString(*inXMPString.get(), mTrackTypes, mMarkers);
+
+        mTextIndex.Clear();
+        for (MarkerSet::const_iterator itr = mMarkers.begin(); itr != mMarkers.end(); ++itr)
+        {
+            mTextIndex.AddMarker(*itr);
+            if (markerGuidIndex)
+            {
+                markerGuidIndex->AddMarker(itr->GetGUID(), mMarkers, mFilePath, true);
+            }
+        }
         
         return true;
     }
@@ -130,19 +151,11 @@ namespace PL
      */
     bool SRUnassociatedMarkers::HasMarker(const ASL::Guid& inMarkerId)
     {
-        MarkerSet::const_iterator end = mMarkers.end();
-        MarkerSet::const_iterator it = mMarkers.begin();
-        
-        for (; it != end; ++it)
-        {
-            const CottonwoodMarker& marker = *it;
-            if ( marker.GetGUID() == inMarkerId )
-            {
-                return true;
-            }
-        }
+        CottonwoodMarker marker;
+        marker.SetGUID(inMarkerId);
         
-        return false;
+        ASL::CriticalSectionLock lock(mMarkerCriticalSection);
+        return mMarkers.find(marker) != mMarkers.end();
     }
     
     /**
@@ -213,8 +226,7 @@ namespace PL
                                                                  const dvamediatypes::TickTime& inDuration)
     {
         bool hasFilter = !inFilter.empty();
-        bool hasFilterText = !inFilterText.empty();
-        MarkerTrack markers(GetMarkers());
+        MarkerTrack markers(inFilterText.empty() ? GetMarkers() : GetMarkersMatchingText(inFilterText));
         MarkerTrack::iterator iter(markers.begin());
         for ( ; iter != markers.end(); ++iter)
         {
@@ -223,10 +235,6 @@ namespace PL
             {
                 insert = inFilter.find(iter->second.GetType()) != inFilter.end();
             }
-            if (insert && hasFilterText)
-            {
-                insert = IsMarkerFilteredByString(iter->second, inFilterText);					
-            }
             
             if (insert)
             {
@@ -241,4 +249,27 @@ namespace PL
         }
     }
 
+    /**
+     **	Get the markers matching the filter text sorted by start time, using the text index
+     */
+    MarkerTrack SRUnassociatedMarkers::GetMarkersMatchingText(const dvacore::UTF16String& inFilterText)
+    {
+        ASL::CriticalSectionLock lock(mMarkerCriticalSection);
+        MarkerIDSet matchedIDs;
+        mTextIndex.FindCandidateMarkers(inFilterText, matchedIDs);
+        
+        MarkerTrack track;
+        CottonwoodMarker marker;
+        for (MarkerIDSet::const_iterator it = matchedIDs.begin(); it != matchedIDs.end(); ++it)
+        {
+            marker.SetGUID(*it);
+            MarkerSet::iterator itr = mMarkers.find(marker);
+            if (itr != mMarkers.end() && IsMarkerFilteredByString(*itr, inFilterText))
+            {
+                track.insert(std::make_pair(itr->GetStartTime(), (*itr)));
+            }
+        }
+        return track;
+    }
+
 }
\ No newline at end of file
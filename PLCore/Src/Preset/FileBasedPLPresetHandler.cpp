@@ -35,7 +35,9 @@
 #include "MFDirectoryChangeMonitor.h"
 
 // boost
+#include "boost/bind.hpp"
 #include "boost/foreach.hpp"
+#include "boost/shared_ptr.hpp"
 
 // dva
 #include "dvacore/utility/Coercion.h"
@@ -66,6 +68,9 @@
 #include "Preset/PLPreset.h"
 #include "Preset/PLPresetCache.h"
 
+// PL
+#include "PLThreadUtils.h"
+
 // PRM
 #include "PRMApplicationTarget.h"
 
@@ -131,6 +136,121 @@ namespace
 		return userPresetsDir.FullPath();
 	}
 
+	const ASL::String kPresetScanExecutorName = ASL_STR("PLPresetScanExecutor");
+
+	// Preset files are small, the pool mostly hides file system latency on shared folders.
+	const int kMaxPresetScanWorkers = 4;
+
+	/*
+	**	Shared by the folder scan and the parse jobs it spawns. The executor is kept here because
+	**	the named executor registry may only be touched from the main thread.
+	*/
+	struct PresetScanState
+	{
+		dvacore::UTF16String						mPresetFolder;
+		PLPresetCategory							mCategory;
+		PLPresetType								mPresetType;
+		dvacore::threads::AsyncThreadedExecutorPtr	mExecutor;
+
+		ASL::CriticalSection						mCriticalSection;
+		std::size_t									mPendingFiles;
+	};
+	typedef boost::shared_ptr<PresetScanState> PresetScanStatePtr;
+
+	void PostScannedPresets(
+		const PresetScanStatePtr& inState,
+		const IPLPresets& inPresets)
+	{
+		if (!inPresets.empty())
+		{
+			ASL::StationUtils::PostMessageToUIThread(
+				kFileBasePLPresetHandlerWorkerStation,
+				PresetsLoaded(inState->mPresetFolder, inPresets));
+		}
+	}
+
+	void PostScanFinished(const PresetScanStatePtr& inState)
+	{
+		ASL::StationUtils::PostMessageToUIThread(
+			kFileBasePLPresetHandlerWorkerStation,
+			PresetListCached(inState->mPresetFolder));
+	}
+
+	void ParseScannedPresetFile(
+		PresetScanStatePtr inState,
+		dvacore::UTF16String inPresetFile)
+	{
+		IPLPresetRef preset = FileBasedPLPresetHandler::ParsePresetFile(inPresetFile, inState->mCategory);
+		if (preset)
+		{
+			preset->SetPresetType(inState->mPresetType);
+			PLPresetCache::Get().CachePreset(inPresetFile, preset);
+			PostScannedPresets(inState, IPLPresets(1, preset));
+		}
+
+		bool folderDone = false;
+		{
+			ASL::CriticalSectionLock lock(inState->mCriticalSection);
+			DVA_ASSERT(inState->mPendingFiles > 0);
+			folderDone = (--inState->mPendingFiles == 0);
+		}
+
+		if (folderDone)
+		{
+			PostScanFinished(inState);
+		}
+	}
+
+	void ScanPresetFolder(PresetScanStatePtr inState)
+	{
+		IPLPresets cachedPresets;
+		std::vector<dvacore::UTF16String> filesToParse;
+
+		dvacore::filesupport::Dir presetFolder(inState->mPresetFolder);
+		if (presetFolder.Exists())
+		{
+			const dvacore::UTF16String presetExtension = GetPresetFileExtention(inState->mCategory);
+			for (dvacore::filesupport::Dir::FileIterator file = presetFolder.BeginFiles(false);
+				file != presetFolder.EndFiles();
+				file++)
+			{
+				if ((*file).GetExtension() != presetExtension)
+				{
+					continue;
+				}
+
+				dvacore::UTF16String filePath((*file).FullPath());
+				IPLPresetRef preset = PLPresetCache::Get().GetPreset(filePath);
+				if (preset)
+				{
+					cachedPresets.push_back(preset);
+				}
+				else
+				{
+					filesToParse.push_back(filePath);
+				}
+			}
+		}
+
+		PostScannedPresets(inState, cachedPresets);
+
+		if (filesToParse.empty())
+		{
+			PostScanFinished(inState);
+			return;
+		}
+
+		{
+			ASL::CriticalSectionLock lock(inState->mCriticalSection);
+			inState->mPendingFiles = filesToParse.size();
+		}
+
+		BOOST_FOREACH(const dvacore::UTF16String& presetFile, filesToParse)
+		{
+			inState->mExecutor->CallAsynchronously(boost::bind(&ParseScannedPresetFile, inState, presetFile));
+		}
+	}
+
 	dvacore::UTF16String GetPresetCategoryString(const PLPresetCategory inCategory)
 	{
 		dvacore::UTF16String subPath;
@@ -231,6 +351,14 @@ IPLPresets FileBasedPLPresetHandler::GetUserPresets(bool inUseCache)
 }
 
 
+/*
+**
+*/
+void FileBasedPLPresetHandler::RequestUserPresets()
+{
+	GetPresetsAsync(mUserPresetFolder, mCategory, kPLPresetType_USER);
+}
+
 /*
 **	Return false if you do not want to list a user preset.
 **	@param inPresetRef		The preset in question
@@ -500,6 +628,47 @@ IPLPresets FileBasedPLPresetHandler::GetPresets(
 	return IPLPresets();
 }
 
+/**
+**
+*/
+void FileBasedPLPresetHandler::GetPresetsAsync(
+	const dvacore::UTF16String& inPresetFolder,
+	PLPresetCategory inCategory,
+	PLPresetType inPresetType)
+{
+	dvacore::threads::AsyncThreadedExecutorPtr executor = PL::threads::GetExecutor(kPresetScanExecutorName);
+	if (executor == NULL)
+	{
+		executor = PL::threads::CreateAndRegisterExecutor(kPresetScanExecutorName, kMaxPresetScanWorkers);
+	}
+
+	// Make sure the cache singleton is created here rather than raced for by the workers.
+	PLPresetCache::Get();
+
+	PresetScanStatePtr state(new PresetScanState);
+	state->mPresetFolder = inPresetFolder;
+	state->mCategory = inCategory;
+	state->mPresetType = inPresetType;
+	state->mExecutor = executor;
+	state->mPendingFiles = 0;
+
+	executor->CallAsynchronously(boost::bind(&ScanPresetFolder, state));
+}
+
+/**
+**
+*/
+void FileBasedPLPresetHandler::StopPresetScans()
+{
+	dvacore::threads::AsyncThreadedExecutorPtr executor = PL::threads::GetExecutor(kPresetScanExecutorName);
+	if (executor != NULL)
+	{
+		executor->Terminate();
+		executor->Flush();
+		PL::threads::UnregisterExecutor(kPresetScanExecutorName);
+	}
+}
+
 /**
 **
 */
@@ -658,32 +827,10 @@ IPLPresetRef FileBasedPLPresetHandler::ReadPresetFromFile(
 
 		if (!preset)
 		{
-			BE::IXMLFileReaderRef presetReader(ASL::CreateClassInstanceRef(BE::kXMLFileReaderClassID));
-			
-			if(ASL::ResultSucceeded(presetReader->ReadFromFile(inPresetFile)))//File exists
-			{
-				switch (inCategory)
-				{
-				case PLPreCategory_Rename: 
-					preset = IPLPresetRef(PLPresetRename::CreateClassRef());
-					break;
-
-				case PLPreCategory_Metadata:
-					preset = IPLPresetRef(PLPresetMetadata::CreateClassRef());
-					break;
-
-				default:
-					preset = IPLPresetRef(PLPreset::CreateClassRef());
-					break;
-				}
-				BE::ISerializeableRef(preset)->SerializeIn(
-					BE::ISerializeableRef(preset)->GetVersion(),
-					*presetReader->GetDataReader());
-			}
+			preset = ParsePresetFile(inPresetFile, inCategory);
 			
 			if (preset)
 			{
-				preset->SetPresetFullPath(inPresetFile);
 				PLPresetCache::Get().CachePreset(inPresetFile, preset);
 			}
 			else
@@ -703,6 +850,41 @@ IPLPresetRef FileBasedPLPresetHandler::ReadPresetFromFile(
 	return preset;
 }
 
+/*
+**
+*/
+IPLPresetRef FileBasedPLPresetHandler::ParsePresetFile(
+	const dvacore::UTF16String& inPresetFile,
+	PLPresetCategory inCategory)
+{
+	IPLPresetRef preset;
+	BE::IXMLFileReaderRef presetReader(ASL::CreateClassInstanceRef(BE::kXMLFileReaderClassID));
+	
+	if(ASL::ResultSucceeded(presetReader->ReadFromFile(inPresetFile)))//File exists
+	{
+		switch (inCategory)
+		{
+		case PLPreCategory_Rename: 
+			preset = IPLPresetRef(PLPresetRename::CreateClassRef());
+			break;
+
+		case PLPreCategory_Metadata:
+			preset = IPLPresetRef(PLPresetMetadata::CreateClassRef());
+			break;
+
+		default:
+			preset = IPLPresetRef(PLPreset::CreateClassRef());
+			break;
+		}
+		BE::ISerializeableRef(preset)->SerializeIn(
+			BE::ISerializeableRef(preset)->GetVersion(),
+			*presetReader->GetDataReader());
+		preset->SetPresetFullPath(inPresetFile);
+	}
+
+	return preset;
+}
+
 /*
 **
 */
@@ -25,11 +25,14 @@
 // Local
 #include "Preset/PLPresetCache.h"
 #include "Preset/FileBasedPLPresetHandler.h"
+#include "Preset/PLPreset.h"
 
 // ASL
 #include "ASLClassFactory.h"
+#include "ASLPathUtils.h"
 #include "ASLResourceUtils.h"
 #include "ASLLanguageIDs.h"
+#include "ASLStationUtils.h"
 
 // DVA
 #include "dvacore/filesupport/file/SafeSave.h"
@@ -38,6 +41,7 @@
 // Backend
 #include "BE/Core/IXMLFileReader.h"
 #include "BE/Core/IXMLFileWriter.h"
+#include "BE/Core/ISerializeable.h"
 #include "BEXML.h"
 #include "BEProperties.h"
 #include "BEBackend.h"
@@ -46,6 +50,10 @@ namespace PL
 {
 PLPresetCache*	PLPresetCache::sPLPresetCache = NULL;
 
+ASL_MESSAGE_MAP_DEFINE(PLPresetCache)
+	ASL_MESSAGE_HANDLER(PresetListCached, OnPresetListCached)
+ASL_MESSAGE_MAP_END
+
 bool operator<(const PLPresetMapKey& inArg1, const PLPresetMapKey& inArg2)
 {
 	if(inArg1.mDirPath != inArg2.mDirPath)
@@ -71,6 +79,9 @@ void PLPresetCache::Initialize()
 
 void PLPresetCache::Terminate()
 {
+	// Background scans write into the cache, let them finish before it goes away.
+	FileBasedPLPresetHandler::StopPresetScans();
+
 	if(sPLPresetCache)
 	{
 		delete sPLPresetCache;
@@ -155,9 +166,36 @@ static const BE::Key				kPLPresetLanguage(BE_MAKEKEY("PLPresetLanguage"));
 static const BE::Key				kPLDirectoryPathKey(BE_MAKEKEY("PLDirectoryPath"));
 
 static const BE::Key				kMapKey(BE_MAKEKEY("Key"));
+static const BE::Key				kPLPresetFilePathKey(BE_MAKEKEY("PLPresetFilePath"));
+static const BE::Key				kPLPresetModificationTimeKey(BE_MAKEKEY("PLPresetModificationTime"));
+static const BE::Key				kPLPresetTypeKey(BE_MAKEKEY("PLPresetType"));
+static const BE::Key				kPLPresetDataKey(BE_MAKEKEY("PLPresetData"));
+
+namespace
+{
+	/*
+	**	Presets in the snapshot are recreated from their file extension, the same way the
+	**	file based handler picks the preset class for a category.
+	*/
+	IPLPresetRef CreatePresetForFile(const dvacore::UTF16String& inPresetFile)
+	{
+		const dvacore::UTF16String extension = ASL::PathUtils::GetExtensionPart(inPresetFile);
+		if (extension == AbstractPLPresetHandler::kRenamePresetFileExtension)
+		{
+			return IPLPresetRef(PLPresetRename::CreateClassRef());
+		}
+		if (extension == AbstractPLPresetHandler::kMetadataPresetFileExtension)
+		{
+			return IPLPresetRef(PLPresetMetadata::CreateClassRef());
+		}
+		return IPLPresetRef();
+	}
+}
 
 PLPresetCache::PLPresetCache()
 {
+	ASL::StationUtils::AddListener(kFileBasePLPresetHandlerWorkerStation, this);
+
 	BE::IBackendRef backend = BE::GetBackend();
 	BE::IPropertiesRef properties(backend);
 
@@ -201,13 +239,30 @@ PLPresetCache::PLPresetCache()
 					{
 						break;
 					}
-					
-					//ProxyPreset	proxyPreset;
-					//proxyPreset.SerializeIn(currentPresetReader->GetVersion(), *currentPresetReader);
-					//dvacore::UTF16String	filePath(proxyPreset.GetPresetFilePath());
-
-					//mDirToFilePresetProxyMap[dirPath].insert(FileToProxyPresetMap::value_type(filePath, proxyPreset));
 					++currentPresetIndex;
+
+					// Records are only loaded here, GetPreset checks them against the file's
+					// modification time before handing one out.
+					dvacore::UTF16String filePath;
+					ASL::UInt64 modificationTime = 0;
+					ASL::UInt32 presetType = kPLPresetType_USER;
+					currentPresetReader->ReadValue(kPLPresetFilePathKey, filePath);
+					currentPresetReader->ReadValue(kPLPresetModificationTimeKey, modificationTime);
+					currentPresetReader->ReadValue(kPLPresetTypeKey, presetType);
+
+					BE::DataReaderPtr presetDataReader = currentPresetReader->GetNestedData(0);
+					IPLPresetRef preset = CreatePresetForFile(filePath);
+					if (!preset || !presetDataReader)
+					{
+						continue;
+					}
+
+					BE::ISerializeableRef(preset)->SerializeIn(presetDataReader->GetVersion(), *presetDataReader);
+					preset->SetPresetFullPath(filePath);
+					preset->SetPresetType(static_cast<PLPresetType>(presetType));
+
+					PLPresetRecord record = { static_cast<ASL::FileTime>(modificationTime), preset };
+					mPresetCache[filePath] = record;
 				}
 
 				++currentIndex;
@@ -217,6 +272,16 @@ PLPresetCache::PLPresetCache()
 }
 
 PLPresetCache::~PLPresetCache()
+{
+	ASL::StationUtils::RemoveListener(kFileBasePLPresetHandlerWorkerStation, this);
+}
+
+void PLPresetCache::OnPresetListCached(const dvacore::UTF16String& inPresetFolder)
+{
+	WriteSnapshot();
+}
+
+void PLPresetCache::WriteSnapshot()
 {
 	BE::IBackendRef backend = BE::GetBackend();
 	BE::IPropertiesRef properties(backend);
@@ -230,21 +295,49 @@ PLPresetCache::~PLPresetCache()
 
 	BE::DataWriterPtr rootObj = fileWriter->GetDataWriter();
 	ASL::UInt32 currentIndex = 0;
-	//BOOST_FOREACH (DirToFilePresetProxyMap::value_type entry, mDirToFilePresetProxyMap)
-	//{
-	//	BE::DataWriterPtr dirWriter = rootObj->CreateNestedData(kMapKey, currentIndex);
-	//	dirWriter->WriteValue(kDirectoryPathKey, entry.first);
-
-	//	ASL::UInt32 currentPresetInfoIndex = 0;
-	//	BOOST_FOREACH (FileToProxyPresetMap::value_type presetProxyEntry, mDirToFilePresetProxyMap[entry.first])
-	//	{
-	//		BE::DataWriterPtr presetProxyWriter = dirWriter->CreateNestedData(kMapKey, currentPresetInfoIndex);
-	//		presetProxyEntry.second.SerializeOut(*presetProxyWriter);
-	//		++currentPresetInfoIndex;
-	//	}
-	//	
-	//	++currentIndex;
-	//}
+
+	// Scans of other folders may still be caching presets, so write from a copy.
+	PresetCacheMap presetCache;
+	{
+		ASL::CriticalSectionLock lock(mPresetCriticalSection);
+		presetCache = mPresetCache;
+	}
+
+	// Group the still valid records by folder, stale ones would be dropped on the next lookup anyway.
+	typedef std::map<dvacore::UTF16String, std::vector<PresetCacheMap::const_iterator> > DirToRecordsMap;
+	DirToRecordsMap dirToRecords;
+	for (PresetCacheMap::const_iterator it = presetCache.begin(); it != presetCache.end(); ++it)
+	{
+		ASL::FileTime modificationTime = 0;
+		if (ASL::ResultSucceeded(ASL::File::GetLastModificationTime(it->first, modificationTime)) &&
+			modificationTime == it->second.mModificationTime &&
+			CreatePresetForFile(it->first))
+		{
+			dirToRecords[dvacore::filesupport::File(it->first).Parent().FullPath()].push_back(it);
+		}
+	}
+
+	BOOST_FOREACH (DirToRecordsMap::value_type const& entry, dirToRecords)
+	{
+		BE::DataWriterPtr dirWriter = rootObj->CreateNestedData(kMapKey, currentIndex);
+		dirWriter->WriteValue(kPLDirectoryPathKey, entry.first);
+
+		ASL::UInt32 currentPresetIndex = 0;
+		BOOST_FOREACH (PresetCacheMap::const_iterator recordIter, entry.second)
+		{
+			const PLPresetRecord& record = recordIter->second;
+			BE::DataWriterPtr presetWriter = dirWriter->CreateNestedData(kMapKey, currentPresetIndex);
+			presetWriter->WriteValue(kPLPresetFilePathKey, recordIter->first);
+			presetWriter->WriteValue(kPLPresetModificationTimeKey, static_cast<ASL::UInt64>(record.mModificationTime));
+			presetWriter->WriteValue(kPLPresetTypeKey, static_cast<ASL::UInt32>(record.mPreset->GetPresetType()));
+
+			BE::DataWriterPtr presetDataWriter = presetWriter->CreateNestedData(kPLPresetDataKey, 0);
+			BE::ISerializeableRef(record.mPreset)->SerializeOut(*presetDataWriter);
+			++currentPresetIndex;
+		}
+
+		++currentIndex;
+	}
 
 	fileWriter->WriteToFile(safeSaveCache.GetTempFile().FullPath());
 	try
@@ -253,7 +346,7 @@ PLPresetCache::~PLPresetCache()
 	}
 	catch (dvacore::filesupport::file_exception&)
 	{
-		// Ignore errors if we can't serialize the system preset cache so that we can continue with the exit sequence.
+		// Ignore errors if we can't serialize the preset cache, the presets are read from their files instead.
 	}
 }
 
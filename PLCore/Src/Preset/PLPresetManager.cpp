@@ -42,14 +42,24 @@
 
 namespace PL
 {
+
+ASL_MESSAGE_MAP_DEFINE(PLPresetManager)
+	ASL_MESSAGE_HANDLER(PresetsLoaded, OnPresetsLoaded)
+	ASL_MESSAGE_HANDLER(PresetListCached, OnPresetListCached)
+ASL_MESSAGE_MAP_END
+
 /*
 **
 */
 PLPresetManager::PLPresetManager()
 	:
-	mStationID(GetPresetManagerStationID())
+	mStationID(GetPresetManagerStationID()),
+	mUserPresetSnapshotLoaded(false),
+	mUserPresetLoadPending(false),
+	mUserPresetReloadRequested(false)
 {
 	ASL::CriticalSectionLock lock(m_rg); //serialize concurrent threads
+	ASL::StationUtils::AddListener(kFileBasePLPresetHandlerWorkerStation, this);
 }
 
 /*
@@ -57,6 +67,7 @@ PLPresetManager::PLPresetManager()
 */
 PLPresetManager::~PLPresetManager()
 {
+	ASL::StationUtils::RemoveListener(kFileBasePLPresetHandlerWorkerStation, this);
 }
 
 /*
@@ -144,6 +155,101 @@ IPLPresets PLPresetManager::GetUserPresets(bool inUseCache)
 	return mPresetHandler->GetUserPresets(inUseCache);
 }
 
+/*
+**
+*/
+void PLPresetManager::RequestUserPresets()
+{
+	ASL::CriticalSectionLock lock(m_rg); //serialize concurrent threads
+	if (mUserPresetLoadPending)
+	{
+		// The running scan may have listed the folder already, start another one when it is done.
+		mUserPresetReloadRequested = true;
+		return;
+	}
+
+	mUserPresetLoadPending = true;
+	mLoadingUserPresets.clear();
+	mPresetHandler->RequestUserPresets();
+}
+
+/*
+**
+*/
+IPLPresets PLPresetManager::GetUserPresetSnapshot()
+{
+	ASL::CriticalSectionLock lock(m_rg); //serialize concurrent threads
+	if (!mUserPresetSnapshotLoaded && !mUserPresetLoadPending)
+	{
+		RequestUserPresets();
+	}
+	return mUserPresetSnapshot;
+}
+
+/*
+**
+*/
+void PLPresetManager::OnPresetsLoaded(
+	const dvacore::UTF16String& inPresetFolder,
+	const IPLPresets& inPresets)
+{
+	ASL::CriticalSectionLock lock(m_rg); //serialize concurrent threads
+	if (!mUserPresetLoadPending || inPresetFolder != mPresetHandler->GetUserPresetsLocation())
+	{
+		return;
+	}
+
+	BOOST_FOREACH(const IPLPresetRef& preset, inPresets)
+	{
+		if (mPresetHandler->AllowUserPreset(preset))
+		{
+			mLoadingUserPresets.push_back(preset);
+		}
+	}
+}
+
+/*
+**
+*/
+void PLPresetManager::OnPresetListCached(
+	const dvacore::UTF16String& inPresetFolder)
+{
+	IPLPresets loadedPresets;
+	{
+		ASL::CriticalSectionLock lock(m_rg); //serialize concurrent threads
+		if (!mUserPresetLoadPending || inPresetFolder != mPresetHandler->GetUserPresetsLocation())
+		{
+			return;
+		}
+
+		mUserPresetSnapshot.swap(mLoadingUserPresets);
+		mLoadingUserPresets.clear();
+		mUserPresetSnapshotLoaded = true;
+		mUserPresetLoadPending = false;
+		loadedPresets = mUserPresetSnapshot;
+
+		if (mUserPresetReloadRequested)
+		{
+			mUserPresetReloadRequested = false;
+			RequestUserPresets();
+		}
+	}
+
+	ASL::StationUtils::BroadcastMessage(mStationID, UserPresetsLoadedMessage(mPresetCategory, loadedPresets));
+}
+
+/*
+**
+*/
+void PLPresetManager::ReloadUserPresetSnapshot()
+{
+	ASL::CriticalSectionLock lock(m_rg); //serialize concurrent threads
+	if (mUserPresetSnapshotLoaded || mUserPresetLoadPending)
+	{
+		RequestUserPresets();
+	}
+}
+
 /*
 **
 */
@@ -192,6 +298,7 @@ ASL::Result PLPresetManager::ReplaceAsUserPreset(IPLPresetRef inOldPresetRef, IP
 
 	if (ASL::ResultSucceeded(result))
 	{
+		ReloadUserPresetSnapshot();
 		ASL::StationUtils::BroadcastMessage(mStationID,	PresetListChangedMessage_ReplaceUserPreset(inOldPresetRef, inOutNewPresetRef));		
 	}
 	
@@ -220,6 +327,7 @@ ASL::Result PLPresetManager::SaveAsUserPreset(
 		
 	if (ASL::ResultSucceeded(result))
 	{
+		ReloadUserPresetSnapshot();
 	}
 	
 	return result;
@@ -256,6 +364,7 @@ ASL::Result PLPresetManager::DeleteUserPreset(
 		
 	if (ASL::ResultSucceeded(result))
 	{
+		ReloadUserPresetSnapshot();
 	}
 	
 	return result;
@@ -278,6 +387,7 @@ ASL::Result PLPresetManager::DeleteUserPreset(
 
 	if (ASL::ResultSucceeded(result) && inPresets.size())
 	{
+		ReloadUserPresetSnapshot();
 	}
 	
 	return result;
@@ -425,6 +425,8 @@ bool SRProject::RemoveAllSRMedias()
 		RemoveSRMedia(mSRMedias, *iter);
 	}
 
+	SRMedia::DiscardPendingMediaInfoChanges();
+
 	return true;
 }
 	
@@ -965,7 +967,7 @@ void SRProject::OnMediaMetaDataNotInSync(ASL::PathnameList const& inPathList)
 			AssetMediaInfoWrapperMap::iterator mediaInfoIter = mAssetMediaInfoWrapperMap.find(clipPath);
 			if(mediaInfoIter != mAssetMediaInfoWrapperMap.end())
 			{
-				if (!Utilities::IsXMPStemEqual(xmpTest, mediaInfoIter->second->GetAssetMediaInfo()->GetXMPString()))
+				if (!Utilities::IsXMPStemEqual(xmpTest, mediaInfoIter->second->GetAssetMediaInfo()))
 				{
 					mediaInfoIter->second->RefreshMediaXMP(xmpTest, false, true);
 					assetMediaInfo = mediaInfoIter->second->GetAssetMediaInfo();
@@ -1151,6 +1153,24 @@ AssetMediaInfoWrapperPtr SRProject::GetAssetMediaInfoWrapper(const ASL::String&
 	return (iter != mAssetMediaInfoWrapperMap.end()) ? iter->second: AssetMediaInfoWrapperPtr();
 }
 
+/*
+**
+*/
+void SRProject::GetAssetMediaInfoWrappers(
+	const std::set<ASL::String>& inMediaPaths,
+	AssetMediaInfoWrapperMap& outWrappers) const
+{
+	ASL::CriticalSectionLock lock(GetLocker());
+	BOOST_FOREACH(const ASL::String& mediaPath, inMediaPaths)
+	{
+		AssetMediaInfoWrapperPtr mediaInfoWrapper = GetAssetMediaInfoWrapper(mediaPath);
+		if (mediaInfoWrapper != NULL)
+		{
+			outWrappers[mediaPath] = mediaInfoWrapper;
+		}
+	}
+}
+
 /*
 **
 */
@@ -1364,7 +1384,7 @@ void AssetMediaInfoWrapper::RefreshMediaXMP(XMPText const& inXMPTest, bool isSyn
 {
 	if (inXMPTest)
 	{
-		(*mAssetMediaInfo->GetXMPString()) = *inXMPTest;
+		mAssetMediaInfo->RefreshXMPString(inXMPTest);
 
 		ASL::String mediaInfoID;
 		if (UIF::IsEAMode())
@@ -1424,6 +1444,19 @@ ASL::Result AssetMediaInfoWrapper::GetLatestMetadataState(const dvacore::StdStri
 		partID = std::string(kXMPPartID_Metadata);
 	}
 
+	//	The common parts are read from the cached fingerprint instead of re-parsing the XMP.
+	if (partID == kXMPPartID_Tracks || partID == kXMPPartID_Metadata)
+	{
+		XMPFingerprintPtr fingerprint = mAssetMediaInfo->GetXMPFingerprint();
+		metadataState = (partID == kXMPPartID_Tracks) ? fingerprint->mTracksChangeID : fingerprint->mMetadataChangeID;
+		if (!metadataState.empty())
+		{
+			outMetadataState = metadataState;
+			result = ASL::kSuccess;
+		}
+		return result;
+	}
+
 	try	
 	{
 		SXMPDocOps xmpDocOps;
@@ -1431,7 +1464,7 @@ ASL::Result AssetMediaInfoWrapper::GetLatestMetadataState(const dvacore::StdStri
 		xmpDocOps.OpenXMP(reinterpret_cast<SXMPMeta*>(&meta), "");
 
 		//	We ask the doc ops if there is a part ID in this file.
-		xmpDocOps.GetPartChangeID(inPartID.c_str(), &metadataState);
+		xmpDocOps.GetPartChangeID(partID.c_str(), &metadataState);
 
 		if (!metadataState.empty())
 		{
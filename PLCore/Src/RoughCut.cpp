@@ -31,6 +31,7 @@
 #include "PLLibrarySupport.h"
 #include "PLModulePicker.h"
 #include "PLMarkers.h"
+#include "PLMarkerGuidIndex.h"
 #include "IPLMarkerOwner.h"
 
 //	MZ
@@ -105,6 +106,7 @@ void SaveRCCallBackRoutine(
 ASL_MESSAGE_MAP_DEFINE(SRRoughCut)
 	ASL_MESSAGE_HANDLER(MZ::ShowTimecodeStatusChanged, OnShowTimecodeStatusChanged)						
 	ASL_MESSAGE_HANDLER(MZ::UndoStackClearedMessage, OnUndoStackCleared)
+	ASL_MESSAGE_HANDLER(MZ::UndoStackChangedMessage, OnUndoStackChanged)
 	ASL_MESSAGE_HANDLER(PL::AssetItemNameChanged, OnAssetItemRename)
 ASL_MESSAGE_MAP_END
 
@@ -176,6 +178,9 @@ void SRRoughCut::Load()
 	mSequenceItem = BE::IProjectItemRef();
 	mClipItems.clear();
 
+	// No sequence yet, everything comes from the asset item.
+	MarkSynced();
+
 	const AssetItemList& subAssetItems = mAssetItem->GetSubAssetItemList();
 	AssetItemList::const_iterator iter = subAssetItems.begin();
 	AssetItemList::const_iterator end = subAssetItems.end();
@@ -208,7 +213,13 @@ SRRoughCut::SRRoughCut()
 				mIsDirty(false),
 				mUndoableActionCountAfterAutoSave(0),
 				mUserHasCanceledSaveFailure(false),
-				mIsWritable(false)
+				mIsWritable(false),
+				mClipItemsVersion(0),
+				mClipItemsSyncedVersion(0),
+				mTransitionsVersion(0),
+				mTransitionsSyncedVersion(0),
+				mSyncedUndoableActionCount(0),
+				mSyncedUndoPositionReachable(false)
 {
 	ASL::StationUtils::AddListener(MZ::kStation_Undo, this);
 }
@@ -427,6 +438,9 @@ void SRRoughCut::ResetRoughtClipItemFromSequence()
 
 	// For the left clips, we moved them to the trash.
 	mTrashItems = totalClipItems;
+
+	mClipItemsSyncedVersion = mClipItemsVersion;
+	NoteSyncPoint();
 }
 
 /*
@@ -546,6 +560,9 @@ void SRRoughCut::UpdateAssetItem()
 
 		mAssetItem->SetTrackTransitions(videoTransitions, BE::kMediaType_Video);
 		mAssetItem->SetTrackTransitions(audioTransitions, BE::kMediaType_Audio);
+
+		mTransitionsSyncedVersion = mTransitionsVersion;
+		NoteSyncPoint();
 	}
 }
 
@@ -744,6 +761,31 @@ bool SRRoughCut::TestIfRoughCutChanged()
 {
 	ASL::CriticalSectionLock lock(mCriticalSection); //serialize concurrent threads
 
+	if (GetBESequence() == NULL)
+	{
+		return false;
+	}
+
+	bool isChanged = 
+		mClipItemsVersion != mClipItemsSyncedVersion ||
+		mTransitionsVersion != mTransitionsSyncedVersion;
+
+#if ASL_DEBUG
+	// Versions may report a change the diff cannot see, but an edit the diff can see must
+	// always have bumped a version; this catches sequence edits made without an undo message.
+	DVA_ASSERT_MSG(isChanged || !DiffRoughCutWithSequence(), "Rough cut edit was not versioned");
+#endif
+
+	return isChanged;
+}
+
+/*
+**
+*/
+bool SRRoughCut::DiffRoughCutWithSequence()
+{
+	ASL::CriticalSectionLock lock(mCriticalSection); //serialize concurrent threads
+
 	// compare the sequence structure with mClipItems to see if it had been changed.
 	BE::ISequenceRef sequence = GetBESequence();
 	if (sequence == NULL)
@@ -859,6 +901,9 @@ bool SRRoughCut::CreateSequence()
 			mAssetItem->GetTrackTransitions(BE::kMediaType_Audio), 
 			sequenceTemplate, 
 			MZ::kSequenceAudioTrackRule_RoughCut);
+
+		ASL::CriticalSectionLock lock(mCriticalSection); //serialize concurrent threads
+		MarkSynced();
 	}
 	return true;
 }
@@ -1060,6 +1105,12 @@ bool SRRoughCut::AddClipItems(SRClipItems& ioClipItems, dvamediatypes::TickTime
 		pos = it;
 	}
 	
+	// mClipItems follows the inserted clips, so a synced rough cut stays synced; the undo message
+	// for the insert must not count as an edit.
+	bool wasSynced = 
+		mClipItemsVersion == mClipItemsSyncedVersion &&
+		mTransitionsVersion == mTransitionsSyncedVersion;
+
 	boost::function<void(SRClipItemPtr)> AddToRCClipItemsFxn(boost::bind(&SRRoughCut::ReverseInsertClipItem, this, pos, _1));
 	isSuccess = SilkRoadPrivateCreator::AddClipItemsToSequence(
 					mSequenceItem,
@@ -1071,6 +1122,11 @@ bool SRRoughCut::AddClipItems(SRClipItems& ioClipItems, dvamediatypes::TickTime
 					outChangedDuration,
                     false);
 
+	if (wasSynced)
+	{
+		MarkSynced();
+	}
+
 	// [TODO] Need calculate the index
 	if (!ioClipItems.empty())
 	{
@@ -1159,6 +1215,11 @@ bool SRRoughCut::RemoveSelectedTrackItem(bool inDoRipple, bool inAlignToVideo)
 		}
 	}
 
+	{
+		ASL::CriticalSectionLock lock(mCriticalSection); //serialize concurrent threads
+		RecordSequenceEdit();
+	}
+
 	MZ::Sequence sequence(sequenceRef);
 	sequence.ClearItems(inDoRipple, inAlignToVideo);
 
@@ -1189,12 +1250,23 @@ bool SRRoughCut::RemoveSelectedTrackItem(bool inDoRipple, bool inAlignToVideo)
 
 bool SRRoughCut::FindMarker(const CottonwoodMarker& inMarker) const
 {
-	const SRMarkersList& markerList = GetMarkersList();
-	SRMarkersList::const_iterator markerEnd = markerList.end();
-	SRMarkersList::const_iterator markerItr = markerList.begin();
-	for (; markerItr != markerEnd; ++markerItr)
+	// Ask the project-wide index which media own the marker, then only match clip paths.
+	MarkerMediaPathSet mediaPaths;
+	MarkerGuidIndex::SharedPtr markerGuidIndex = MarkerGuidIndex::GetInstance();
+	if (markerGuidIndex)
 	{
-		if ( (*markerItr)->HasMarker(inMarker.GetGUID()) )
+		markerGuidIndex->GetMediaPaths(inMarker.GetGUID(), mediaPaths);
+	}
+	if (mediaPaths.empty())
+	{
+		return false;
+	}
+
+	ASL::CriticalSectionLock lock(mCriticalSection);
+	for (SRClipItems::const_iterator f = mClipItems.begin(), l = mClipItems.end(); f != l; ++f)
+	{
+		ISRMediaRef srMedia = (*f)->GetSRMedia();
+		if (srMedia != NULL && mediaPaths.find(srMedia->GetClipFilePath()) != mediaPaths.end())
 		{
 			return true;
 		}
@@ -1305,6 +1377,7 @@ bool SRRoughCut::RelinkClipItem(SRClipItems& ioRelinkedClipItems)
 
 	void (SRClipItems::*ptr)(const SRClipItems::value_type&) = &SRClipItems::push_back;
 	boost::function<void(SRClipItemPtr)> AddToRCClipItemsFxn(boost::bind(ptr, &mClipItems, _1));
+	RecordSequenceEdit();
 	SilkRoadPrivateCreator::RelinkClipItems(mSequenceItem, relinkClipItemsPairVec, AddToRCClipItemsFxn);
 
 	return isSuccess;
@@ -1402,6 +1475,12 @@ void SRRoughCut::DiscardUnsavedChanges()
 	{
 		executor->Undo(currentUndoableActionCount - mUndoableActionCountAfterAutoSave);
 	}
+
+	{
+		// Undo and redo issued straight on the executor do not broadcast UndoStackChangedMessage.
+		ASL::CriticalSectionLock lock(mCriticalSection); //serialize concurrent threads
+		UpdateUndoPosition();
+	}
 	// if discard save, we clear mUserHasCanceledSaveFailure so that next time save failure will bring up dialog.
 	mUserHasCanceledSaveFailure = false;
 	SetDirty(false);
@@ -1440,4 +1519,81 @@ void SRRoughCut::OnUndoStackCleared()
 	mUndoableActionCountAfterAutoSave = executor->GetUndoableActionCount();
 }
 
+/*
+**
+*/
+void SRRoughCut::OnUndoStackChanged()
+{
+	ASL::CriticalSectionLock lock(mCriticalSection); //serialize concurrent threads
+
+	if (mIsAttached && mSequenceItem != NULL)
+	{
+		UpdateUndoPosition();
+	}
+}
+
+/*
+**
+*/
+void SRRoughCut::BumpEditVersion()
+{
+	++mClipItemsVersion;
+	++mTransitionsVersion;
+}
+
+/*
+**
+*/
+void SRRoughCut::RecordSequenceEdit()
+{
+	BumpEditVersion();
+	mSyncedUndoPositionReachable = false;
+}
+
+/*
+**
+*/
+void SRRoughCut::UpdateUndoPosition()
+{
+	BE::IExecutorRef executor(MZ::GetProject());
+	ASL::UInt32 undoableActionCount = executor != NULL ? executor->GetUndoableActionCount() : 0;
+	if (undoableActionCount < mSyncedUndoableActionCount)
+	{
+		mSyncedUndoPositionReachable = false;
+	}
+
+	if (mSyncedUndoPositionReachable && undoableActionCount == mSyncedUndoableActionCount)
+	{
+		mClipItemsSyncedVersion = mClipItemsVersion;
+		mTransitionsSyncedVersion = mTransitionsVersion;
+	}
+	else
+	{
+		BumpEditVersion();
+	}
+}
+
+/*
+**
+*/
+void SRRoughCut::MarkSynced()
+{
+	mClipItemsSyncedVersion = mClipItemsVersion;
+	mTransitionsSyncedVersion = mTransitionsVersion;
+	NoteSyncPoint();
+}
+
+/*
+**
+*/
+void SRRoughCut::NoteSyncPoint()
+{
+	if (mClipItemsVersion == mClipItemsSyncedVersion && mTransitionsVersion == mTransitionsSyncedVersion)
+	{
+		BE::IExecutorRef executor(MZ::GetProject());
+		mSyncedUndoableActionCount = executor != NULL ? executor->GetUndoableActionCount() : 0;
+		mSyncedUndoPositionReachable = true;
+	}
+}
+
 } // namespace PL
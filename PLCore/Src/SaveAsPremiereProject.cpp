@@ -132,6 +132,7 @@ namespace PL
 typedef std::vector<PL::CottonwoodMarker> CWMarkerVector;
 typedef std::map<dvamediatypes::TickTime, CWMarkerVector> StartTimeMarkerMap;
 typedef std::pair<dvamediatypes::TickTime, CWMarkerVector> StartTimeMarkerPair;
+typedef std::map<ASL::Guid, BE::IProjectItemRef> BinProjectItemMap;
 
 namespace
 {
@@ -399,49 +400,56 @@ static bool GetParentBinInfo(ASL::String& ioRelativeBinPath, ASL::Guid& outParen
 	return true;
 }
 
-static BE::IProjectItemRef FindBinProjectItem(
+/*
+** Walk the project tree once and remember every bin by its unique ID.
+*/
+static void CollectBinProjectItems(
 	const BE::IProjectItemContainerRef& inContainer,
-	dvacore::utility::Guid inID)
+	BinProjectItemMap& ioBinProjectItems)
 {
-	if (inID == ASL::Guid())
+	if (!inContainer)
 	{
-		return BE::IProjectItemRef();
+		return;
 	}
 
-	BE::IProjectItemRef projectItem;
+	BE::ProjectItemVector items;
+	inContainer->GetItems(items);
 
-	if (inContainer)
+	for (BE::ProjectItemVector::const_iterator it = items.begin(); it != items.end(); ++it)
 	{
-		BE::ProjectItemVector items;
-		inContainer->GetItems(items);
-
-		for (BE::ProjectItemVector::const_iterator it = items.begin();
-			it != items.end() && !projectItem;
-			++it)
+		if ((*it)->GetType() != BE::kProjectItemType_Bin)
 		{
-			if ((*it)->GetType() != BE::kProjectItemType_Bin)
-			{
-				continue;
-			}
-
-			ASL::Guid projectItemGuid = BE::IUniqueSerializeableRef(*it)->GetUniqueID();
-			if (inID == projectItemGuid)
-			{
-				projectItem = *it;
-			}
-			else
-			{
-				projectItem = FindBinProjectItem(BE::IProjectItemContainerRef(*it), inID);
-			}
+			continue;
 		}
+
+		ioBinProjectItems[BE::IUniqueSerializeableRef(*it)->GetUniqueID()] = *it;
+		CollectBinProjectItems(BE::IProjectItemContainerRef(*it), ioBinProjectItems);
 	}
+}
 
-	return projectItem;
+/*
+**
+*/
+static BE::IProjectItemRef FindBinProjectItem(
+	const BinProjectItemMap& inBinProjectItems,
+	dvacore::utility::Guid inID)
+{
+	if (inID == ASL::Guid())
+	{
+		return BE::IProjectItemRef();
+	}
+
+	BinProjectItemMap::const_iterator it = inBinProjectItems.find(inID);
+	return (it != inBinProjectItems.end()) ? it->second : BE::IProjectItemRef();
 }
 
+/*
+** ioBinProjectItems must describe the bins of inProject; bins created here are added to it.
+*/
 static BE::IProjectItemRef BuildProjectContainerForItem(
 	BE::IProjectRef const& inProject, 
 	AssetItemPtr const& inAssetItem,
+	BinProjectItemMap& ioBinProjectItems,
 	BE::ProjectItemVector& outAddedProjectItemVector)
 {
 	BE::IProjectItemRef binProjectItem = inProject->GetRootProjectItem();
@@ -453,11 +461,12 @@ static BE::IProjectItemRef BuildProjectContainerForItem(
 	BE::IProjectItemRef parentContainer = inProject->GetRootProjectItem();
 	while (GetParentBinInfo(parentBinPath, parentBinGUID, parentBinName))
 	{
-		binProjectItem = FindBinProjectItem((BE::IProjectItemContainerRef)parentContainer, parentBinGUID);
+		binProjectItem = FindBinProjectItem(ioBinProjectItems, parentBinGUID);
 		if (binProjectItem == BE::IProjectItemRef())
 		{
 			binProjectItem = MZ::ProjectActions::CreateBin(inProject, parentContainer, parentBinName, false);
 			BE::IUniqueSerializeableRef(binProjectItem)->SetUniqueID(parentBinGUID);
+			ioBinProjectItems[parentBinGUID] = binProjectItem;
 			outAddedProjectItemVector.push_back(binProjectItem);
 		}
 		parentContainer = binProjectItem;
@@ -593,6 +602,7 @@ static BE::ISequenceRef CreateBESequenceFromRCSubClipsInternal(
 	ASL::String const& inSequenceName,
 	MediaPathVec& outPathList,
 	RelatedMasterClipMap& ioRelatedMasterClips,
+	BinProjectItemMap& ioBinProjectItems,
 	BE::ProjectItemVector& outAddedProjectItemVector,
 	ASL::String& outErrorInfo,
 	ASL::String& outFailedMediaName,
@@ -632,7 +642,7 @@ static BE::ISequenceRef CreateBESequenceFromRCSubClipsInternal(
 						MZ::ExecuteActionWithoutUndo(BE::IExecutorRef(masterClip), BE::IActionRef(masterClip->CreateSetNameAction(mediaAliasName)), false);
 
 						MZ::ClipActions::SetScaleToFrameSize(masterClip, inScaleToFrame, false);
-						BE::IProjectItemRef masterClipBinItem = BuildProjectContainerForItem(inProject, (*it).first, outAddedProjectItemVector);
+						BE::IProjectItemRef masterClipBinItem = BuildProjectContainerForItem(inProject, (*it).first, ioBinProjectItems, outAddedProjectItemVector);
 						MZ::ProjectActions::AddMasterClipToBin(inProject, masterClipBinItem, masterClip, false);
 
 						outAddedProjectItemVector.push_back(MZ::Project(inProject).FindMasterClip(masterClip));
@@ -765,6 +775,7 @@ static void ImportRoughCutDataForExport(
 	MediaPathVec& outPathList,
 	bool inIsExportSequenceMarkers,
 	RelatedMasterClipMap& ioRelatedMasterClips,
+	BinProjectItemMap& ioBinProjectItems,
 	BE::ProjectItemVector& outAddedProjectItemVector)
 {
 	DVA_ASSERT(inAssetItem->GetAssetMediaType() == kAssetLibraryType_RoughCut);
@@ -781,6 +792,7 @@ static void ImportRoughCutDataForExport(
 		sequenceName,
 		outPathList,
 		ioRelatedMasterClips,
+		ioBinProjectItems,
 		outAddedProjectItemVector,
 		errorInfo,
 		failedMediaName,
@@ -1177,6 +1189,9 @@ ISaveAsPremiereProjectOperationRef CreateSaveAsPremiereProjectOperation(
 	RelatedMasterClipMap relatedMasterClips;
 	BuildRCRelatedMasterClips(inAssetItems, relatedMasterClips);
 
+	BinProjectItemMap binProjectItems;
+	CollectBinProjectItems(BE::IProjectItemContainerRef(newProject->GetRootProjectItem()), binProjectItems);
+
 	if (inProgress)
 	{
 		inProgress->StartProgress(1,  inAssetItems.size());
@@ -1188,7 +1203,7 @@ ISaveAsPremiereProjectOperationRef CreateSaveAsPremiereProjectOperation(
 	{
 		if ( *it != NULL )
 		{
-			BE::IProjectItemRef binProjectItem = BuildProjectContainerForItem(newProject, *it, outAddedProjectItemVector);
+			BE::IProjectItemRef binProjectItem = BuildProjectContainerForItem(newProject, *it, binProjectItems, outAddedProjectItemVector);
 			const dvacore::UTF16String& path = (*it)->GetMediaPath();
 			switch ( (*it)->GetAssetMediaType() )
 			{
@@ -1203,7 +1218,7 @@ ISaveAsPremiereProjectOperationRef CreateSaveAsPremiereProjectOperation(
 			case PL::kAssetLibraryType_RoughCut:
 				{
 					MediaPathVec pathList;
-					ImportRoughCutDataForExport(newProject, binProjectItem, *it, pathList, inTreatMarkerAsSequenceMarker, relatedMasterClips, outAddedProjectItemVector);
+					ImportRoughCutDataForExport(newProject, binProjectItem, *it, pathList, inTreatMarkerAsSequenceMarker, relatedMasterClips, binProjectItems, outAddedProjectItemVector);
 
 					BOOST_FOREACH(ASL::String const& path, pathList)
 					{
@@ -1271,6 +1286,9 @@ BE::ISequenceRef CreateBESequenceFromRCSubClips(
 		RelatedMasterClipMap ioRelatedMasterClips;
 		BE::ProjectItemVector outAddedProjectItemVector;
 
+		BinProjectItemMap binProjectItems;
+		CollectBinProjectItems(BE::IProjectItemContainerRef(inProject->GetRootProjectItem()), binProjectItems);
+
 		return CreateBESequenceFromRCSubClipsInternal(
 			inSubAssetItems,
 			inProject,
@@ -1278,6 +1296,7 @@ BE::ISequenceRef CreateBESequenceFromRCSubClips(
 			inSequenceName,
 			outPathList,
 			ioRelatedMasterClips,
+			binProjectItems,
 			outAddedProjectItemVector,
 			outErrorInfo,
 			outFailedMediaName,
@@ -99,15 +99,19 @@ ASL::StationID TagTemplateCollection::GetStationID()
 */
 void TagTemplateCollection::Initialize()
 {
-	ASL::CriticalSectionLock lock(TagTemplateCollection::GetLocker());
-	if (!sTagTemplateCollection)
+	TagTemplateCollection::SharedPtr tagTemplateCollection;
 	{
-		sTagTemplateCollection.reset(new TagTemplateCollection());
-		sTagTemplateCollection->LoadTagTemplateList();
+		ASL::CriticalSectionLock lock(TagTemplateCollection::GetLocker());
+		if (!sTagTemplateCollection)
+		{
+			sTagTemplateCollection.reset(new TagTemplateCollection());
+		}
+		tagTemplateCollection = sTagTemplateCollection;
 	}
 
-	ASL_ASSERT(sTagTemplateCollection);
-	ASL::StationRegistry::RegisterStation(sTagTemplateCollection->GetStationID());
+	ASL_ASSERT(tagTemplateCollection);
+	tagTemplateCollection->LoadTagTemplateList();
+	ASL::StationRegistry::RegisterStation(tagTemplateCollection->GetStationID());
 }
 
 /*
@@ -318,24 +322,43 @@ ASL::CriticalSection& TagTemplateCollection::GetLocker()
 */
 void TagTemplateCollection::LoadTagTemplateList()
 {
-	ASL::CriticalSectionLock lock(TagTemplateCollection::GetLocker());
+	{
+		ASL::CriticalSectionLock lock(TagTemplateCollection::GetLocker());
+		if (IsDataReady())
+		{
+			return;
+		}
+		SetSystemTagTemplatePath(TagUtilities::GetSystemTagTemplateFolderPath());
+	}
+
+	// Walking the template folders touches the disk, readers must not wait on that.
+	TagTemplateList systemTagTemplates;
+	TagTemplateList userTagTemplates;
+	ImportSystemTagTemplates(systemTagTemplates);
+	ImportUserTagTemplates(userTagTemplates);
 
-	if(!IsDataReady())
 	{
-		sTagTemplateCollection->SetSystemTagTemplatePath(TagUtilities::GetSystemTagTemplateFolderPath());
-		ImportSystemTagTemplates();
-		ImportUserTagTemplates();
+		ASL::CriticalSectionLock lock(TagTemplateCollection::GetLocker());
+		if (IsDataReady())
+		{
+			return;
+		}
+		mSystemTagTemplates.insert(mSystemTagTemplates.end(), systemTagTemplates.begin(), systemTagTemplates.end());
+		mUserTagTemplates.insert(mUserTagTemplates.end(), userTagTemplates.begin(), userTagTemplates.end());
 		SetDataReady(true);
 	}
+
+	TagTemplateList allTagTemplates(systemTagTemplates);
+	allTagTemplates.insert(allTagTemplates.end(), userTagTemplates.begin(), userTagTemplates.end());
+	TagTemplateInfo::LoadHeadersInBackground(allTagTemplates);
 }
 
 /*
 **
 */
-void TagTemplateCollection::ImportSystemTagTemplates()
+void TagTemplateCollection::ImportSystemTagTemplates(TagTemplateList& outTagTemplates)
 {
-	ASL::CriticalSectionLock lock(TagTemplateCollection::GetLocker());
-	dvacore::filesupport::Dir systemTagTemplateFolder(mSystemTagTemplatePath);
+	dvacore::filesupport::Dir systemTagTemplateFolder(GetSystemTagTemplatePath());
 
 	if (!systemTagTemplateFolder.Exists())
 	{
@@ -358,7 +381,7 @@ void TagTemplateCollection::ImportSystemTagTemplates()
 
 				if (newTagTemplate)
 				{
-					mSystemTagTemplates.push_back(newTagTemplate);
+					outTagTemplates.push_back(newTagTemplate);
 				}
 			}
 		}
@@ -368,10 +391,8 @@ void TagTemplateCollection::ImportSystemTagTemplates()
 /*
 **
 */
-void TagTemplateCollection::ImportUserTagTemplates()
+void TagTemplateCollection::ImportUserTagTemplates(TagTemplateList& outTagTemplates)
 {
-	ASL::CriticalSectionLock lock(TagTemplateCollection::GetLocker());
-
 	BE::IBackendRef backend = BE::GetBackend();
 	BE::IPropertiesRef backendProps(backend);
 
@@ -389,7 +410,7 @@ void TagTemplateCollection::ImportUserTagTemplates()
 
 				if (newTagTemplate)
 				{
-					mUserTagTemplates.push_back(newTagTemplate);
+					outTagTemplates.push_back(newTagTemplate);
 				}
 			}
 		}
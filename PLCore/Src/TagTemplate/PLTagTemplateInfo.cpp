@@ -35,6 +35,7 @@
 #include "dvacore/filesupport/file/FileException.h"
 #include "dvacore/debug/Debug.h"
 
+#include "boost/bind.hpp"
 #include "boost/foreach.hpp"
 
 // Local
@@ -42,13 +43,44 @@
 #include "TagTemplate/IPLTagTemplate.h"
 #include "TagTemplate/PLTagUtilities.h"
 #include "PLMessage.h"
+#include "PLThreadUtils.h"
 
 namespace PL
 {
+	namespace
+	{
+		const ASL::String kTagTemplateHeaderExecutorName = ASL_STR("TagTemplateHeaderLoader");
+
+		/*
+		**	Shown until the template file has been parsed, and when it cannot be.
+		*/
+		TagTemplateHeader MakePlaceholderHeader(const dvacore::UTF16String& inTagTemplatePath)
+		{
+			TagTemplateHeader header;
+			header.mName = ASL::PathUtils::GetFilePart(inTagTemplatePath);
+			return header;
+		}
+
+		bool HeadersEqual(const TagTemplateHeader& inLHS, const TagTemplateHeader& inRHS)
+		{
+			return inLHS.mGuid == inRHS.mGuid &&
+				inLHS.mName == inRHS.mName &&
+				inLHS.mRows == inRHS.mRows &&
+				inLHS.mColumns == inRHS.mColumns;
+		}
+	}
+
 	/*
 	**
 	*/
-	TagTemplateInfo::TagTemplateInfo(){}
+	TagTemplateInfo::TagTemplateInfo()
+		:
+		mIsReadOnly(false),
+		mHeaderLoaded(false),
+		mHeaderLoadPending(false),
+		mHeaderParsed(false)
+	{
+	}
 
 	/*
 	**
@@ -63,7 +95,7 @@ namespace PL
 		const ASL::String& inTagTemplatePath)
 	{
 		mTagTemplateID		= inTagTemplateID;
-		mTagTemplatePath	= inTagTemplatePath;
+		SetTagTemlatePath(inTagTemplatePath);
 	}
 
 	/*
@@ -87,6 +119,7 @@ namespace PL
 	*/
 	dvacore::UTF16String TagTemplateInfo::GetTagTemplatePath() const
 	{
+		ASL::CriticalSectionLock lock(mHeaderCriticalSection);
 		return mTagTemplatePath;
 	}
 
@@ -95,7 +128,12 @@ namespace PL
 	*/	
 	void TagTemplateInfo::SetTagTemlatePath(const dvacore::UTF16String& inTagTemplatePath)
 	{
+		ASL::CriticalSectionLock lock(mHeaderCriticalSection);
 		mTagTemplatePath = inTagTemplatePath;
+		// The header of the previous file must not survive a failed parse of the new one.
+		mHeader = MakePlaceholderHeader(inTagTemplatePath);
+		mHeaderLoaded = false;
+		mHeaderParsed = false;
 	}
 
 	/*
@@ -103,26 +141,174 @@ namespace PL
 	*/
 	dvacore::UTF16String TagTemplateInfo::GetTagTemplateName() const
 	{
-		if (mTagTemplateName.empty())
+		return GetHeader().mName;
+	}
+
+	/*
+	**
+	*/
+	dvacore::utility::Guid TagTemplateInfo::GetTagTemplateGUID() const
+	{
+		return GetHeader().mGuid;
+	}
+
+	/*
+	**
+	*/
+	ASL::UInt32 TagTemplateInfo::GetRows() const
+	{
+		return GetHeader().mRows;
+	}
+
+	/*
+	**
+	*/
+	ASL::UInt32 TagTemplateInfo::GetColumns() const
+	{
+		return GetHeader().mColumns;
+	}
+
+	/*
+	**
+	*/
+	void TagTemplateInfo::OnTagTemplateNameChanged() const
+	{
+		LoadHeader();
+	}
+
+	/*
+	**
+	*/
+	void TagTemplateInfo::EnsureHeaderLoaded() const
+	{
+		LoadHeaderIfNeeded();
+	}
+
+	/*
+	**
+	*/
+	void TagTemplateInfo::LoadHeadersInBackground(const TagTemplateList& inTagTemplates)
+	{
+		if (inTagTemplates.empty())
+		{
+			return;
+		}
+
+		dvacore::threads::AsyncThreadedExecutorPtr executor = PL::threads::GetExecutor(kTagTemplateHeaderExecutorName);
+		if (executor == NULL)
 		{
-			OnTagTemplateNameChanged();
+			executor = PL::threads::CreateAndRegisterExecutor(
+				kTagTemplateHeaderExecutorName,
+				dvacore::threads::kThreadAllocationPolicies_SingleThreaded,
+				true);
 		}
-		return mTagTemplateName;
+		executor->CallAsynchronously(boost::bind(&TagTemplateInfo::LoadHeaders, inTagTemplates));
 	}
 
 	/*
 	**
 	*/
-	void TagTemplateInfo::OnTagTemplateNameChanged() const
+	void TagTemplateInfo::LoadHeaders(TagTemplateList inTagTemplates)
+	{
+		ASL::StringVector changedPaths;
+		BOOST_FOREACH(TagTemplateInfoPtr tagTemplate, inTagTemplates)
+		{
+			if (tagTemplate->LoadHeaderIfNeeded())
+			{
+				changedPaths.push_back(tagTemplate->GetTagTemplatePath());
+			}
+		}
+
+		if (!changedPaths.empty())
+		{
+			ASL::StationUtils::PostMessageToUIThread(
+				TagUtilities::GetTagTemplateStationID(),
+				TagTemplateChangedMessage(changedPaths),
+				true);
+		}
+	}
+
+	/*
+	**
+	*/
+	TagTemplateHeader TagTemplateInfo::GetHeader() const
+	{
+		TagTemplateHeader header;
+		bool requestLoad = false;
+		{
+			ASL::CriticalSectionLock lock(mHeaderCriticalSection);
+			if (!mHeaderLoaded && !mHeaderLoadPending)
+			{
+				mHeaderLoadPending = true;
+				requestLoad = true;
+			}
+			header = mHeader;
+		}
+
+		if (requestLoad)
+		{
+			LoadHeadersInBackground(TagTemplateList(1, boost::const_pointer_cast<TagTemplateInfo>(shared_from_this())));
+		}
+		return header;
+	}
+
+	/*
+	**
+	*/
+	bool TagTemplateInfo::LoadHeaderIfNeeded() const
+	{
+		{
+			ASL::CriticalSectionLock lock(mHeaderCriticalSection);
+			if (mHeaderLoaded)
+			{
+				mHeaderLoadPending = false;
+				return false;
+			}
+		}
+		return LoadHeader();
+	}
+
+	/*
+	**
+	*/
+	bool TagTemplateInfo::LoadHeader() const
 	{
-		auto originalName = mTagTemplateName;
-		auto tagTemplate = PL::LoadTagTemplate(mTagTemplatePath);
-		if (tagTemplate != NULL)
+		dvacore::UTF16String tagTemplatePath;
+		{
+			ASL::CriticalSectionLock lock(mHeaderCriticalSection);
+			tagTemplatePath = mTagTemplatePath;
+		}
+
+		TagTemplateHeader header;
+		bool const parsed = PL::LoadTagTemplateHeader(tagTemplatePath, header);
+		if (!parsed)
+		{
+			header = TagTemplateHeader();
+		}
+		if (header.mName.empty())
+		{
+			header.mName = ASL::PathUtils::GetFilePart(tagTemplatePath);
+		}
+
+		ASL::CriticalSectionLock lock(mHeaderCriticalSection);
+		// A reader arriving after this queues a new load if the result below is dropped.
+		mHeaderLoadPending = false;
+		// The path may have been changed while parsing, that result belongs to the next load.
+		if (tagTemplatePath != mTagTemplatePath)
+		{
+			return false;
+		}
+
+		bool changed = false;
+		// A file caught mid-save fails to parse, keep showing the header read before.
+		if (parsed || !mHeaderParsed)
 		{
-			mTagTemplateName = tagTemplate->GetName();
+			changed = !HeadersEqual(mHeader, header);
+			mHeader = header;
+			mHeaderParsed = parsed;
 		}
-		if (mTagTemplateName.empty())
-			mTagTemplateName = ASL::PathUtils::GetFilePart(mTagTemplatePath);
+		mHeaderLoaded = true;
+		return changed;
 	}
 
 	/*
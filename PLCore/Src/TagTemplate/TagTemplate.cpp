@@ -73,6 +73,31 @@ namespace
 	const std::wstring kKeyName_ShortcutAlt = AsciiToWString("shortcut_alt");
 	const std::wstring kKeyName_ShortcutShift = AsciiToWString("shortcut_shift");
 	const std::wstring kKeyName_ShortcutMacCtrl = AsciiToWString("shortcut_macctrl");
+
+	/*
+	**	Throws on unreadable or malformed files, callers catch like FromFile does.
+	*/
+	void ReadPTreeFromFile(const dvacore::UTF16String& inPath, boost::property_tree::wptree& outPTree)
+	{
+		// Bug fix 3704993
+		// Cannot pass file name directly to read_json because read_json only accept 
+		// std::string as the file name which is not acceptable for double byte file name (such as Chinese)
+		// so we need to generate stream with double byte file name firstly
+		// Note: try to convert UTF16 file name to UTF8 and store it into std::string 
+		// is not a good idea here, since Windows use GB2312 (by default) to show the file name 
+		// in this way all UTF8 file name will be messy code (this is why the bug only reproduce on Win, 
+		// since Linux & Mac use UTF8 file name)
+		// Furthemore since file name created as UTF8, so search it by file name which is in UTF16
+		// return incorrect result, this is also the root cause of bug 3704993
+#ifdef DVA_OS_WIN
+		std::basic_ifstream<boost::property_tree::wptree::key_type::value_type>
+            stream(inPath.c_str());
+#else
+		std::basic_ifstream<boost::property_tree::wptree::key_type::value_type>
+			stream(ASL::MakeStdString(inPath).c_str());
+#endif
+		boost::property_tree::read_json(stream, outPTree);
+	}
 }
 
 namespace PL
@@ -92,6 +117,11 @@ IPLTagTemplateReadonlyRef LoadTagTemplate(const ASL::String& inPath)
 	return IPLTagTemplateReadonlyRef(TagTemplate::FromFile(inPath));
 }
 
+bool LoadTagTemplateHeader(const ASL::String& inPath, TagTemplateHeader& outHeader)
+{
+	return TagTemplate::HeaderFromFile(inPath, outHeader);
+}
+
 IPLTagTemplateReadonlyRef BuildTagTemplate(const ASL::String& inContent)
 {
 	return IPLTagTemplateReadonlyRef(TagTemplate::FromContent(inContent));
@@ -260,24 +290,7 @@ PL::IPLTagTemplateWritableRef TagTemplate::FromFile(const dvacore::UTF16String&
 	DVA_ASSERT_MSG(inType == kFileType_JSON, "only support json format right now!");
 	try
 	{
-		// Bug fix 3704993
-		// Cannot pass file name directly to read_json because read_json only accept 
-		// std::string as the file name which is not acceptable for double byte file name (such as Chinese)
-		// so we need to generate stream with double byte file name firstly
-		// Note: try to convert UTF16 file name to UTF8 and store it into std::string 
-		// is not a good idea here, since Windows use GB2312 (by default) to show the file name 
-		// in this way all UTF8 file name will be messy code (this is why the bug only reproduce on Win, 
-		// since Linux & Mac use UTF8 file name)
-		// Furthemore since file name created as UTF8, so search it by file name which is in UTF16
-		// return incorrect result, this is also the root cause of bug 3704993
-#ifdef DVA_OS_WIN
-		std::basic_ifstream<boost::property_tree::wptree::key_type::value_type>
-            stream(inPath.c_str());
-#else
-		std::basic_ifstream<boost::property_tree::wptree::key_type::value_type>
-			stream(ASL::MakeStdString(inPath).c_str());
-#endif
-		boost::property_tree::read_json(stream, propertyTree);
+		ReadPTreeFromFile(inPath, propertyTree);
 		return FromPTree(propertyTree);
 	}
 	catch(...)
@@ -286,6 +299,21 @@ PL::IPLTagTemplateWritableRef TagTemplate::FromFile(const dvacore::UTF16String&
 	}
 }
 
+bool TagTemplate::HeaderFromFile(const dvacore::UTF16String& inPath, TagTemplateHeader& outHeader, FileType inType)
+{
+	boost::property_tree::wptree propertyTree;
+	DVA_ASSERT_MSG(inType == kFileType_JSON, "only support json format right now!");
+	try
+	{
+		ReadPTreeFromFile(inPath, propertyTree);
+		return HeaderFromPTree(propertyTree, outHeader);
+	}
+	catch(...)
+	{
+		return false;
+	}
+}
+
 PL::IPLTagTemplateWritableRef TagTemplate::FromContent(const dvacore::UTF16String& inContent, FileType inType)
 {
 	boost::property_tree::wptree propertyTree;
@@ -436,6 +464,55 @@ PL::IPLTagTemplateWritableRef TagTemplate::FromPTree(const boost::property_tree:
 	return PL::IPLTagTemplateWritableRef(tagTemplate);
 }
 
+/*
+**	Mirrors the top level part of FromPTree. Tags are only looked at for their positions when
+**	the file carries no dimension.
+*/
+bool TagTemplate::HeaderFromPTree(const boost::property_tree::wptree& inPTree, TagTemplateHeader& outHeader)
+{
+	ASL::String version = WStringToUTF16(inPTree.get<std::wstring>(kKeyName_Version));
+	if (version != ASL::MakeString(kTagTemplateVersion))
+	{
+		return false;
+	}
+
+	outHeader.mGuid = dvacore::utility::Coercion<dvacore::utility::Guid>::Result(
+		WStringToUTF16(inPTree.get<std::wstring>(kKeyName_Guid)));
+
+	auto optionalName = inPTree.get_optional<std::wstring>(kKeyName_Name);
+	outHeader.mName = optionalName ? WStringToUTF16(*optionalName) : ASL::String();
+
+	auto optionalDimensionRows = inPTree.get_optional<ASL::UInt32>(kKeyName_DimensionRows);
+	auto optionalDimensionColumns = inPTree.get_optional<ASL::UInt32>(kKeyName_DimensionColumns);
+	if (optionalDimensionRows && optionalDimensionColumns)
+	{
+		outHeader.mRows = *optionalDimensionRows;
+		outHeader.mColumns = *optionalDimensionColumns;
+		return true;
+	}
+
+	outHeader.mRows = 0u;
+	outHeader.mColumns = 0u;
+	auto tags = inPTree.get_child_optional(kKeyName_Tags);
+	if (tags)
+	{
+		BOOST_FOREACH (const auto& keyValuePair, *tags)
+		{
+			auto& tagPTree = keyValuePair.second;
+			std::int32_t const left = tagPTree.get<std::int32_t>(kKeyName_PositonLeftColumn, 0);
+			std::int32_t const top = tagPTree.get<std::int32_t>(kKeyName_PositonTopRow, 0);
+			std::int32_t const rows = tagPTree.get<std::int32_t>(kKeyName_PositonRows, 1);
+			std::int32_t const columns = tagPTree.get<std::int32_t>(kKeyName_PositonColumns, 1);
+			if (rows > 0 && columns > 0)
+			{
+				outHeader.mRows = std::max(outHeader.mRows, (ASL::UInt32)(top + rows));
+				outHeader.mColumns = std::max(outHeader.mColumns, (ASL::UInt32)(left + columns));
+			}
+		}
+	}
+	return true;
+}
+
 /*
 **
 */
@@ -101,6 +101,7 @@
 #include "ASLTokenizer.h"
 #include "ASLWeakReferenceCapable.h"
 #include "ASLAsyncCallFromMainThread.h"
+#include "ASLCriticalSection.h"
 
 //	DVA
 #include "dvacore/config/Localizer.h"
@@ -123,6 +124,7 @@
 
 //	boost
 #include <boost/foreach.hpp>
+#include <boost/weak_ptr.hpp>
 
 //	EAClient
 #include "IEACDataServer.h"
@@ -167,6 +169,9 @@ namespace PL
 		const ASL::StdString kXMP_Property_ModifyDate       = "ModifyDate";
 		const ASL::StdString kXMP_Property_OriginalDocumentID  = "OriginalDocumentID";
 
+		const ASL::StdString kXMPPartID_Tracks("/metadata/xmpDM/Tracks");
+		const ASL::StdString kXMPPartID_Metadata("/metadata");
+
 		const dvacore::UTF16String kCustomMetadataContent	= DVA_STR("CustomMetadataContent");
 		const dvacore::UTF16String kDuration				= DVA_STR("Duration");
 		const dvacore::UTF16String kDropFrame				= DVA_STR("DropFrame");
@@ -281,6 +286,58 @@ namespace PL
 			RemoveFieldsFromNamespaceXMP(inXMPMeta);
 		}
 
+		/*
+		**	64-bit FNV-1a over the serialized stem.
+		*/
+		std::uint64_t HashXMPStem(const ASL::StdString& inStem)
+		{
+			std::uint64_t hash = 14695981039346656037ULL;
+			for (ASL::StdString::const_iterator it = inStem.begin(); it != inStem.end(); ++it)
+			{
+				hash ^= static_cast<unsigned char>(*it);
+				hash *= 1099511628211ULL;
+			}
+			return hash;
+		}
+
+		/*
+		**	Fingerprints keyed by the XMP buffer they were computed from. Buffers are never modified
+		**	once shared, so every holder of a buffer gets the same fingerprint. The weak pointer
+		**	tells the live buffer apart from a newer one allocated at a freed buffer's address.
+		*/
+		struct CachedXMPFingerprint
+		{
+			boost::weak_ptr<ASL::StdString>	mXMP;
+			XMPFingerprintPtr				mFingerprint;
+		};
+		typedef std::map<const ASL::StdString*, CachedXMPFingerprint> XMPFingerprintCache;
+
+		const std::size_t kMinXMPFingerprintCachePruneSize = 64;
+
+		ASL::CriticalSection sXMPFingerprintCacheCriticalSection;
+		XMPFingerprintCache sXMPFingerprintCache;
+		std::size_t sXMPFingerprintCachePruneSize = kMinXMPFingerprintCachePruneSize;
+
+		/*
+		**	Drop the entries of released buffers. Call with sXMPFingerprintCacheCriticalSection held.
+		*/
+		void PruneXMPFingerprintCache()
+		{
+			XMPFingerprintCache::iterator it = sXMPFingerprintCache.begin();
+			while (it != sXMPFingerprintCache.end())
+			{
+				if (it->second.mXMP.expired())
+				{
+					sXMPFingerprintCache.erase(it++);
+				}
+				else
+				{
+					++it;
+				}
+			}
+			sXMPFingerprintCachePruneSize = std::max(kMinXMPFingerprintCachePruneSize, 2 * sXMPFingerprintCache.size());
+		}
+
 		/*
 		**
 		*/
@@ -469,8 +526,7 @@ namespace PL
 
 				// Check if the type is in the Marker Type Registry.
 				// If not, register the type
-				MarkerTypeRegistry types = MarkerType::GetAllMarkerTypes();
-				if (types.find(markerType) == types.end())
+				if (!MarkerType::IsRegisteredMarkerType(markerType))
 				{
 					MarkerType::AddMarkerToRegistry(markerType, markerType, markerType, dvacore::UTF16String());
 				}
@@ -1455,6 +1511,32 @@ namespace PL
 			
 			return theTransitionItem;
 		}
+
+		/*
+		**	True if any clip track of the given type holds a clip item.
+		*/
+		bool SequenceHasClipItems(
+			BE::ISequenceRef inSequence,
+			BE::MediaType inType)
+		{
+			BE::ITrackGroupRef clipTrackGroup = inSequence->GetTrackGroup(inType);
+			if (!clipTrackGroup)
+			{
+				return false;
+			}
+
+			BE::TrackIndex trackCount = clipTrackGroup->GetClipTrackCount();
+			for (BE::TrackIndex index = 0; index < trackCount; ++index)
+			{
+				BE::TrackItemVector clipItems;
+				clipTrackGroup->GetClipTrack(index)->GetTrackItems(BE::kTrackItemType_Clip, clipItems);
+				if (!clipItems.empty())
+				{
+					return true;
+				}
+			}
+			return false;
+		}
 	}
 
 	namespace Utilities
@@ -2978,31 +3060,94 @@ namespace PL
 			return namePart;
 		}
 
+		/*
+		**
+		*/
+		static bool IsSameXMPStem(const XMPFingerprint& inLeft, const XMPFingerprint& inRight)
+		{
+			return inLeft.mIsValid && inRight.mIsValid &&
+				inLeft.mStemHash == inRight.mStemHash &&
+				inLeft.mStemLength == inRight.mStemLength;
+		}
+
 		bool IsXMPStemEqual(const XMPText& inNewXMPData, const XMPText& inOldXMPData)
 		{
-			ASL::StdString newXMPString = *inNewXMPData.get();
-			ASL::StdString oldXMPString = *inOldXMPData.get();
-			bool result(false);
-			try
+			XMPFingerprintPtr newFingerprint = GetXMPFingerprint(inNewXMPData);
+			XMPFingerprintPtr oldFingerprint = GetXMPFingerprint(inOldXMPData);
+			return IsSameXMPStem(*newFingerprint, *oldFingerprint);
+		}
+
+		bool IsXMPStemEqual(const XMPText& inNewXMPData, const AssetMediaInfoPtr& inOldMediaInfo)
+		{
+			ASL_ASSERT(inOldMediaInfo != NULL);
+			XMPFingerprintPtr newFingerprint = GetXMPFingerprint(inNewXMPData);
+			XMPFingerprintPtr oldFingerprint = inOldMediaInfo->GetXMPFingerprint();
+			return IsSameXMPStem(*newFingerprint, *oldFingerprint);
+		}
+
+		XMPFingerprintPtr ComputeXMPFingerprint(const XMPText& inXMPData)
+		{
+			boost::shared_ptr<XMPFingerprint> fingerprint(new XMPFingerprint());
+			if (inXMPData == NULL)
 			{
-				SXMPMeta newXMPMeta(newXMPString.c_str(), static_cast<XMP_StringLen>(newXMPString.length()));
-				SXMPMeta oldXMPMeta(oldXMPString.c_str(), static_cast<XMP_StringLen>(oldXMPString.length()));
+				return fingerprint;
+			}
 
-				RemoveVariableFields(newXMPMeta);
-				RemoveVariableFields(oldXMPMeta);
+			try
+			{
+				SXMPMeta xmpMeta(inXMPData->c_str(), static_cast<XMP_StringLen>(inXMPData->length()));
 
+				//	Strip the variable fields from a deep copy; doc ops still need them to report part changes.
+				SXMPMeta stemMeta = xmpMeta.Clone();
+				RemoveVariableFields(stemMeta);
+				ASL::StdString stemString;
+				stemMeta.SerializeToBuffer(&stemString);
+				fingerprint->mStemHash = HashXMPStem(stemString);
+				fingerprint->mStemLength = stemString.size();
 
-				newXMPMeta.SerializeToBuffer(&newXMPString);
-				oldXMPMeta.SerializeToBuffer(&oldXMPString);
+				SXMPDocOps xmpDocOps;
+				xmpDocOps.OpenXMP(&xmpMeta, "");
+				xmpDocOps.GetPartChangeID(kXMPPartID_Tracks.c_str(), &fingerprint->mTracksChangeID);
+				xmpDocOps.GetPartChangeID(kXMPPartID_Metadata.c_str(), &fingerprint->mMetadataChangeID);
 
-				return (newXMPString == oldXMPString);
+				fingerprint->mIsValid = true;
 			}
 			catch(...)
 			{
+				fingerprint.reset(new XMPFingerprint());
+			}
+
+			return fingerprint;
+		}
+
+		XMPFingerprintPtr GetXMPFingerprint(const XMPText& inXMPData)
+		{
+			if (inXMPData == NULL)
+			{
+				return ComputeXMPFingerprint(inXMPData);
+			}
 
+			{
+				ASL::CriticalSectionLock lock(sXMPFingerprintCacheCriticalSection);
+				XMPFingerprintCache::const_iterator it = sXMPFingerprintCache.find(inXMPData.get());
+				if (it != sXMPFingerprintCache.end() && it->second.mXMP.lock() == inXMPData)
+				{
+					return it->second.mFingerprint;
+				}
 			}
 
-			return result;
+			//	Parse outside the lock; racing callers compute the same value for the same buffer.
+			XMPFingerprintPtr fingerprint = ComputeXMPFingerprint(inXMPData);
+
+			ASL::CriticalSectionLock lock(sXMPFingerprintCacheCriticalSection);
+			CachedXMPFingerprint& entry = sXMPFingerprintCache[inXMPData.get()];
+			entry.mXMP = inXMPData;
+			entry.mFingerprint = fingerprint;
+			if (sXMPFingerprintCache.size() >= sXMPFingerprintCachePruneSize)
+			{
+				PruneXMPFingerprintCache();
+			}
+			return fingerprint;
 		}
 
 		// Moved from MZ::Utilities
@@ -4438,6 +4583,43 @@ namespace PL
 			return CreateCustomPresetForSequence(sequence, inExportModule);
 		}
 
+		bool MediaFormatSignature::operator==(const MediaFormatSignature& inOther) const
+		{
+			return !(mHasVideo != inOther.mHasVideo ||
+					mHasAudio != inOther.mHasAudio ||
+					mVideoFrameRate != inOther.mVideoFrameRate ||
+					mVideoFrameRect != inOther.mVideoFrameRect ||
+					mVideoPixelAspectRatio != inOther.mVideoPixelAspectRatio ||
+					mVideoFieldType != inOther.mVideoFieldType ||
+					mAudioFrameRate != inOther.mAudioFrameRate ||
+					mAudioChannelType != inOther.mAudioChannelType);
+		}
+
+		bool GetMediaFormatSignature(
+				const ASL::String& inMediaPath,
+				MediaFormatSignature& outSignature,
+				BE::ISequenceRef& outSequence)
+		{
+			EncoderHost::IEncoderFactoryRef	encoderFactory(ASL::CreateClassInstanceRef(kEncoderFactoryClassID));
+
+			outSequence = BE::ISequenceRef();
+			encoderFactory->CreateSequenceFromFileMedia(inMediaPath, outSequence);
+			if (!outSequence)
+			{
+				return false;
+			}
+
+			outSignature.mHasVideo = SequenceHasClipItems(outSequence, BE::kMediaType_Video);
+			outSignature.mHasAudio = SequenceHasClipItems(outSequence, BE::kMediaType_Audio);
+			outSignature.mVideoFrameRate = outSequence->GetVideoFrameRate();
+			outSignature.mVideoFrameRect = outSequence->GetVideoFrameRect();
+			outSignature.mVideoPixelAspectRatio = outSequence->GetVideoPixelAspectRatio();
+			outSignature.mVideoFieldType = outSequence->GetVideoFieldType();
+			outSignature.mAudioFrameRate = outSequence->GetAudioFrameRate();
+			outSignature.mAudioChannelType = outSequence->GetMasterTrackChannelType();
+			return true;
+		}
+
 		EncoderHost::IPresetRef CreateCustomPresetForAssetItem(const AssetItemPtr& inAssetItem, ML::IExporterModuleRef inExportModule)
 		{
 			if (inAssetItem->GetAssetMediaType() == PL::kAssetLibraryType_RoughCut)
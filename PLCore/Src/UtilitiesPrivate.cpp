@@ -506,7 +506,7 @@ namespace PL
 					if (ASL::ResultSucceeded(SRLibrarySupport::ReadXMPFromFile(filePath, xmpTest, outErrorInfo)))
 					{
 						//	If the "Stem" XMP data is exacly same as cached one, we see it as match.
-						if (!Utilities::IsXMPStemEqual(xmpTest, mediaInfoPtr->GetAssetMediaInfo()->GetXMPString()))
+						if (!Utilities::IsXMPStemEqual(xmpTest, mediaInfoPtr->GetAssetMediaInfo()))
 						{
 							if (!disableDialog)
 							{